@@ -0,0 +1,395 @@
+// Benchmarks of the main operations of libmod, for tracking the performance across versions:
+// - dg::Builder::execute on the formose grammar with increasing repeat depth,
+// - rule::Composer::eval on the overall formose reaction,
+// - insertion in the graph database of a DG with each isomorphism algorithm,
+// - reading and writing SMILES strings,
+// - loading DG dumps in the text and the binary format.
+// The graphs for the later benchmarks are the ones of the formose DG of depth 3.
+//
+// Usage: benchmark_libmod [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>]
+//                         [--benchmark_format=<console|json>] [--benchmark_out=<file>]
+//
+// The options mimic those of Google Benchmark, and the JSON output uses its format,
+// so the same tools can be used for trend tracking.
+// With --benchmark_out the results are also written as JSON to the given file.
+// As libmod may print to stdout, that is the safest way to obtain the JSON.
+
+#include <mod/Config.hpp>
+#include <mod/Misc.hpp>
+#include <mod/dg/Builder.hpp>
+#include <mod/dg/DG.hpp>
+#include <mod/dg/Strategies.hpp>
+#include <mod/graph/Graph.hpp>
+#include <mod/rule/Composer.hpp>
+#include <mod/rule/CompositionExpr.hpp>
+#include <mod/rule/Rule.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef MOD_BENCHMARK_FORMOSE_DIR
+#error "MOD_BENCHMARK_FORMOSE_DIR must be the directory with the GML files of the formose grammar."
+#endif
+
+namespace {
+using namespace mod;
+
+// Harness
+//------------------------------------------------------------------------------
+
+// Given to each iteration of a benchmark, which must time the measured part by calling 'time',
+// so the setup of each iteration can be excluded.
+struct State {
+	template<typename F>
+	void time(F f) {
+		const auto startReal = std::chrono::steady_clock::now();
+		const auto startCpu = std::clock();
+		f();
+		cpuTime += double(std::clock() - startCpu) / CLOCKS_PER_SEC;
+		realTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - startReal).count();
+	}
+public:
+	double realTime = 0, cpuTime = 0; // in seconds
+	// the counters of the last iteration, e.g., the size of the result, reported along with the times
+	std::map<std::string, double> counters;
+	// the number of items processed by each iteration, reported as items_per_second
+	std::size_t itemsProcessed = 0;
+};
+
+struct Benchmark {
+	std::string name;
+	std::function<void(State &)> iteration;
+};
+
+struct Result {
+	std::string name;
+	std::size_t iterations;
+	State state;
+};
+
+std::vector<Benchmark> &getBenchmarks() {
+	static std::vector<Benchmark> benchmarks;
+	return benchmarks;
+}
+
+void add(std::string name, std::function<void(State &)> iteration) {
+	getBenchmarks().push_back(Benchmark{std::move(name), std::move(iteration)});
+}
+
+// Iterations are run until at least minTime seconds have been timed.
+Result run(const Benchmark &b, double minTime) {
+	Result res{b.name, 0, {}};
+	do {
+		b.iteration(res.state);
+		++res.iterations;
+	} while(res.state.realTime < minTime);
+	return res;
+}
+
+// JSON output
+//------------------------------------------------------------------------------
+
+std::string jsonString(const std::string &s) {
+	std::string res = "\"";
+	for(const char c : s) {
+		switch(c) {
+		case '"': res += "\\\""; break;
+		case '\\': res += "\\\\"; break;
+		case '\n': res += "\\n"; break;
+		case '\t': res += "\\t"; break;
+		default:
+			if(static_cast<unsigned char>(c) < 0x20) {
+				char buf[8];
+				std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+				res += buf;
+			} else res += c;
+		}
+	}
+	return res + "\"";
+}
+
+void writeJson(std::ostream &s, const std::vector<Result> &results) {
+	const auto now = std::time(nullptr);
+	char date[64];
+	std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+	s << std::setprecision(10);
+	s << "{\n"
+	  << "  \"context\": {\n"
+	  << "    \"date\": " << jsonString(date) << ",\n"
+	  << "    \"executable\": \"benchmark_libmod\",\n"
+	  << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+	  << "    \"mod_version\": " << jsonString(mod::version()) << ",\n"
+	  << "    \"mod_num_threads\": " << getConfig().common.numThreads.get() << ",\n"
+	  << "    \"library_build_type\": \"" << (mod::isDebugBuild() ? "debug" : "release") << "\"\n"
+	  << "  },\n"
+	  << "  \"benchmarks\": [";
+	bool first = true;
+	for(const auto &r : results) {
+		if(!first) s << ",";
+		first = false;
+		const double n = r.iterations;
+		s << "\n    {\n"
+		  << "      \"name\": " << jsonString(r.name) << ",\n"
+		  << "      \"run_name\": " << jsonString(r.name) << ",\n"
+		  << "      \"run_type\": \"iteration\",\n"
+		  << "      \"iterations\": " << r.iterations << ",\n"
+		  << "      \"real_time\": " << r.state.realTime / n * 1e3 << ",\n"
+		  << "      \"cpu_time\": " << r.state.cpuTime / n * 1e3 << ",\n"
+		  << "      \"time_unit\": \"ms\"";
+		if(r.state.itemsProcessed != 0)
+			s << ",\n      \"items_per_second\": " << r.state.itemsProcessed * n / r.state.realTime;
+		for(const auto &[name, value] : r.state.counters)
+			s << ",\n      " << jsonString(name) << ": " << value;
+		s << "\n    }";
+	}
+	s << "\n  ]\n}\n";
+}
+
+void writeConsoleHeader(std::ostream &s) {
+	s << std::left << std::setw(40) << "Benchmark" << std::right
+	  << std::setw(14) << "Time (ms)" << std::setw(14) << "CPU (ms)" << std::setw(12) << "Iterations"
+	  << "  Counters" << std::endl;
+}
+
+void writeConsole(std::ostream &s, const Result &r) {
+	const double n = r.iterations;
+	s << std::left << std::setw(40) << r.name << std::right << std::fixed << std::setprecision(3)
+	  << std::setw(14) << r.state.realTime / n * 1e3
+	  << std::setw(14) << r.state.cpuTime / n * 1e3
+	  << std::setw(12) << r.iterations << " ";
+	s.unsetf(std::ios_base::floatfield);
+	if(r.state.itemsProcessed != 0)
+		s << " items_per_second=" << r.state.itemsProcessed * n / r.state.realTime;
+	for(const auto &[name, value] : r.state.counters)
+		s << " " << name << "=" << value;
+	s << std::endl;
+}
+
+// Workloads
+//------------------------------------------------------------------------------
+
+const LabelSettings labelSettings(LabelType::String, LabelRelation::Isomorphism);
+
+struct Formose {
+	Formose() {
+		formaldehyde = graph::Graph::fromSMILES("C=O");
+		glycolaldehyde = graph::Graph::fromSMILES("OCC=O");
+		const std::string dir = MOD_BENCHMARK_FORMOSE_DIR;
+		ketoEnolF = rule::Rule::fromGMLFile(dir + "/keto_enol_forward.gml", false);
+		ketoEnolB = rule::Rule::fromGMLFile(dir + "/keto_enol_backward.gml", false);
+		aldolAddF = rule::Rule::fromGMLFile(dir + "/aldol_addition_forward.gml", false);
+		aldolAddB = rule::Rule::fromGMLFile(dir + "/aldol_addition_backward.gml", false);
+	}
+
+	std::vector<std::shared_ptr<rule::Rule>> getRules() const {
+		return {ketoEnolF, ketoEnolB, aldolAddF, aldolAddB};
+	}
+
+	// addSubset(formaldehyde, glycolaldehyde) >> repeat[depth](inputRules)
+	std::shared_ptr<dg::Strategy> getStrategy(int depth) const {
+		std::vector<std::shared_ptr<dg::Strategy>> rules;
+		for(const auto &r : getRules())
+			rules.push_back(dg::Strategy::makeRule(r));
+		return dg::Strategy::makeSequence({
+				dg::Strategy::makeAdd(false, {formaldehyde, glycolaldehyde}, IsomorphismPolicy::Check),
+				dg::Strategy::makeRepeat(depth, dg::Strategy::makeParallel(rules))
+		});
+	}
+
+	std::shared_ptr<dg::DG> makeDG(int depth) const {
+		auto dg = dg::DG::make(labelSettings, {formaldehyde, glycolaldehyde}, IsomorphismPolicy::Check);
+		dg->build().execute(getStrategy(depth), 0);
+		return dg;
+	}
+public:
+	std::shared_ptr<graph::Graph> formaldehyde, glycolaldehyde;
+	std::shared_ptr<rule::Rule> ketoEnolF, ketoEnolB, aldolAddF, aldolAddB;
+};
+
+const Formose &getFormose() {
+	static const Formose f;
+	return f;
+}
+
+// The formose DG of depth 3, and its graphs as GML, so fresh copies without cached data can be made.
+struct FormoseGraphs {
+	FormoseGraphs() : dg(getFormose().makeDG(3)) {
+		for(const auto &g : dg->getGraphDatabase()) {
+			gml.push_back(g->getGMLString());
+			smiles.push_back(g->getSmiles());
+		}
+	}
+
+	std::vector<std::shared_ptr<graph::Graph>> makeGraphs() const {
+		std::vector<std::shared_ptr<graph::Graph>> res;
+		for(const auto &s : gml)
+			res.push_back(graph::Graph::fromGMLString(s));
+		return res;
+	}
+public:
+	std::shared_ptr<dg::DG> dg;
+	std::vector<std::string> gml, smiles;
+};
+
+const FormoseGraphs &getFormoseGraphs() {
+	static const FormoseGraphs f;
+	return f;
+}
+
+void registerBenchmarks() {
+	for(const int depth : {1, 2, 3, 4}) {
+		add("execute/formose/depth:" + std::to_string(depth), [depth](State &state) {
+			const auto &f = getFormose();
+			const auto strat = f.getStrategy(depth);
+			std::shared_ptr<dg::DG> dg;
+			state.time([&]() {
+				dg = dg::DG::make(labelSettings, {f.formaldehyde, f.glycolaldehyde}, IsomorphismPolicy::Check);
+				dg->build().execute(strat, 0);
+			});
+			state.counters["vertices"] = dg->numVertices();
+			state.counters["edges"] = dg->numEdges();
+		});
+	}
+
+	add("rc/eval/formose", [](State &state) {
+		const auto &f = getFormose();
+		using namespace rule::RCExp;
+		const auto super = [](Expression a, Expression b, bool allowPartial = true) -> Expression {
+			return ComposeSuper(std::move(a), std::move(b), true, allowPartial, false);
+		};
+		const auto parallel = [](Expression a, Expression b) -> Expression {
+			return ComposeParallel(std::move(a), std::move(b), true);
+		};
+		// the overall formose reaction, as in the examples
+		Expression exp = Id(f.glycolaldehyde);
+		exp = super(exp, f.ketoEnolF);
+		exp = parallel(exp, Id(f.formaldehyde));
+		exp = super(exp, f.aldolAddF, false);
+		exp = super(exp, f.ketoEnolF);
+		exp = parallel(exp, Id(f.formaldehyde));
+		exp = super(exp, f.aldolAddF, false);
+		exp = super(exp, f.ketoEnolF);
+		exp = super(exp, f.ketoEnolB);
+		exp = super(exp, f.aldolAddB);
+		exp = super(exp, f.ketoEnolB);
+		exp = super(exp, parallel(Id(f.glycolaldehyde), Id(f.glycolaldehyde)), false);
+		const auto rules = f.getRules();
+		const auto rc = rule::Composer::create({rules.begin(), rules.end()}, labelSettings);
+		std::vector<std::shared_ptr<rule::Rule>> res;
+		state.time([&]() {
+			res = rc->eval(exp, 0);
+		});
+		state.counters["results"] = res.size();
+	});
+
+	for(const auto &[alg, name] : {std::pair(Config::IsomorphismAlg::VF2, "VF2"),
+	                               std::pair(Config::IsomorphismAlg::Canon, "Canon"),
+	                               std::pair(Config::IsomorphismAlg::SmilesCanonVF2, "SmilesCanonVF2")}) {
+		add(std::string("graphDatabase/insert/") + name, [alg = alg](State &state) {
+			// fresh graphs, so nothing is cached in them from earlier iterations
+			const auto graphs = getFormoseGraphs().makeGraphs();
+			const auto algOld = getConfig().graph.isomorphismAlg.get();
+			getConfig().graph.isomorphismAlg.set(alg);
+			state.time([&]() {
+				dg::DG::make(labelSettings, graphs, IsomorphismPolicy::Check);
+			});
+			getConfig().graph.isomorphismAlg.set(algOld);
+			state.itemsProcessed = graphs.size();
+		});
+	}
+
+	add("smiles/read", [](State &state) {
+		const auto &smiles = getFormoseGraphs().smiles;
+		state.time([&]() {
+			for(const auto &s : smiles)
+				graph::Graph::fromSMILES(s);
+		});
+		state.itemsProcessed = smiles.size();
+	});
+
+	add("smiles/write", [](State &state) {
+		const auto graphs = getFormoseGraphs().makeGraphs();
+		state.time([&]() {
+			for(const auto &g : graphs)
+				g->getSmiles();
+		});
+		state.itemsProcessed = graphs.size();
+	});
+
+	for(const bool binary : {false, true}) {
+		add(std::string("dump/load/") + (binary ? "binary" : "text"), [binary](State &state) {
+			static const std::map<bool, std::string> files = []() {
+				const auto &dg = getFormoseGraphs().dg;
+				const auto dir = std::filesystem::temp_directory_path();
+				return std::map<bool, std::string>{
+						{false, dg->dump((dir / "mod_benchmark_formose.dg").string())},
+						{true,  dg->dumpBinary((dir / "mod_benchmark_formose.dgb").string())}
+				};
+			}();
+			std::shared_ptr<dg::DG> dg;
+			state.time([&]() {
+				dg = dg::DG::load({}, {}, files.at(binary), IsomorphismPolicy::Check, 0);
+			});
+			state.counters["vertices"] = dg->numVertices();
+			state.counters["edges"] = dg->numEdges();
+		});
+	}
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	std::string filter = ".*", format = "console", out;
+	double minTime = 0.5;
+	for(int i = 1; i != argc; ++i) {
+		const std::string arg = argv[i];
+		const auto value = [&arg](const std::string &opt) {
+			return arg.substr(opt.size());
+		};
+		if(arg.rfind("--benchmark_filter=", 0) == 0) filter = value("--benchmark_filter=");
+		else if(arg.rfind("--benchmark_min_time=", 0) == 0) minTime = std::stod(value("--benchmark_min_time="));
+		else if(arg.rfind("--benchmark_format=", 0) == 0) format = value("--benchmark_format=");
+		else if(arg.rfind("--benchmark_out=", 0) == 0) out = value("--benchmark_out=");
+		else {
+			std::cerr << "Unknown argument '" << arg << "'.\n"
+			          << "Usage: " << argv[0] << " [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>]"
+			          << " [--benchmark_format=<console|json>] [--benchmark_out=<file>]" << std::endl;
+			return 1;
+		}
+	}
+	if(format != "console" && format != "json") {
+		std::cerr << "Unknown format '" << format << "'." << std::endl;
+		return 1;
+	}
+	registerBenchmarks();
+	const std::regex re(filter);
+	std::vector<Result> results;
+	if(format == "console") writeConsoleHeader(std::cout);
+	for(const auto &b : getBenchmarks()) {
+		if(!std::regex_search(b.name, re)) continue;
+		results.push_back(run(b, minTime));
+		if(format == "console") writeConsole(std::cout, results.back());
+	}
+	if(format == "json") writeJson(std::cout, results);
+	if(!out.empty()) {
+		std::ofstream f(out);
+		if(!f) {
+			std::cerr << "Could not open '" << out << "' for writing." << std::endl;
+			return 1;
+		}
+		writeJson(f, results);
+	}
+}
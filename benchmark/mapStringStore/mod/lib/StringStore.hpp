@@ -0,0 +1,51 @@
+#ifndef MOD_LIB_STRINGSTORE_HPP
+#define MOD_LIB_STRINGSTORE_HPP
+
+// The implementation of lib::StringStore before it was made concurrent, a std::map,
+// here guarded by a mutex to make it usable from multiple threads.
+// The strings are in a std::deque, instead of the original std::vector,
+// so references returned by getString stay valid when other threads add strings.
+// It shadows the real header in benchmark_stringStore_map, so the term parser is compiled against it.
+
+#include <cassert>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace mod::lib {
+
+struct StringStore {
+	StringStore() = default;
+	StringStore(const StringStore&) = delete;
+	StringStore(StringStore&&) = delete;
+	StringStore &operator=(const StringStore&) = delete;
+	StringStore &operator=(StringStore&&) = delete;
+
+	bool hasString(std::string_view s) const {
+		std::lock_guard<std::mutex> lock(mtx);
+		return index.find(std::string(s)) != end(index);
+	}
+
+	std::size_t getIndex(std::string_view s) const {
+		std::lock_guard<std::mutex> lock(mtx);
+		auto pIter = index.emplace(std::string(s), strings.size());
+		if(pIter.second) strings.emplace_back(s);
+		return pIter.first->second;
+	}
+
+	const std::string &getString(std::size_t index) const {
+		std::lock_guard<std::mutex> lock(mtx);
+		assert(index < strings.size());
+		return strings[index];
+	}
+private:
+	mutable std::deque<std::string> strings;
+	mutable std::map<std::string, std::size_t> index;
+	mutable std::mutex mtx;
+};
+
+} // namespace mod::lib
+
+#endif // MOD_LIB_STRINGSTORE_HPP
@@ -0,0 +1,114 @@
+// Measures lib::StringStore when parsing terms with Term::Read::rawTerm from a number of threads,
+// and when interning the identifiers of the terms directly.
+// The same benchmark is built twice: benchmark_stringStore uses the current store,
+// and benchmark_stringStore_map uses the previous implementation, a std::map guarded by a mutex
+// (see mapStringStore/), so the two can be compared on the same input.
+//
+// Usage: benchmark_stringStore[_map] [numTerms [numNames [maxThreads]]]
+
+#include <mod/lib/StringStore.hpp>
+#include <mod/lib/Term/IO/Read.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Terms like name3(name12, _X1, name7(name5, _Y)), where the names are drawn with a skewed distribution
+// so some are much more frequent than others.
+std::vector<std::string> makeTerms(std::size_t numTerms, std::size_t numNames) {
+	std::mt19937 rng(42);
+	std::geometric_distribution<std::size_t> nameDist(5.0 / numNames);
+	std::uniform_int_distribution<int> arityDist(1, 4);
+	const auto name = [&]() {
+		return "name" + std::to_string(std::min(nameDist(rng), numNames - 1));
+	};
+	std::vector<std::string> terms;
+	terms.reserve(numTerms);
+	for(std::size_t i = 0; i != numTerms; ++i) {
+		std::string t = name() + "(";
+		const int arity = arityDist(rng);
+		for(int a = 0; a != arity; ++a) {
+			if(a != 0) t += ", ";
+			switch(a % 3) {
+			case 0: t += name(); break;
+			case 1: t += "_X" + std::to_string(a); break;
+			case 2: t += name() + "(" + name() + ", _Y)"; break;
+			}
+		}
+		t += ")";
+		terms.push_back(std::move(t));
+	}
+	return terms;
+}
+
+// The identifiers of the terms, in the order the parser would intern them.
+std::vector<std::string> tokenize(const std::vector<std::string> &terms) {
+	std::vector<std::string> res;
+	for(const auto &t : terms) {
+		std::string cur;
+		for(const char c : t) {
+			if(std::isalnum(static_cast<unsigned char>(c))) cur += c;
+			else if(!cur.empty()) {
+				res.push_back(std::move(cur));
+				cur.clear();
+			}
+		}
+		if(!cur.empty()) res.push_back(std::move(cur));
+	}
+	return res;
+}
+
+// Runs f(i) for all i in [0, n) on numThreads threads, returns the wall time in seconds.
+template<typename F>
+double timeParallel(std::size_t n, unsigned int numThreads, F f) {
+	const auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for(unsigned int t = 0; t != numThreads; ++t) {
+		threads.emplace_back([&, t]() {
+			for(std::size_t i = t; i < n; i += numThreads) f(i);
+		});
+	}
+	for(auto &th : threads) th.join();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	const std::size_t numTerms = argc > 1 ? std::stoul(argv[1]) : 200000;
+	const std::size_t numNames = argc > 2 ? std::stoul(argv[2]) : 10000;
+	const unsigned int maxThreads = argc > 3 ? std::stoul(argv[3]) : std::max(1u, std::thread::hardware_concurrency());
+	const auto terms = makeTerms(numTerms, numNames);
+	const auto tokens = tokenize(terms);
+#ifdef MOD_BENCHMARK_MAP_STRING_STORE
+	std::cout << "store: previous (std::map with a mutex)" << std::endl;
+#else
+	std::cout << "store: current (striped)" << std::endl;
+#endif
+	std::cout << "terms: " << terms.size() << ", identifiers: " << tokens.size() << std::endl;
+	std::cout << "threads\tparse (s)\tintern (s)" << std::endl;
+	for(unsigned int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+		double timeParse, timeStore;
+		{
+			const mod::lib::StringStore store;
+			timeParse = timeParallel(terms.size(), numThreads, [&](std::size_t i) {
+				mod::lib::Term::Read::rawTerm(terms[i], store);
+			});
+		}
+		{
+			const mod::lib::StringStore store;
+			timeStore = timeParallel(tokens.size(), numThreads, [&](std::size_t i) {
+				store.getIndex(tokens[i]);
+			});
+		}
+		std::cout << numThreads << "\t" << timeParse << "\t" << timeStore << std::endl;
+	}
+}
@@ -0,0 +1,277 @@
+#ifndef JLA_BOOST_GRAPH_CSRGRAPH_HPP
+#define JLA_BOOST_GRAPH_CSRGRAPH_HPP
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace jla_boost {
+
+// An immutable undirected graph in compressed sparse row form, i.e., the incident edges of all vertices
+// are stored in contiguous arrays.
+// It is constructed from an undirected graph with vertex indices and edge indices,
+// and the vertices and edges keep those indices, so vertex and edge data of the original graph
+// can be looked up by index.
+
+struct CSRGraph {
+	using Self = CSRGraph;
+public: // Graph
+	using vertex_descriptor = std::size_t;
+
+	struct edge_descriptor {
+		vertex_descriptor src, tar;
+		std::size_t id;
+	public:
+		friend bool operator==(const edge_descriptor &a, const edge_descriptor &b) {
+			return a.id == b.id;
+		}
+
+		friend bool operator!=(const edge_descriptor &a, const edge_descriptor &b) {
+			return a.id != b.id;
+		}
+	};
+
+	using directed_category = boost::undirected_tag;
+	using edge_parallel_category = boost::disallow_parallel_edge_tag;
+
+	struct traversal_category
+			: boost::bidirectional_graph_tag, boost::vertex_list_graph_tag, boost::edge_list_graph_tag,
+			  boost::adjacency_matrix_tag {
+	};
+
+	static vertex_descriptor null_vertex() {
+		return std::numeric_limits<vertex_descriptor>::max();
+	}
+public:
+	template<typename Graph>
+	explicit CSRGraph(const Graph &g) : offsets(num_vertices(g) + 1, 0), ends(num_edges(g)) {
+		static_assert(std::is_same<typename boost::graph_traits<Graph>::directed_category, boost::undirected_tag>::value,
+		              "Only undirected graphs are supported.");
+		targets.reserve(2 * num_edges(g));
+		edgeIds.reserve(2 * num_edges(g));
+		for(const auto v : asRange(vertices(g))) {
+			const auto vId = get(boost::vertex_index_t(), g, v);
+			assert(vId < offsets.size() - 1);
+			// the offsets are sorted by vertex index, so the vertices must be iterated in index order
+			assert(offsets[vId] == targets.size());
+			for(const auto e : asRange(out_edges(v, g))) {
+				targets.push_back(get(boost::vertex_index_t(), g, target(e, g)));
+				edgeIds.push_back(get(boost::edge_index_t(), g, e));
+			}
+			offsets[vId + 1] = targets.size();
+		}
+		for(const auto e : asRange(edges(g))) {
+			const auto eId = get(boost::edge_index_t(), g, e);
+			assert(eId < ends.size());
+			ends[eId] = {get(boost::vertex_index_t(), g, source(e, g)), get(boost::vertex_index_t(), g, target(e, g))};
+		}
+	}
+private:
+	// iterates over the incident edges of a vertex, as either out-edges or in-edges
+	template<bool Out>
+	struct incident_edge_iterator : boost::iterator_facade<incident_edge_iterator<Out>, edge_descriptor,
+			boost::random_access_traversal_tag, edge_descriptor> {
+		incident_edge_iterator() = default;
+
+		incident_edge_iterator(const Self *g, vertex_descriptor v, std::size_t pos) : g(g), v(v), pos(pos) {}
+	private:
+		friend class boost::iterator_core_access;
+
+		edge_descriptor dereference() const {
+			if(Out) return {v, g->targets[pos], g->edgeIds[pos]};
+			else return {g->targets[pos], v, g->edgeIds[pos]};
+		}
+
+		bool equal(const incident_edge_iterator &other) const {
+			return pos == other.pos;
+		}
+
+		void increment() {
+			++pos;
+		}
+
+		void decrement() {
+			--pos;
+		}
+
+		void advance(std::ptrdiff_t n) {
+			pos += n;
+		}
+
+		std::ptrdiff_t distance_to(const incident_edge_iterator &other) const {
+			return std::ptrdiff_t(other.pos) - std::ptrdiff_t(pos);
+		}
+	private:
+		const Self *g = nullptr;
+		vertex_descriptor v = 0;
+		std::size_t pos = 0;
+	};
+
+	struct all_edge_iterator : boost::iterator_facade<all_edge_iterator, edge_descriptor,
+			boost::random_access_traversal_tag, edge_descriptor> {
+		all_edge_iterator() = default;
+
+		all_edge_iterator(const Self *g, std::size_t id) : g(g), id(id) {}
+	private:
+		friend class boost::iterator_core_access;
+
+		edge_descriptor dereference() const {
+			return {g->ends[id].first, g->ends[id].second, id};
+		}
+
+		bool equal(const all_edge_iterator &other) const {
+			return id == other.id;
+		}
+
+		void increment() {
+			++id;
+		}
+
+		void decrement() {
+			--id;
+		}
+
+		void advance(std::ptrdiff_t n) {
+			id += n;
+		}
+
+		std::ptrdiff_t distance_to(const all_edge_iterator &other) const {
+			return std::ptrdiff_t(other.id) - std::ptrdiff_t(id);
+		}
+	private:
+		const Self *g = nullptr;
+		std::size_t id = 0;
+	};
+public: // IncidenceGraph
+	using out_edge_iterator = incident_edge_iterator<true>;
+	using degree_size_type = std::size_t;
+
+	friend std::pair<out_edge_iterator, out_edge_iterator> out_edges(vertex_descriptor v, const Self &g) {
+		return {out_edge_iterator(&g, v, g.offsets[v]), out_edge_iterator(&g, v, g.offsets[v + 1])};
+	}
+
+	friend vertex_descriptor source(edge_descriptor e, const Self &) {
+		return e.src;
+	}
+
+	friend vertex_descriptor target(edge_descriptor e, const Self &) {
+		return e.tar;
+	}
+
+	friend degree_size_type out_degree(vertex_descriptor v, const Self &g) {
+		return g.offsets[v + 1] - g.offsets[v];
+	}
+public: // BidirectionalGraph
+	using in_edge_iterator = incident_edge_iterator<false>;
+
+	friend std::pair<in_edge_iterator, in_edge_iterator> in_edges(vertex_descriptor v, const Self &g) {
+		return {in_edge_iterator(&g, v, g.offsets[v]), in_edge_iterator(&g, v, g.offsets[v + 1])};
+	}
+
+	friend degree_size_type in_degree(vertex_descriptor v, const Self &g) {
+		return out_degree(v, g);
+	}
+
+	friend degree_size_type degree(vertex_descriptor v, const Self &g) {
+		return out_degree(v, g);
+	}
+public: // VertexListGraph
+	using vertex_iterator = boost::counting_iterator<vertex_descriptor>;
+	using vertices_size_type = std::size_t;
+
+	friend std::pair<vertex_iterator, vertex_iterator> vertices(const Self &g) {
+		return {vertex_iterator(0), vertex_iterator(num_vertices(g))};
+	}
+
+	friend vertices_size_type num_vertices(const Self &g) {
+		return g.offsets.size() - 1;
+	}
+public: // EdgeListGraph
+	using edge_iterator = all_edge_iterator;
+	using edges_size_type = std::size_t;
+
+	friend std::pair<edge_iterator, edge_iterator> edges(const Self &g) {
+		return {edge_iterator(&g, 0), edge_iterator(&g, g.ends.size())};
+	}
+
+	friend edges_size_type num_edges(const Self &g) {
+		return g.ends.size();
+	}
+public: // AdjacencyMatrix (linear in the degree)
+	friend std::pair<edge_descriptor, bool> edge(vertex_descriptor u, vertex_descriptor v, const Self &g) {
+		for(std::size_t pos = g.offsets[u]; pos != g.offsets[u + 1]; ++pos)
+			if(g.targets[pos] == v) return {edge_descriptor{u, v, g.edgeIds[pos]}, true};
+		return {edge_descriptor{u, v, 0}, false};
+	}
+public: // PropertyGraph
+	using vertex_index_map = boost::typed_identity_property_map<vertex_descriptor>;
+
+	struct edge_index_map {
+		using key_type = edge_descriptor;
+		using value_type = std::size_t;
+		using reference = std::size_t;
+		using category = boost::readable_property_map_tag;
+	public:
+		friend std::size_t get(edge_index_map, edge_descriptor e) {
+			return e.id;
+		}
+	};
+
+	friend vertex_index_map get(boost::vertex_index_t, const Self &) {
+		return {};
+	}
+
+	friend std::size_t get(boost::vertex_index_t, const Self &, vertex_descriptor v) {
+		return v;
+	}
+
+	friend edge_index_map get(boost::edge_index_t, const Self &) {
+		return {};
+	}
+
+	friend std::size_t get(boost::edge_index_t, const Self &, edge_descriptor e) {
+		return e.id;
+	}
+private:
+	std::vector<std::size_t> offsets; // offsets[v] to offsets[v + 1] are the incident edges of v
+	std::vector<vertex_descriptor> targets; // the other end of each incident edge
+	std::vector<std::size_t> edgeIds; // the index of each incident edge
+	std::vector<std::pair<vertex_descriptor, vertex_descriptor>> ends; // the end points of each edge, by index
+};
+
+} // namespace jla_boost
+namespace boost {
+
+template<>
+struct property_map<jla_boost::CSRGraph, vertex_index_t> {
+	using type = jla_boost::CSRGraph::vertex_index_map;
+	using const_type = type;
+};
+
+template<>
+struct property_map<const jla_boost::CSRGraph, vertex_index_t> : property_map<jla_boost::CSRGraph, vertex_index_t> {
+};
+
+template<>
+struct property_map<jla_boost::CSRGraph, edge_index_t> {
+	using type = jla_boost::CSRGraph::edge_index_map;
+	using const_type = type;
+};
+
+template<>
+struct property_map<const jla_boost::CSRGraph, edge_index_t> : property_map<jla_boost::CSRGraph, edge_index_t> {
+};
+
+} // namespace boost
+
+#endif // JLA_BOOST_GRAPH_CSRGRAPH_HPP
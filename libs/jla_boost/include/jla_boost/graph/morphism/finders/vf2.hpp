@@ -26,6 +26,23 @@
 namespace jla_boost {
 namespace GraphMorphism {
 using namespace boost; // TODO: remvoe
+
+// A pair listener is notified when the search extends the partial mapping with a vertex pair,
+// and when it removes the pair again during back tracking.
+// push is given the mapping before the pair is added, and may return false to reject the pair,
+// as if it was not feasible. Pairs are popped in the reverse order of being pushed.
+
+struct NullPairListener {
+
+	template<typename VertexDom, typename VertexCodom, typename VertexMap>
+	bool push(const VertexDom&, const VertexCodom&, const VertexMap&) {
+		return true;
+	}
+
+	template<typename VertexDom, typename VertexCodom>
+	void pop(const VertexDom&, const VertexCodom&) { }
+};
+
 namespace detail {
 
 template<typename GraphDom, typename GraphCodom, typename IdxDom, typename IdxCodom>
@@ -623,12 +640,14 @@ typename VertexOrder1,
 typename EdgeEquivalencePredicate,
 typename VertexEquivalencePredicate,
 typename SubGraphIsoMapCallback,
-problem_selector problem_selection>
+problem_selector problem_selection,
+typename PairListener>
 bool match(const Graph1& graph1, const Graph2& graph2,
 		SubGraphIsoMapCallback user_callback, const VertexOrder1& vertex_order1,
 		state<Graph1, Graph2, IndexMap1, IndexMap2,
 		EdgeEquivalencePredicate, VertexEquivalencePredicate,
-		SubGraphIsoMapCallback, problem_selection>& s) {
+		SubGraphIsoMapCallback, problem_selection>& s,
+		PairListener &listener) {
 
 	typename VertexOrder1::const_iterator graph1_verts_iter;
 
@@ -660,7 +679,8 @@ recur:
 	boost::tie(graph2_verts_iter, graph2_verts_iter_end) = vertices(graph2);
 	while(graph2_verts_iter != graph2_verts_iter_end) {
 		if(s.possible_candidate2(*graph2_verts_iter)) {
-			if(s.feasible(*graph1_verts_iter, *graph2_verts_iter)) {
+			if(s.feasible(*graph1_verts_iter, *graph2_verts_iter)
+					&& listener.push(*graph1_verts_iter, *graph2_verts_iter, s.stateDom.get_map())) {
 				match_continuation_type kk;
 				kk.graph1_verts_iter = graph1_verts_iter;
 				kk.graph2_verts_iter = graph2_verts_iter;
@@ -683,6 +703,7 @@ back_track:
 	graph2_verts_iter = kk.graph2_verts_iter;
 	k.pop_back();
 
+	listener.pop(*graph1_verts_iter, *graph2_verts_iter);
 	s.pop(*graph1_verts_iter, *graph2_verts_iter);
 
 	goto graph2_loop;
@@ -700,13 +721,15 @@ typename IndexMapLarge,
 typename VertexOrderSmall,
 typename EdgeEquivalencePredicate,
 typename VertexEquivalencePredicate,
-typename SubGraphIsoMapCallback>
+typename SubGraphIsoMapCallback,
+typename PairListener>
 bool vf2_subgraph_morphism(const GraphSmall& graph_small, const GraphLarge& graph_large,
 		SubGraphIsoMapCallback user_callback,
 		IndexMapSmall index_map_small, IndexMapLarge index_map_large,
 		const VertexOrderSmall& vertex_order_small,
 		EdgeEquivalencePredicate edge_comp,
-		VertexEquivalencePredicate vertex_comp) {
+		VertexEquivalencePredicate vertex_comp,
+		PairListener &listener) {
 
 	// Graph requirements
 	BOOST_CONCEPT_ASSERT((BidirectionalGraphConcept<GraphSmall>));
@@ -768,7 +791,7 @@ bool vf2_subgraph_morphism(const GraphSmall& graph_small, const GraphLarge& grap
 			SubGraphIsoMapCallback, problem_selection>
 			s(graph_small, graph_large, edge_comp, vertex_comp);
 
-	return detail::match(graph_small, graph_large, user_callback, vertex_order_small, s);
+	return detail::match(graph_small, graph_large, user_callback, vertex_order_small, s, listener);
 }
 
 } // namespace detail
@@ -791,13 +814,43 @@ bool vf2_subgraph_mono(const GraphSmall& graph_small, const GraphLarge& graph_la
 		const VertexOrderSmall& vertex_order_small,
 		EdgeEquivalencePredicate edge_comp,
 		VertexEquivalencePredicate vertex_comp) {
+	NullPairListener listener;
+	return vf2_subgraph_mono(graph_small, graph_large,
+			user_callback,
+			index_map_small, index_map_large,
+			vertex_order_small,
+			edge_comp,
+			vertex_comp,
+			listener);
+}
+
+
+// As above, but with a listener for the vertex pairs of the partial mapping.
+
+template <typename GraphSmall,
+typename GraphLarge,
+typename IndexMapSmall,
+typename IndexMapLarge,
+typename VertexOrderSmall,
+typename EdgeEquivalencePredicate,
+typename VertexEquivalencePredicate,
+typename SubGraphIsoMapCallback,
+typename PairListener>
+bool vf2_subgraph_mono(const GraphSmall& graph_small, const GraphLarge& graph_large,
+		SubGraphIsoMapCallback user_callback,
+		IndexMapSmall index_map_small, IndexMapLarge index_map_large,
+		const VertexOrderSmall& vertex_order_small,
+		EdgeEquivalencePredicate edge_comp,
+		VertexEquivalencePredicate vertex_comp,
+		PairListener &listener) {
 	return detail::vf2_subgraph_morphism<detail::subgraph_mono>
 			(graph_small, graph_large,
 			user_callback,
 			index_map_small, index_map_large,
 			vertex_order_small,
 			edge_comp,
-			vertex_comp);
+			vertex_comp,
+			listener);
 }
 
 
@@ -860,13 +913,43 @@ bool vf2_subgraph_iso(const GraphSmall& graph_small, const GraphLarge& graph_lar
 		const VertexOrderSmall& vertex_order_small,
 		EdgeEquivalencePredicate edge_comp,
 		VertexEquivalencePredicate vertex_comp) {
+	NullPairListener listener;
+	return vf2_subgraph_iso(graph_small, graph_large,
+			user_callback,
+			index_map_small, index_map_large,
+			vertex_order_small,
+			edge_comp,
+			vertex_comp,
+			listener);
+}
+
+
+// As above, but with a listener for the vertex pairs of the partial mapping.
+
+template <typename GraphSmall,
+typename GraphLarge,
+typename IndexMapSmall,
+typename IndexMapLarge,
+typename VertexOrderSmall,
+typename EdgeEquivalencePredicate,
+typename VertexEquivalencePredicate,
+typename SubGraphIsoMapCallback,
+typename PairListener>
+bool vf2_subgraph_iso(const GraphSmall& graph_small, const GraphLarge& graph_large,
+		SubGraphIsoMapCallback user_callback,
+		IndexMapSmall index_map_small, IndexMapLarge index_map_large,
+		const VertexOrderSmall& vertex_order_small,
+		EdgeEquivalencePredicate edge_comp,
+		VertexEquivalencePredicate vertex_comp,
+		PairListener &listener) {
 	return detail::vf2_subgraph_morphism<detail::subgraph_iso>
 			(graph_small, graph_large,
 			user_callback,
 			index_map_small, index_map_large,
 			vertex_order_small,
 			edge_comp,
-			vertex_comp);
+			vertex_comp,
+			listener);
 }
 
 
@@ -932,6 +1015,30 @@ bool vf2_graph_iso(const Graph1& graph1, const Graph2& graph2,
 		const VertexOrder1& vertex_order1,
 		EdgeEquivalencePredicate edge_comp,
 		VertexEquivalencePredicate vertex_comp) {
+	NullPairListener listener;
+	return vf2_graph_iso(graph1, graph2, user_callback, index_map1, index_map2, vertex_order1,
+			edge_comp, vertex_comp, listener);
+}
+
+
+// As above, but with a listener for the vertex pairs of the partial mapping.
+
+template <typename Graph1,
+typename Graph2,
+typename IndexMap1,
+typename IndexMap2,
+typename VertexOrder1,
+typename EdgeEquivalencePredicate,
+typename VertexEquivalencePredicate,
+typename GraphIsoMapCallback,
+typename PairListener>
+bool vf2_graph_iso(const Graph1& graph1, const Graph2& graph2,
+		GraphIsoMapCallback user_callback,
+		IndexMap1 index_map1, IndexMap2 index_map2,
+		const VertexOrder1& vertex_order1,
+		EdgeEquivalencePredicate edge_comp,
+		VertexEquivalencePredicate vertex_comp,
+		PairListener &listener) {
 
 	// Graph requirements
 	BOOST_CONCEPT_ASSERT((BidirectionalGraphConcept<Graph1>));
@@ -994,7 +1101,7 @@ bool vf2_graph_iso(const Graph1& graph1, const Graph2& graph2,
 			GraphIsoMapCallback, detail::isomorphism>
 			s(graph1, graph2, edge_comp, vertex_comp);
 
-	return detail::match(graph1, graph2, user_callback, vertex_order1, s);
+	return detail::match(graph1, graph2, user_callback, vertex_order1, s, listener);
 }
 
 
@@ -0,0 +1,93 @@
+// the construction checks its input with assertions
+#undef NDEBUG
+
+#include <jla_boost/graph/CSRGraph.hpp>
+#include <jla_boost/graph/EdgeIndexedAdjacencyList.hpp>
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <boost/test/minimal.hpp>
+
+#include <set>
+#include <utility>
+
+namespace jla_boost {
+namespace test {
+namespace {
+
+// the vertex descriptors are the vertex indices in both graph types
+using Graph = EdgeIndexedAdjacencyList<boost::undirectedS>;
+
+template<typename G>
+std::set<std::pair<std::size_t, std::size_t>> incidentEdges(std::size_t v, const G &g) {
+	std::set<std::pair<std::size_t, std::size_t>> res;
+	for(const auto e : asRange(out_edges(v, g)))
+		res.emplace(get(boost::vertex_index_t(), g, target(e, g)), get(boost::edge_index_t(), g, e));
+	return res;
+}
+
+void test_same_structure(const Graph &g) {
+	const CSRGraph csr(g);
+	BOOST_REQUIRE(num_vertices(csr) == num_vertices(g));
+	BOOST_REQUIRE(num_edges(csr) == num_edges(g));
+	for(std::size_t v = 0; v != num_vertices(g); ++v) {
+		BOOST_CHECK(out_degree(v, csr) == out_degree(v, g));
+		BOOST_CHECK(incidentEdges(v, csr) == incidentEdges(v, g));
+		for(const auto e : asRange(in_edges(v, csr)))
+			BOOST_CHECK(target(e, csr) == v);
+	}
+	for(const auto e : asRange(edges(g))) {
+		const auto src = get(boost::vertex_index_t(), g, source(e, g));
+		const auto tar = get(boost::vertex_index_t(), g, target(e, g));
+		const auto eId = get(boost::edge_index_t(), g, e);
+		for(const auto &p : {std::make_pair(src, tar), std::make_pair(tar, src)}) {
+			const auto eCSR = edge(p.first, p.second, csr);
+			BOOST_CHECK(eCSR.second);
+			BOOST_CHECK(get(boost::edge_index_t(), csr, eCSR.first) == eId);
+		}
+	}
+	for(const auto e : asRange(edges(csr))) {
+		const auto eG = edge(source(e, csr), target(e, csr), g);
+		BOOST_CHECK(eG.second);
+		BOOST_CHECK(get(boost::edge_index_t(), g, eG.first) == get(boost::edge_index_t(), csr, e));
+	}
+}
+
+void test_empty() {
+	test_same_structure(Graph());
+}
+
+void test_isolated_vertices() {
+	Graph g;
+	for(int i = 0; i != 4; ++i) add_vertex(g);
+	// the first and the last vertex have no edges
+	add_edge(1, 2, g);
+	test_same_structure(g);
+}
+
+void test_cycle_with_chord() {
+	Graph g;
+	for(int i = 0; i != 5; ++i) add_vertex(g);
+	add_edge(3, 4, g);
+	add_edge(0, 1, g);
+	add_edge(2, 1, g);
+	add_edge(2, 3, g);
+	add_edge(4, 0, g);
+	add_edge(0, 2, g);
+	test_same_structure(g);
+	const CSRGraph csr(g);
+	BOOST_CHECK(!edge(1, 3, csr).second);
+	BOOST_CHECK(degree(0, csr) == 3);
+	BOOST_CHECK(degree(4, csr) == 2);
+}
+
+} // namespace
+} // namespace test
+} // namespace jla_boost
+
+int test_main(int argc, char **argv) {
+	using namespace jla_boost::test;
+	test_empty();
+	test_isolated_vertices();
+	test_cycle_with_chord();
+	return 0;
+}
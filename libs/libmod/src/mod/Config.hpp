@@ -329,22 +329,30 @@ struct Config {
     /* rst: .. todo:: write documentation for all settings */                       \
     ((Canon, canon,                                                                 \
         ((bool, printStats, false))                                                 \
+        ((std::string, cacheFile, ""))                                              \
     ))                                                                              \
     ((Common, common,                                                               \
         ((bool, quiet, false))                                                      \
         ((bool, ignoreDeprecation, true))                                           \
         ((unsigned int, numThreads, 1))                                             \
+        ((bool, incrementalTermUnification, true))                                  \
     ))                                                                              \
     ((DG, dg,                                                                       \
         ((bool, useOldRuleApplication, false))                                      \
+        ((bool, useDirectRuleApplication, false))                                   \
         ((bool, calculateVerbosePrint, false))                                      \
         ((bool, putAllProductsInSubset, false))                                     \
         ((bool, dryDerivationPrinting, false))                                      \
         ((bool, derivationDebugOutput, false))                                      \
         ((bool, disableRepeatFixedPointCheck, false))                               \
+        ((bool, semiNaiveRepeat, false))                                            \
         ((int, derivationVerbosity, 0))                                             \
         ((bool, applyAssumeConfluence, false))                                      \
         ((int, applyLimit, -1))                                                     \
+        ((unsigned int, journalSyncInterval, 10))                                   \
+        ((unsigned long, numBindCacheHits, 0))                                      \
+        ((unsigned long, numBindCacheMisses, 0))                                    \
+        ((unsigned long, numSemiNaiveSkips, 0))                                     \
     ))                                                                              \
     ((Graph, graph,                                                                 \
         ((bool, smilesCheckAST, false))                                             \
@@ -355,6 +363,8 @@ struct Config {
         ((bool, useWrongSmilesCanonAlg, false))                                     \
         ((bool, checkIsoInPermutation, false))                                      \
         ((unsigned long, numIsomorphismCalls, 0))                                   \
+        ((unsigned long, numIsomorphismIndexHits, 0))                               \
+        ((unsigned long, numIsomorphismIndexCollisions, 0))                         \
     ))                                                                              \
     ((Rule, rule,                                                                   \
         ((bool, ignoreConstraintsDuringInversion, false))                           \
@@ -371,6 +381,9 @@ struct Config {
         ((bool, printMatchesOnlyHaxChem, false))                                    \
         ((int, componentWiseMorphismLimit, 0))                                      \
         ((bool, useBoostCommonSubgraph, false))                                     \
+        ((unsigned long, numIsomorphismIndexHits, 0))                               \
+        ((unsigned long, numIsomorphismIndexCollisions, 0))                         \
+        ((unsigned long, numComponentPairsSkipped, 0))                              \
     ))                                                                              \
     ((Stereo, stereo,                                                               \
         ((bool, silenceDeductionWarnings, false))                                   \
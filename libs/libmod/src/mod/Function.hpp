@@ -46,6 +46,14 @@ struct Function<R(Args...)> {
 	// rst:		The actual function implementation of the function.
 	// rst:
 	virtual R operator()(Args ...args) const = 0;
+	// rst: .. function:: virtual bool isNative() const
+	// rst:
+	// rst:		:returns: whether the function is implemented natively, and not by calling into e.g. Python.
+	// rst:			Native functions may be called concurrently by the library.
+	// rst:			The default implementation returns `true`.
+	virtual bool isNative() const {
+		return true;
+	}
 };
 // rst-class-end:
 
@@ -25,6 +25,14 @@ std::string version() {
 	return MOD_VERSION;
 }
 
+bool isDebugBuild() {
+#ifdef NDEBUG
+	return false;
+#else
+	return true;
+#endif
+}
+
 void rngReseed(unsigned int seed) {
 	lib::Random::getInstance().reseed(seed);
 }
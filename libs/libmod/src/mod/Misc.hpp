@@ -14,6 +14,10 @@ namespace mod {
 // rst:
 // rst:		:returns: the version of MØD.
 MOD_DECL std::string version();
+// rst: .. function:: bool isDebugBuild()
+// rst:
+// rst:		:returns: whether the library was compiled without ``NDEBUG``, i.e., with assertions enabled.
+MOD_DECL bool isDebugBuild();
 
 // rst: .. function:: void rngReseed(unsigned int seed)
 // rst:
@@ -138,6 +138,11 @@ void Builder::addAbstract(const std::string &description) {
 	p->b.addAbstract(description);
 }
 
+void Builder::startJournal(const std::string &file) {
+	check(p);
+	p->b.startJournal(file);
+}
+
 void Builder::load(const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
                    const std::string &file, int verbosity) {
 	if(std::any_of(ruleDatabase.begin(), ruleDatabase.end(), [](const auto &r) {
@@ -182,6 +182,24 @@ public:
 	// rst:		:throws: :class:`LogicError` if the label settings of the dump does not match those of this DG.
 	// rst: 		:throws: :class:`InputError` if the file can not be opened or its content is bad.
 	void load(const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase, const std::string &file, int verbosity);
+	// rst: .. function:: void startJournal(const std::string &file)
+	// rst:
+	// rst:		Start writing a journal of the derivation graph to the given file.
+	// rst:		The current vertices and hyperedges are written first,
+	// rst:		and then each vertex and hyperedge is appended when it is added,
+	// rst:		e.g., during :func:`execute`.
+	// rst:		The records are handed to the operating system at least once per second,
+	// rst:		and the file is synced to the disk every ``config.dg.journalSyncInterval`` seconds.
+	// rst:		The journal is closed when the builder is closed.
+	// rst:
+	// rst:		A journal can be loaded like a dump, with :func:`DG::load` or :func:`load`,
+	// rst:		e.g., to recover a derivation graph from a calculation that was terminated.
+	// rst:		An incomplete record at the end of the journal is ignored.
+	// rst:		The graph names recorded are those the graphs have when they become vertices.
+	// rst:
+	// rst:		:throws: :class:`LogicError` if the file can not be opened.
+	// rst:		:throws: :class:`LogicError` if the derivation graph has stereo label settings.
+	void startJournal(const std::string &file);
 private:
 	struct Pimpl;
 	std::unique_ptr<Pimpl> p;
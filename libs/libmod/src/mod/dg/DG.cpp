@@ -10,6 +10,7 @@
 #include <mod/lib/DG/NonHyperBuilder.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
 #include <mod/lib/DG/Strategies/Strategy.hpp>
+#include <mod/lib/DG/IO/BinaryDump.hpp>
 #include <mod/lib/DG/IO/Read.hpp>
 #include <mod/lib/DG/IO/Write.hpp>
 #include <mod/lib/Graph/Single.hpp>
@@ -17,6 +18,7 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <fstream>
 #include <iostream>
 
 namespace mod::dg {
@@ -195,6 +197,17 @@ std::string DG::dump(const std::string &filename) const {
 	}
 }
 
+std::string DG::dumpBinary() const {
+	return dumpBinary("");
+}
+
+std::string DG::dumpBinary(const std::string &filename) const {
+	if(!isLocked()) throw LogicError("Can not dump DG before it is locked.");
+	const std::string name = filename.empty() ? lib::IO::makeUniqueFilePrefix() + "DG.dgb" : filename;
+	lib::DG::BinaryDump::write(getNonHyper(), name);
+	return name;
+}
+
 void DG::listStats() const {
 	if(!isLocked()) throw LogicError("No stats can be printed before calculation.");
 	else p->dg->getHyper().printStats(std::cout);
@@ -255,6 +268,23 @@ std::shared_ptr<DG> DG::load(const std::vector<std::shared_ptr<graph::Graph>> &g
 	return wrapIt(new DG(std::move(dgInternal)));
 }
 
+void DG::convertDump(const std::string &fileIn, const std::string &fileOut) {
+	if(!std::ifstream(fileIn)) throw InputError("Could not open file '" + fileIn + "'.");
+	std::ostringstream err;
+	if(lib::DG::BinaryDump::isBinaryDump(fileIn)) {
+		const auto view = lib::DG::BinaryDump::View::open(fileIn, err);
+		if(!view) throw InputError("DG dump conversion error: " + err.str());
+		auto jOpt = lib::DG::BinaryDump::toJson(*view, err);
+		if(!jOpt) throw InputError("DG dump conversion error: " + err.str());
+		lib::IO::writeJsonFile(fileOut, *jOpt);
+	} else {
+		auto jOpt = lib::DG::Read::loadDump(fileIn, err);
+		if(!jOpt) throw InputError("DG dump conversion error: " + err.str());
+		if(!lib::DG::BinaryDump::fromJson(*jOpt, fileOut, err))
+			throw InputError("DG dump conversion error: " + err.str());
+	}
+}
+
 void DG::diff(std::shared_ptr<DG> dg1, std::shared_ptr<DG> dg2) {
 	lib::DG::NonHyper::diff(dg1->getNonHyper(), dg2->getNonHyper());
 }
@@ -159,6 +159,24 @@ public:
 	// rst:		:throws: :class:`LogicError` if the target file can not be opened.
 	std::string dump() const;
 	std::string dump(const std::string &filename) const;
+	// rst: .. function:: std::string dumpBinary() const
+	// rst:               std::string dumpBinary(const std::string &filename) const
+	// rst:
+	// rst:		Exports the derivation graph to a file in a binary format with the same content as :func:`dump`.
+	// rst:		The format is faster to write and to load, and it needs less memory when loading,
+	// rst:		as the file is memory mapped and the graphs are stored in a compact adjacency array form.
+	// rst:		Loading still constructs every vertex graph, as they are checked against the graph database.
+	// rst:		Both :func:`load` and :func:`Builder::load` detect the format automatically.
+	// rst:		Use :func:`convertDump` to convert between the two formats.
+	// rst:
+	// rst:		:param filename: the name of the file to save the dump to.
+	// rst:			If non is given an auto-generated name in the ``out/`` folder is used.
+	// rst:			If an empty string is given, it is treated as if non is given.
+	// rst:		:returns: the name of the file with the exported data.
+	// rst:		:throws: :class:`LogicError` if `!isLocked()`.
+	// rst:		:throws: :class:`LogicError` if the target file can not be opened.
+	std::string dumpBinary() const;
+	std::string dumpBinary(const std::string &filename) const;
 	// rst: .. function:: void listStats() const
 	// rst: 
 	// rst:		Output various stats of the derivation graph.
@@ -234,6 +252,16 @@ public:
 	                                const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
 	                                const std::string &file,
 	                                IsomorphismPolicy graphPolicy, int verbosity);
+	// rst: .. function:: static void convertDump(const std::string &fileIn, const std::string &fileOut)
+	// rst:
+	// rst:		Convert a dump made by :func:`dump` to the format of :func:`dumpBinary`, or vice versa.
+	// rst:		The direction is determined by the format of the input file.
+	// rst:		Dumps in the formats of version 0.10 and earlier can not be converted,
+	// rst:		but must be loaded with :func:`load` and dumped again.
+	// rst:
+	// rst:		:throws: :class:`InputError` if the input file can not be opened or its content is bad.
+	// rst:		:throws: :class:`LogicError` if the output file can not be opened.
+	static void convertDump(const std::string &fileIn, const std::string &fileOut);
 	// rst: .. function:: static void diff(std::shared_ptr<DG> dg1, std::shared_ptr<DG> dg2)
 	// rst:
 	// rst: 		Compare two derivation graphs and lists the difference.
@@ -0,0 +1,107 @@
+#include "DerivationPredicate.hpp"
+
+#include <mod/Derivation.hpp>
+#include <mod/Error.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace mod::dg {
+
+struct DerivationPredicate::Pimpl {
+	std::string name;
+	std::function<bool(const Derivation &)> f;
+	bool usesRight;
+};
+
+namespace {
+
+std::string makeName(const char *prefix, const graph::Predicate &p) {
+	std::ostringstream s;
+	s << prefix << '(' << p << ')';
+	return s.str();
+}
+
+} // namespace
+
+DerivationPredicate::DerivationPredicate(std::string name, std::function<bool(const Derivation &)> f)
+		: DerivationPredicate(std::move(name), std::move(f), false) {}
+
+DerivationPredicate::DerivationPredicate(std::string name, std::function<bool(const Derivation &)> f,
+                                         bool usesRight) {
+	if(!f) throw LogicError("The predicate function is empty.");
+	p = std::make_shared<const Pimpl>(Pimpl{std::move(name), std::move(f), usesRight});
+}
+
+bool DerivationPredicate::operator()(const Derivation &d) const {
+	return p->f(d);
+}
+
+bool DerivationPredicate::usesRight() const {
+	return p->usesRight;
+}
+
+std::ostream &operator<<(std::ostream &s, const DerivationPredicate &p) {
+	return s << p.p->name;
+}
+
+DerivationPredicate operator&&(const DerivationPredicate &a, const DerivationPredicate &b) {
+	std::ostringstream s;
+	s << '(' << a << " and " << b << ')';
+	return DerivationPredicate(s.str(), [a, b](const Derivation &d) {
+		return a(d) && b(d);
+	}, a.usesRight() || b.usesRight());
+}
+
+DerivationPredicate operator||(const DerivationPredicate &a, const DerivationPredicate &b) {
+	std::ostringstream s;
+	s << '(' << a << " or " << b << ')';
+	return DerivationPredicate(s.str(), [a, b](const Derivation &d) {
+		return a(d) || b(d);
+	}, a.usesRight() || b.usesRight());
+}
+
+DerivationPredicate operator!(const DerivationPredicate &a) {
+	std::ostringstream s;
+	s << "not " << a;
+	return DerivationPredicate(s.str(), [a](const Derivation &d) {
+		return !a(d);
+	}, a.usesRight());
+}
+
+DerivationPredicate DerivationPredicate::constant(bool value) {
+	return DerivationPredicate(value ? "true" : "false", [value](const Derivation &) {
+		return value;
+	});
+}
+
+DerivationPredicate DerivationPredicate::allLeft(graph::Predicate p) {
+	auto name = makeName("allLeft", p);
+	return DerivationPredicate(std::move(name), [p = std::move(p)](const Derivation &d) {
+		return std::all_of(d.left.begin(), d.left.end(), [&p](const auto &g) { return p(*g); });
+	});
+}
+
+DerivationPredicate DerivationPredicate::anyLeft(graph::Predicate p) {
+	auto name = makeName("anyLeft", p);
+	return DerivationPredicate(std::move(name), [p = std::move(p)](const Derivation &d) {
+		return std::any_of(d.left.begin(), d.left.end(), [&p](const auto &g) { return p(*g); });
+	});
+}
+
+DerivationPredicate DerivationPredicate::allRight(graph::Predicate p) {
+	auto name = makeName("allRight", p);
+	return DerivationPredicate(std::move(name), [p = std::move(p)](const Derivation &d) {
+		return std::all_of(d.right.begin(), d.right.end(), [&p](const auto &g) { return p(*g); });
+	}, true);
+}
+
+DerivationPredicate DerivationPredicate::anyRight(graph::Predicate p) {
+	auto name = makeName("anyRight", p);
+	return DerivationPredicate(std::move(name), [p = std::move(p)](const Derivation &d) {
+		return std::any_of(d.right.begin(), d.right.end(), [&p](const auto &g) { return p(*g); });
+	}, true);
+}
+
+} // namespace mod::dg
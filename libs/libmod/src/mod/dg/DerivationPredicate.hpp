@@ -0,0 +1,78 @@
+#ifndef MOD_DG_DERIVATIONPREDICATE_HPP
+#define MOD_DG_DERIVATIONPREDICATE_HPP
+
+#include <mod/BuildConfig.hpp>
+#include <mod/graph/Predicate.hpp>
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace mod {
+struct Derivation;
+} // namespace mod
+namespace mod::dg {
+
+// rst-class: dg::DerivationPredicate
+// rst:
+// rst:		A predicate on :class:`Derivation`\ s, which is evaluated natively.
+// rst:		It can be used with :cpp:func:`Strategy::makeLeftPredicate` and :cpp:func:`Strategy::makeRightPredicate`.
+// rst:		Recall that in a left predicate only the left side and the rule of the derivation are valid,
+// rst:		so the right side is empty. For example, :cpp:func:`allRight` would therefore be true for every derivation,
+// rst:		and predicates using :cpp:func:`allRight` or :cpp:func:`anyRight` are rejected as left predicates.
+// rst:		Predicates are cheap to copy, and can be composed with the logical operators.
+// rst:		The binary operators short-circuit when the predicate is evaluated.
+// rst:
+// rst-class-start:
+struct MOD_DECL DerivationPredicate {
+	// rst: .. function:: DerivationPredicate(std::string name, std::function<bool(const Derivation&)> f)
+	// rst:
+	// rst:		Construct a predicate evaluated by `f`. The `name` is used when printing the predicate.
+	// rst:
+	// rst:		:throws: :class:`LogicError` if `f` is empty.
+	DerivationPredicate(std::string name, std::function<bool(const Derivation &)> f);
+	// rst: .. function:: bool operator()(const Derivation &d) const
+	// rst:
+	// rst:		:returns: whether `d` satisfies the predicate.
+	bool operator()(const Derivation &d) const;
+	// rst: .. function:: bool usesRight() const
+	// rst:
+	// rst:		:returns: whether the predicate is composed using :cpp:func:`allRight` or :cpp:func:`anyRight`,
+	// rst:			i.e., whether it depends on the right side of the derivation.
+	bool usesRight() const;
+	// rst: .. function:: friend std::ostream &operator<<(std::ostream &s, const DerivationPredicate &p)
+	MOD_DECL friend std::ostream &operator<<(std::ostream &s, const DerivationPredicate &p);
+	// rst: .. function:: friend DerivationPredicate operator&&(const DerivationPredicate &a, const DerivationPredicate &b)
+	// rst:               friend DerivationPredicate operator||(const DerivationPredicate &a, const DerivationPredicate &b)
+	// rst:               friend DerivationPredicate operator!(const DerivationPredicate &a)
+	MOD_DECL friend DerivationPredicate operator&&(const DerivationPredicate &a, const DerivationPredicate &b);
+	MOD_DECL friend DerivationPredicate operator||(const DerivationPredicate &a, const DerivationPredicate &b);
+	MOD_DECL friend DerivationPredicate operator!(const DerivationPredicate &a);
+public:
+	// rst: .. function:: static DerivationPredicate constant(bool value)
+	// rst:
+	// rst:		:returns: a predicate which is `value` for every derivation.
+	static DerivationPredicate constant(bool value);
+	// rst: .. function:: static DerivationPredicate allLeft(graph::Predicate p)
+	// rst:               static DerivationPredicate anyLeft(graph::Predicate p)
+	// rst:               static DerivationPredicate allRight(graph::Predicate p)
+	// rst:               static DerivationPredicate anyRight(graph::Predicate p)
+	// rst:
+	// rst:		:returns: a predicate which is true for derivations where respectively all or some of the graphs
+	// rst:			on the given side satisfy `p`.
+	static DerivationPredicate allLeft(graph::Predicate p);
+	static DerivationPredicate anyLeft(graph::Predicate p);
+	static DerivationPredicate allRight(graph::Predicate p);
+	static DerivationPredicate anyRight(graph::Predicate p);
+private:
+	DerivationPredicate(std::string name, std::function<bool(const Derivation &)> f, bool usesRight);
+private:
+	struct Pimpl;
+	std::shared_ptr<const Pimpl> p;
+};
+// rst-class-end:
+
+} // namespace mod::dg
+
+#endif // MOD_DG_DERIVATIONPREDICATE_HPP
@@ -4,6 +4,7 @@
 namespace mod::dg {
 struct Builder;
 struct DG;
+struct DerivationPredicate;
 struct ExecuteResult;
 struct PrintData;
 struct Printer;
@@ -1,6 +1,9 @@
 #include "Strategies.hpp"
 
 #include <mod/Error.hpp>
+#include <mod/Function.hpp>
+#include <mod/dg/DerivationPredicate.hpp>
+#include <mod/graph/Predicate.hpp>
 #include <mod/rule/Rule.hpp>
 #include <mod/lib/DG/Strategies/Strategy.hpp>
 #include <mod/lib/DG/Strategies/Add.hpp>
@@ -15,6 +18,7 @@
 #include <mod/lib/IO/IO.hpp>
 
 #include <ostream>
+#include <sstream>
 
 namespace mod::dg {
 
@@ -124,6 +128,15 @@ std::shared_ptr<Strategy> Strategy::makeFilter(
 	return std::make_unique<Strategy>(std::make_unique<lib::DG::Strategies::Filter>(filterFunc, alsoUniverse));
 }
 
+std::shared_ptr<Strategy> Strategy::makeFilter(bool alsoUniverse, const graph::Predicate &predicate) {
+	std::ostringstream name;
+	name << predicate;
+	return makeFilter(alsoUniverse, mod::fromStdFunction<bool(std::shared_ptr<graph::Graph>, const Strategy::GraphState &, bool)>(
+			name.str(), [predicate](std::shared_ptr<graph::Graph> g, const Strategy::GraphState &, bool) {
+				return predicate(*g);
+			}));
+}
+
 std::shared_ptr<Strategy>
 Strategy::makeExecute(std::shared_ptr<mod::Function<void(const Strategy::GraphState &)>> func) {
 	if(!func) throw LogicError("The callback is a null pointer.");
@@ -144,6 +157,16 @@ Strategy::makeLeftPredicate(std::shared_ptr<mod::Function<bool(const mod::Deriva
 			std::make_unique<lib::DG::Strategies::LeftPredicate>(predicate, strategy->getStrategy().clone()));
 }
 
+std::shared_ptr<Strategy>
+Strategy::makeLeftPredicate(const DerivationPredicate &predicate, std::shared_ptr<Strategy> strategy) {
+	if(predicate.usesRight())
+		throw LogicError("The left predicate uses the right side of the derivation, which is empty in left predicates.");
+	std::ostringstream name;
+	name << predicate;
+	return makeLeftPredicate(mod::fromStdFunction<bool(const mod::Derivation &)>(name.str(), predicate),
+	                         std::move(strategy));
+}
+
 std::shared_ptr<Strategy>
 Strategy::makeRightPredicate(std::shared_ptr<mod::Function<bool(const mod::Derivation &)>> predicate,
                              std::shared_ptr<Strategy> strategy) {
@@ -153,6 +176,14 @@ Strategy::makeRightPredicate(std::shared_ptr<mod::Function<bool(const mod::Deriv
 			std::make_unique<lib::DG::Strategies::RightPredicate>(predicate, strategy->getStrategy().clone()));
 }
 
+std::shared_ptr<Strategy>
+Strategy::makeRightPredicate(const DerivationPredicate &predicate, std::shared_ptr<Strategy> strategy) {
+	std::ostringstream name;
+	name << predicate;
+	return makeRightPredicate(mod::fromStdFunction<bool(const mod::Derivation &)>(name.str(), predicate),
+	                          std::move(strategy));
+}
+
 std::shared_ptr<Strategy> Strategy::makeRevive(std::shared_ptr<Strategy> strategy) {
 	if(!strategy) throw LogicError("The substrategy is a null pointer.");
 	return std::make_unique<Strategy>(std::make_unique<lib::DG::Strategies::Revive>(strategy->getStrategy().clone()));
@@ -101,6 +101,13 @@ public:
 	                                            std::shared_ptr<Function<bool(std::shared_ptr<graph::Graph>,
 	                                                                          const Strategy::GraphState &,
 	                                                                          bool)>> filterFunc);
+	// rst: .. function:: static std::shared_ptr<Strategy> makeFilter(bool alsoUniverse, const graph::Predicate &predicate)
+	// rst:
+	// rst:		Like the other overload, but the filtering is done with a natively evaluated :class:`graph::Predicate`,
+	// rst:		which is only given the graph.
+	// rst:
+	// rst:		:returns: a :ref:`strat-filterUniverse` strategy if `alsoUniverse` is `true`, otherwise a :ref:`strat-filterSubset` strategy.
+	static std::shared_ptr<Strategy> makeFilter(bool alsoUniverse, const graph::Predicate &predicate);
 	// rst: .. function:: static std::shared_ptr<Strategy> makeExecute(std::shared_ptr<Function<void(const Strategy::GraphState&)>> func)
 	// rst:
 	// rst:		:returns: an :ref:`strat-execute` strategy.
@@ -119,6 +126,15 @@ public:
 	// rst:		:throws: :class:`LogicError` if `predicate` or `strategy` is a `nullptr`.
 	static std::shared_ptr<Strategy>
 	makeLeftPredicate(std::shared_ptr<Function<bool(const Derivation &)>> predicate, std::shared_ptr<Strategy> strategy);
+	// rst: .. function:: static std::shared_ptr<Strategy> makeLeftPredicate(const DerivationPredicate &predicate, std::shared_ptr<Strategy> strategy)
+	// rst:
+	// rst:		Like the other overload, but with a natively evaluated :class:`DerivationPredicate`.
+	// rst:
+	// rst:		:returns: a :ref:`strat-leftPredicate` strategy.
+	// rst:		:throws: :class:`LogicError` if `strategy` is a `nullptr`.
+	// rst:		:throws: :class:`LogicError` if `predicate.usesRight()`, as the right side is empty in left predicates.
+	static std::shared_ptr<Strategy>
+	makeLeftPredicate(const DerivationPredicate &predicate, std::shared_ptr<Strategy> strategy);
 	// rst: .. function:: static std::shared_ptr<Strategy> makeRightPredicate(std::shared_ptr<Function<bool(const Derivation&) >> predicate, std::shared_ptr<Strategy> strategy)
 	// rst:
 	// rst:		:returns: a :ref:`strat-rightPredicate` strategy.
@@ -126,6 +142,14 @@ public:
 	static std::shared_ptr<Strategy>
 	makeRightPredicate(std::shared_ptr<Function<bool(const Derivation &)>> predicate,
 	                   std::shared_ptr<Strategy> strategy);
+	// rst: .. function:: static std::shared_ptr<Strategy> makeRightPredicate(const DerivationPredicate &predicate, std::shared_ptr<Strategy> strategy)
+	// rst:
+	// rst:		Like the other overload, but with a natively evaluated :class:`DerivationPredicate`.
+	// rst:
+	// rst:		:returns: a :ref:`strat-rightPredicate` strategy.
+	// rst:		:throws: :class:`LogicError` if `strategy` is a `nullptr`.
+	static std::shared_ptr<Strategy>
+	makeRightPredicate(const DerivationPredicate &predicate, std::shared_ptr<Strategy> strategy);
 	// rst: .. function:: static std::shared_ptr<Strategy> makeRevive(std::shared_ptr<Strategy> strategy)
 	// rst:
 	// rst:		:returns: a :ref:`strat-revive` strategy.
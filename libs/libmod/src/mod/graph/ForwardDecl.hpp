@@ -4,7 +4,9 @@
 namespace mod::graph {
 struct Graph;
 struct GraphLess;
+struct Predicate;
 struct Printer;
+struct Quantity;
 } // namespace mod::graph
 namespace mod::lib {
 template<typename LGraph>
@@ -210,7 +210,7 @@ void Graph::enumerateMonomorphisms(std::shared_ptr<Graph> codomain,
 }
 
 std::shared_ptr<Graph> Graph::makePermutation() const {
-	auto gPerm = create(std::make_unique<lib::Graph::Single>(lib::Graph::makePermutation(*g)));
+	auto gPerm = create(lib::Graph::makePermutation(*g));
 	gPerm->setName(getName() + " perm");
 	return gPerm;
 }
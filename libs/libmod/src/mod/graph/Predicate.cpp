@@ -0,0 +1,222 @@
+#include "Predicate.hpp"
+
+#include <mod/Error.hpp>
+#include <mod/graph/Graph.hpp>
+#include <mod/lib/Graph/Single.hpp>
+#include <mod/lib/Graph/Properties/Molecule.hpp>
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <iostream>
+#include <sstream>
+
+namespace mod::graph {
+
+// Quantity
+//------------------------------------------------------------------------------
+
+struct Quantity::Pimpl {
+	std::string name;
+	std::function<double(const Graph &)> f;
+};
+
+namespace {
+
+std::string constantName(double value) {
+	std::ostringstream s;
+	s << value;
+	return s.str();
+}
+
+template<typename Op>
+Quantity makeArithmetic(const Quantity &a, const Quantity &b, const char *opName, Op op) {
+	std::ostringstream s;
+	s << '(' << a << ' ' << opName << ' ' << b << ')';
+	return Quantity(s.str(), [a, b, op](const Graph &g) {
+		return op(a(g), b(g));
+	});
+}
+
+template<typename Op>
+Predicate makeComparison(const Quantity &a, const Quantity &b, const char *opName, Op op) {
+	std::ostringstream s;
+	s << a << ' ' << opName << ' ' << b;
+	return Predicate(s.str(), [a, b, op](const Graph &g) {
+		return op(a(g), b(g));
+	});
+}
+
+} // namespace
+
+Quantity::Quantity(double value)
+		: p(std::make_shared<const Pimpl>(Pimpl{constantName(value), [value](const Graph &) { return value; }})) {}
+
+Quantity::Quantity(std::string name, std::function<double(const Graph &)> f) {
+	if(!f) throw LogicError("The quantity function is empty.");
+	p = std::make_shared<const Pimpl>(Pimpl{std::move(name), std::move(f)});
+}
+
+double Quantity::operator()(const Graph &g) const {
+	return p->f(g);
+}
+
+std::ostream &operator<<(std::ostream &s, const Quantity &q) {
+	return s << q.p->name;
+}
+
+Quantity operator+(const Quantity &a, const Quantity &b) {
+	return makeArithmetic(a, b, "+", std::plus<>());
+}
+
+Quantity operator-(const Quantity &a, const Quantity &b) {
+	return makeArithmetic(a, b, "-", std::minus<>());
+}
+
+Quantity operator*(const Quantity &a, const Quantity &b) {
+	return makeArithmetic(a, b, "*", std::multiplies<>());
+}
+
+Predicate operator<(const Quantity &a, const Quantity &b) {
+	return makeComparison(a, b, "<", std::less<>());
+}
+
+Predicate operator<=(const Quantity &a, const Quantity &b) {
+	return makeComparison(a, b, "<=", std::less_equal<>());
+}
+
+Predicate operator>(const Quantity &a, const Quantity &b) {
+	return makeComparison(a, b, ">", std::greater<>());
+}
+
+Predicate operator>=(const Quantity &a, const Quantity &b) {
+	return makeComparison(a, b, ">=", std::greater_equal<>());
+}
+
+Predicate operator==(const Quantity &a, const Quantity &b) {
+	return makeComparison(a, b, "==", std::equal_to<>());
+}
+
+Predicate operator!=(const Quantity &a, const Quantity &b) {
+	return makeComparison(a, b, "!=", std::not_equal_to<>());
+}
+
+Quantity Quantity::numVertices() {
+	return Quantity("numVertices", [](const Graph &g) -> double {
+		return g.numVertices();
+	});
+}
+
+Quantity Quantity::numEdges() {
+	return Quantity("numEdges", [](const Graph &g) -> double {
+		return g.numEdges();
+	});
+}
+
+Quantity Quantity::vertexLabelCount(const std::string &label) {
+	return Quantity("vertexLabelCount('" + label + "')", [label](const Graph &g) -> double {
+		return g.vLabelCount(label);
+	});
+}
+
+Quantity Quantity::edgeLabelCount(const std::string &label) {
+	return Quantity("edgeLabelCount('" + label + "')", [label](const Graph &g) -> double {
+		return g.eLabelCount(label);
+	});
+}
+
+Quantity Quantity::exactMass() {
+	return Quantity("exactMass", [](const Graph &g) {
+		return g.getExactMass();
+	});
+}
+
+Quantity Quantity::charge() {
+	return Quantity("charge", [](const Graph &g) -> double {
+		const auto &gLib = g.getGraph();
+		const auto &mol = gLib.getMoleculeState();
+		int res = 0;
+		for(const auto v : asRange(vertices(gLib.getGraph())))
+			res += mol[v].getCharge();
+		return res;
+	});
+}
+
+Quantity Quantity::numRings() {
+	// graphs are connected, so there is exactly one component
+	return Quantity("numRings", [](const Graph &g) -> double {
+		return static_cast<double>(g.numEdges()) - static_cast<double>(g.numVertices()) + 1;
+	});
+}
+
+// Predicate
+//------------------------------------------------------------------------------
+
+struct Predicate::Pimpl {
+	std::string name;
+	std::function<bool(const Graph &)> f;
+};
+
+Predicate::Predicate(std::string name, std::function<bool(const Graph &)> f) {
+	if(!f) throw LogicError("The predicate function is empty.");
+	p = std::make_shared<const Pimpl>(Pimpl{std::move(name), std::move(f)});
+}
+
+bool Predicate::operator()(const Graph &g) const {
+	return p->f(g);
+}
+
+std::ostream &operator<<(std::ostream &s, const Predicate &p) {
+	return s << p.p->name;
+}
+
+Predicate operator&&(const Predicate &a, const Predicate &b) {
+	std::ostringstream s;
+	s << '(' << a << " and " << b << ')';
+	return Predicate(s.str(), [a, b](const Graph &g) {
+		return a(g) && b(g);
+	});
+}
+
+Predicate operator||(const Predicate &a, const Predicate &b) {
+	std::ostringstream s;
+	s << '(' << a << " or " << b << ')';
+	return Predicate(s.str(), [a, b](const Graph &g) {
+		return a(g) || b(g);
+	});
+}
+
+Predicate operator!(const Predicate &a) {
+	std::ostringstream s;
+	s << "not " << a;
+	return Predicate(s.str(), [a](const Graph &g) {
+		return !a(g);
+	});
+}
+
+Predicate Predicate::constant(bool value) {
+	return Predicate(value ? "true" : "false", [value](const Graph &) {
+		return value;
+	});
+}
+
+Predicate Predicate::isMolecule() {
+	return Predicate("isMolecule", [](const Graph &g) {
+		return g.getIsMolecule();
+	});
+}
+
+Predicate Predicate::isomorphicTo(std::shared_ptr<Graph> other, LabelSettings labelSettings) {
+	if(!other) throw LogicError("The graph is a null pointer.");
+	return Predicate("isomorphicTo('" + other->getName() + "')", [other, labelSettings](const Graph &g) {
+		return other->isomorphism(g.getGraph().getAPIReference(), 1, labelSettings) != 0;
+	});
+}
+
+Predicate Predicate::hasSubgraph(std::shared_ptr<Graph> pattern, LabelSettings labelSettings) {
+	if(!pattern) throw LogicError("The pattern is a null pointer.");
+	return Predicate("hasSubgraph('" + pattern->getName() + "')", [pattern, labelSettings](const Graph &g) {
+		return pattern->monomorphism(g.getGraph().getAPIReference(), 1, labelSettings) != 0;
+	});
+}
+
+} // namespace mod::graph
@@ -0,0 +1,150 @@
+#ifndef MOD_GRAPH_PREDICATE_HPP
+#define MOD_GRAPH_PREDICATE_HPP
+
+#include <mod/BuildConfig.hpp>
+#include <mod/Config.hpp>
+#include <mod/graph/ForwardDecl.hpp>
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace mod::graph {
+struct Predicate;
+
+// rst-class: graph::Quantity
+// rst:
+// rst:		A numeric property of graphs, which is evaluated natively.
+// rst:		Quantities can be combined arithmetically and compared to form :class:`Predicate`\ s,
+// rst:		which can then be used in strategies without calling back into user code for each graph.
+// rst:
+// rst-class-start:
+struct MOD_DECL Quantity {
+	// rst: .. function:: Quantity(double value)
+	// rst:
+	// rst:		Construct a quantity which is `value` for every graph.
+	Quantity(double value);
+	// rst: .. function:: Quantity(std::string name, std::function<double(const Graph&)> f)
+	// rst:
+	// rst:		Construct a quantity evaluated by `f`. The `name` is used when printing the quantity.
+	// rst:
+	// rst:		:throws: :class:`LogicError` if `f` is empty.
+	Quantity(std::string name, std::function<double(const Graph &)> f);
+	// rst: .. function:: double operator()(const Graph &g) const
+	// rst:
+	// rst:		:returns: the value of the quantity for `g`.
+	double operator()(const Graph &g) const;
+	// rst: .. function:: friend std::ostream &operator<<(std::ostream &s, const Quantity &q)
+	MOD_DECL friend std::ostream &operator<<(std::ostream &s, const Quantity &q);
+	// rst: .. function:: friend Quantity operator+(const Quantity &a, const Quantity &b)
+	// rst:               friend Quantity operator-(const Quantity &a, const Quantity &b)
+	// rst:               friend Quantity operator*(const Quantity &a, const Quantity &b)
+	// rst:
+	// rst:		:returns: the pointwise sum, difference, or product of the two quantities.
+	MOD_DECL friend Quantity operator+(const Quantity &a, const Quantity &b);
+	MOD_DECL friend Quantity operator-(const Quantity &a, const Quantity &b);
+	MOD_DECL friend Quantity operator*(const Quantity &a, const Quantity &b);
+	// rst: .. function:: friend Predicate operator<(const Quantity &a, const Quantity &b)
+	// rst:               friend Predicate operator<=(const Quantity &a, const Quantity &b)
+	// rst:               friend Predicate operator>(const Quantity &a, const Quantity &b)
+	// rst:               friend Predicate operator>=(const Quantity &a, const Quantity &b)
+	// rst:               friend Predicate operator==(const Quantity &a, const Quantity &b)
+	// rst:               friend Predicate operator!=(const Quantity &a, const Quantity &b)
+	// rst:
+	// rst:		:returns: a predicate comparing the values of the two quantities for a given graph.
+	MOD_DECL friend Predicate operator<(const Quantity &a, const Quantity &b);
+	MOD_DECL friend Predicate operator<=(const Quantity &a, const Quantity &b);
+	MOD_DECL friend Predicate operator>(const Quantity &a, const Quantity &b);
+	MOD_DECL friend Predicate operator>=(const Quantity &a, const Quantity &b);
+	MOD_DECL friend Predicate operator==(const Quantity &a, const Quantity &b);
+	MOD_DECL friend Predicate operator!=(const Quantity &a, const Quantity &b);
+public:
+	// rst: .. function:: static Quantity numVertices()
+	// rst:               static Quantity numEdges()
+	// rst:
+	// rst:		:returns: the quantities :cpp:func:`Graph::numVertices` and :cpp:func:`Graph::numEdges`.
+	static Quantity numVertices();
+	static Quantity numEdges();
+	// rst: .. function:: static Quantity vertexLabelCount(const std::string &label)
+	// rst:               static Quantity edgeLabelCount(const std::string &label)
+	// rst:
+	// rst:		:returns: the quantities :cpp:func:`Graph::vLabelCount` and :cpp:func:`Graph::eLabelCount`
+	// rst:			for the given label, e.g., ``vertexLabelCount("C")`` for the number of carbon atoms.
+	static Quantity vertexLabelCount(const std::string &label);
+	static Quantity edgeLabelCount(const std::string &label);
+	// rst: .. function:: static Quantity exactMass()
+	// rst:
+	// rst:		:returns: the quantity :cpp:func:`Graph::getExactMass`.
+	// rst:			Evaluating it on a graph which is not a molecule throws a :class:`LogicError`.
+	static Quantity exactMass();
+	// rst: .. function:: static Quantity charge()
+	// rst:
+	// rst:		:returns: the quantity being the sum of the charges of all vertices.
+	static Quantity charge();
+	// rst: .. function:: static Quantity numRings()
+	// rst:
+	// rst:		:returns: the quantity being the cyclomatic number of the graph,
+	// rst:			i.e., the number of edges minus the number of vertices plus one.
+	// rst:			For a molecule this is the number of rings in a smallest set of smallest rings.
+	static Quantity numRings();
+private:
+	struct Pimpl;
+	std::shared_ptr<const Pimpl> p;
+};
+// rst-class-end:
+
+// rst-class: graph::Predicate
+// rst:
+// rst:		A predicate on graphs, which is evaluated natively.
+// rst:		Predicates are cheap to copy, and can be composed with the logical operators.
+// rst:		The binary operators short-circuit when the predicate is evaluated.
+// rst:
+// rst-class-start:
+struct MOD_DECL Predicate {
+	// rst: .. function:: Predicate(std::string name, std::function<bool(const Graph&)> f)
+	// rst:
+	// rst:		Construct a predicate evaluated by `f`. The `name` is used when printing the predicate.
+	// rst:
+	// rst:		:throws: :class:`LogicError` if `f` is empty.
+	Predicate(std::string name, std::function<bool(const Graph &)> f);
+	// rst: .. function:: bool operator()(const Graph &g) const
+	// rst:
+	// rst:		:returns: whether `g` satisfies the predicate.
+	bool operator()(const Graph &g) const;
+	// rst: .. function:: friend std::ostream &operator<<(std::ostream &s, const Predicate &p)
+	MOD_DECL friend std::ostream &operator<<(std::ostream &s, const Predicate &p);
+	// rst: .. function:: friend Predicate operator&&(const Predicate &a, const Predicate &b)
+	// rst:               friend Predicate operator||(const Predicate &a, const Predicate &b)
+	// rst:               friend Predicate operator!(const Predicate &a)
+	MOD_DECL friend Predicate operator&&(const Predicate &a, const Predicate &b);
+	MOD_DECL friend Predicate operator||(const Predicate &a, const Predicate &b);
+	MOD_DECL friend Predicate operator!(const Predicate &a);
+public:
+	// rst: .. function:: static Predicate constant(bool value)
+	// rst:
+	// rst:		:returns: a predicate which is `value` for every graph.
+	static Predicate constant(bool value);
+	// rst: .. function:: static Predicate isMolecule()
+	// rst:
+	// rst:		:returns: the predicate :cpp:func:`Graph::getIsMolecule`.
+	static Predicate isMolecule();
+	// rst: .. function:: static Predicate isomorphicTo(std::shared_ptr<Graph> g, LabelSettings labelSettings)
+	// rst:
+	// rst:		:returns: a predicate which is true for graphs isomorphic to `g`.
+	// rst:		:throws: :class:`LogicError` if `g` is a null pointer.
+	static Predicate isomorphicTo(std::shared_ptr<Graph> g, LabelSettings labelSettings);
+	// rst: .. function:: static Predicate hasSubgraph(std::shared_ptr<Graph> pattern, LabelSettings labelSettings)
+	// rst:
+	// rst:		:returns: a predicate which is true for graphs that `pattern` has a monomorphism into.
+	// rst:		:throws: :class:`LogicError` if `pattern` is a null pointer.
+	static Predicate hasSubgraph(std::shared_ptr<Graph> pattern, LabelSettings labelSettings);
+private:
+	struct Pimpl;
+	std::shared_ptr<const Pimpl> p;
+};
+// rst-class-end:
+
+} // namespace mod::graph
+
+#endif // MOD_GRAPH_PREDICATE_HPP
@@ -26,12 +26,12 @@ std::unique_ptr<lib::Graph::PropString> makePropString(const lib::Graph::GraphTy
 
 void add(lib::Graph::PropString &pString, boost::graph_traits<lib::Graph::GraphType>::vertex_descriptor v,
          const std::string &value) {
-	pString.addVertex(v, value);
+	pString.addVertex(v, lib::InternedString(value));
 }
 
 void add(lib::Graph::PropString &pString, boost::graph_traits<lib::Graph::GraphType>::edge_descriptor e,
          const std::string &value) {
-	pString.addEdge(e, value);
+	pString.addEdge(e, lib::InternedString(value));
 }
 
 std::shared_ptr<graph::Graph> makeGraph(
@@ -0,0 +1,81 @@
+#ifndef MOD_LIB_ALGORITHM_APPENDLOG_HPP
+#define MOD_LIB_ALGORITHM_APPENDLOG_HPP
+
+#include <mod/Error.hpp>
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace mod::lib {
+
+// An append-only sequence which several threads may append to concurrently without locking.
+// The elements never move, but they must only be read when no appends are in progress,
+// e.g., after the parallelFor doing the appends has returned.
+// The elements appended by a single thread are in the order that thread appended them.
+template<typename T>
+struct AppendLog {
+	AppendLog() : numElements(0) {
+		for(auto &c : chunks) c.store(nullptr, std::memory_order_relaxed);
+	}
+
+	AppendLog(const AppendLog &) = delete;
+	AppendLog &operator=(const AppendLog &) = delete;
+
+	~AppendLog() {
+		for(auto &c : chunks) delete[] c.load(std::memory_order_relaxed);
+	}
+
+	// Returns the index of the new element.
+	std::size_t append(T x) {
+		const auto index = numElements.fetch_add(1, std::memory_order_acq_rel);
+		if(index > std::numeric_limits<std::uint32_t>::max())
+			throw FatalError("Too many elements in an append log.");
+		getSlot(index) = std::move(x);
+		return index;
+	}
+
+	std::size_t size() const {
+		return numElements.load(std::memory_order_acquire);
+	}
+
+	T &operator[](std::size_t index) {
+		assert(index < size());
+		const auto [chunk, offset] = locate(index);
+		return chunks[chunk].load(std::memory_order_acquire)[offset];
+	}
+private:
+	// Chunk k has room for 2^(k + FirstChunkBits) elements, as in StringStore.
+	static constexpr unsigned int FirstChunkBits = 6;
+	static constexpr unsigned int NumChunks = 32 - FirstChunkBits + 1;
+
+	static std::pair<unsigned int, std::size_t> locate(std::size_t index) {
+		const std::uint64_t x = std::uint64_t(index) + (std::uint64_t(1) << FirstChunkBits);
+		const unsigned int msb = 63 - __builtin_clzll(x);
+		return {msb - FirstChunkBits, x - (std::uint64_t(1) << msb)};
+	}
+
+	T &getSlot(std::size_t index) {
+		const auto [chunk, offset] = locate(index);
+		T *data = chunks[chunk].load(std::memory_order_acquire);
+		if(!data) {
+			// appends by other threads may need the same chunk
+			auto *fresh = new T[std::size_t(1) << (chunk + FirstChunkBits)];
+			if(chunks[chunk].compare_exchange_strong(data, fresh, std::memory_order_acq_rel)) data = fresh;
+			else delete[] fresh;
+		}
+		assert(data);
+		return data[offset];
+	}
+private:
+	std::array<std::atomic<T *>, NumChunks> chunks;
+	std::atomic<std::size_t> numElements;
+};
+
+} // namespace mod::lib
+
+#endif // MOD_LIB_ALGORITHM_APPENDLOG_HPP
@@ -1,6 +1,14 @@
 #ifndef MOD_LIB_ALGORITHM_MULTIDIMSELECTOR_HPP
 #define MOD_LIB_ALGORITHM_MULTIDIMSELECTOR_HPP
 
+#include <mod/Error.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <tuple>
+#include <vector>
+
 namespace mod::lib {
 
 template<bool AllowPartial, typename InnerRangeProvider>
@@ -12,21 +20,21 @@ struct MultiDimSelector {
 	struct const_iterator;
 	friend struct const_iterator;
 public:
+	// The morphisms of each (pattern, host) pair are only requested from the provider
+	// when the iteration reaches that pair, so an iteration that is stopped early,
+	// or which can not select a host for some pattern, does not compute the remaining pairs.
 	MultiDimSelector(std::size_t numPatterns, std::size_t numHosts, InnerRangeProvider morphismProvider)
-			: preDisabled(numPatterns, false) {
+			: morphismProvider(std::move(morphismProvider)),
+			  morphisms(numPatterns, std::vector<std::optional<InnerRange>>(numHosts)),
+			  preDisabled(numPatterns, false) {
 		assert(numPatterns > 0);
 		assert(numHosts > 0);
-		morphisms.reserve(numPatterns);
-		for(std::size_t iPattern = 0; iPattern < numPatterns; iPattern++) {
-			assert(morphisms.size() == iPattern);
-			std::vector<InnerRange> morphismsInner;
-			morphismsInner.reserve(numHosts);
-			for(std::size_t iHost = 0; iHost < numHosts; iHost++) {
-				assert(morphismsInner.size() == iHost);
-				morphismsInner.push_back(morphismProvider(iPattern, iHost));
-			}
-			morphisms.push_back(std::move(morphismsInner));
-		}
+	}
+
+	const InnerRange &getMorphisms(std::size_t pattern, std::size_t host) const {
+		auto &ms = morphisms[pattern][host];
+		if(!ms) ms = morphismProvider(pattern, host);
+		return *ms;
 	}
 
 	const_iterator begin() const {
@@ -36,9 +44,11 @@ public:
 	const_iterator end() const {
 		return const_iterator();
 	}
+private:
+	InnerRangeProvider morphismProvider;
 public:
-	// pattern -> host -> morphisms
-	std::vector<std::vector<InnerRange> > morphisms;
+	// pattern -> host -> morphisms, or nullopt if not yet computed
+	mutable std::vector<std::vector<std::optional<InnerRange>>> morphisms;
 	std::vector<bool> preDisabled;
 };
 
@@ -122,18 +132,15 @@ private:
 	bool setFirst(std::size_t pattern, std::size_t firstHost) {
 		auto &pos = position[pattern];
 		assert(!pos.disabled);
-		const auto &mPerHost = owner->morphisms[pattern];
-		auto hostIter = std::find_if(mPerHost.begin() + firstHost, mPerHost.end(), [&](const InnerRange & ms) {
-			return ms.begin() != ms.end();
-		});
-		if(hostIter == mPerHost.end()) {
-			return false;
-		} else {
-			pos.host = hostIter - mPerHost.begin();
-			pos.iterMorphism = hostIter->begin();
-			pos.iterMorphismEnd = hostIter->end();
+		for(std::size_t host = firstHost; host != maxHosts; ++host) {
+			const auto &ms = owner->getMorphisms(pattern, host);
+			if(ms.begin() == ms.end()) continue;
+			pos.host = host;
+			pos.iterMorphism = ms.begin();
+			pos.iterMorphismEnd = ms.end();
 			return true;
 		}
+		return false;
 	}
 
 	void inc(std::size_t pattern) {
@@ -0,0 +1,71 @@
+#ifndef MOD_LIB_ALGORITHM_PARALLEL_HPP
+#define MOD_LIB_ALGORITHM_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mod::lib {
+
+// Returns the number of threads to actually use when the user requested 'numThreads'.
+// A request of 0 means one thread per hardware thread.
+inline unsigned int resolveNumThreads(unsigned int numThreads) {
+	if(numThreads != 0) return numThreads;
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Calls f(i) for each i in [0, numTasks) using up to numThreads threads, the calling thread included.
+// Tasks are handed out in increasing order, but may complete in any order,
+// so f(i) should only write to data owned by task i.
+// If a task throws, no further tasks are started, and the first exception is rethrown
+// in the calling thread after all workers have stopped.
+template<typename F>
+void parallelFor(unsigned int numThreads, std::size_t numTasks, F f) {
+	const std::size_t numWorkers = std::min<std::size_t>(resolveNumThreads(numThreads), numTasks);
+	if(numWorkers <= 1) {
+		for(std::size_t i = 0; i != numTasks; ++i)
+			f(i);
+		return;
+	}
+	std::atomic<std::size_t> next(0);
+	std::atomic<bool> failed(false);
+	std::exception_ptr error;
+	std::mutex errorMutex;
+	const auto work = [&]() {
+		while(!failed.load(std::memory_order_relaxed)) {
+			const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+			if(i >= numTasks) break;
+			try {
+				f(i);
+			} catch(...) {
+				std::lock_guard<std::mutex> lock(errorMutex);
+				if(!error) error = std::current_exception();
+				failed = true;
+			}
+		}
+	};
+	std::vector<std::thread> workers;
+	workers.reserve(numWorkers - 1);
+	for(std::size_t i = 1; i != numWorkers; ++i)
+		workers.emplace_back(work);
+	work();
+	for(auto &t : workers)
+		t.join();
+	if(error) std::rethrow_exception(error);
+}
+
+// Increments a counter which may be incremented concurrently by other threads,
+// e.g., one of the statistics counters in the configuration, which are plain integers.
+// Reading the counter is only safe when no other thread is incrementing it.
+inline void incrementConcurrently(unsigned long &counter) {
+	// a relaxed atomic increment, as std::atomic_ref would do it, which is not available before C++20
+	__atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED);
+}
+
+} // namespace mod::lib
+
+#endif // MOD_LIB_ALGORITHM_PARALLEL_HPP
@@ -127,7 +127,7 @@ private:
 				s += a.symbol;
 				s += chargeSuffix(a.chg);
 				if(a.radical) s += '.';
-				datas[comp].pString->addVertex(v, std::move(s));
+				datas[comp].pString->addVertex(v, InternedString(s));
 			} else {
 				if(a.iso != Isotope()) {
 					auto res = handleAction(warnings, options.onPatternIsotope,
@@ -146,7 +146,7 @@ private:
 					                        "Pattern atom with ID " + std::to_string(i + 1) + " has radical.");
 					if(!res) return onError(res.extractError());
 				}
-				datas[comp].pString->addVertex(v, "*");
+				datas[comp].pString->addVertex(v, InternedString("*"));
 			}
 		}
 
@@ -163,7 +163,7 @@ private:
 				return onError("Parallel edges in MOL file between atom " + std::to_string(b.src)
 				               + " and " + std::to_string(b.tar) + ".");
 			const auto e = add_edge(vSrc, vTar, g).first;
-			datas[comp].pString->addEdge(e, b.type);
+			datas[comp].pString->addEdge(e, InternedString(b.type));
 			if(b.bondType == BondType::Invalid) {
 				hasAnyIncident[b.src - 1] = true;
 				hasAnyIncident[b.tar - 1] = true;
@@ -217,9 +217,9 @@ private:
 				const auto v = vertices(g).first[datas[comp].externalToInternalIds.find(i + 1)->second];
 				for(int j = valences[i]; j != valence; ++j) {
 					const auto vH = add_vertex(g);
-					datas[comp].pString->addVertex(vH, "H");
+					datas[comp].pString->addVertex(vH, InternedString("H"));
 					const auto eH = add_edge(v, vH, g).first;
-					datas[comp].pString->addEdge(eH, "-");
+					datas[comp].pString->addEdge(eH, InternedString("-"));
 				}
 			}
 		}
@@ -404,9 +404,9 @@ public:
 
 Vertex addHydrogen(lib::Graph::GraphType &g, lib::Graph::PropString &pString, Vertex p) {
 	Vertex v = add_vertex(g);
-	pString.addVertex(v, "H");
+	pString.addVertex(v, InternedString("H"));
 	Edge e = add_edge(v, p, g).first;
-	pString.addEdge(e, "-");
+	pString.addEdge(e, InternedString("-"));
 	return v;
 }
 
@@ -445,7 +445,7 @@ lib::IO::Result<> addBond(lib::IO::Warnings &warnings,
 	assert(ePair.second);
 	e = ePair.first;
 	assert(!edgeLabel.empty());
-	pString.addEdge(e, edgeLabel);
+	pString.addEdge(e, InternedString(edgeLabel));
 	return {};
 }
 
@@ -575,7 +575,7 @@ struct Converter {
 		auto &pString = *pStringPtrs[comp];
 		if(a.symbol == "*") {
 			a.vertex = add_vertex(g);
-			pString.addVertex(a.vertex, "*");
+			pString.addVertex(a.vertex, InternedString("*"));
 			if(a.class_ != -1)
 				classToVertexId.emplace(a.class_, std::pair(comp, a.vertex));
 			return {};
@@ -615,7 +615,7 @@ struct Converter {
 				}
 				classToVertexId.emplace(a.class_, std::pair(comp, a.vertex));
 			}
-			pString.addVertex(a.vertex, label);
+			pString.addVertex(a.vertex, InternedString(label));
 			return {};
 		}
 
@@ -648,7 +648,7 @@ struct Converter {
 				classToVertexId.emplace(a.class_, std::pair(comp, a.vertex));
 			}
 		}
-		pString.addVertex(a.vertex, label);
+		pString.addVertex(a.vertex, InternedString(label));
 		return {};
 	}
 
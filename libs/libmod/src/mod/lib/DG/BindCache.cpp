@@ -0,0 +1,33 @@
+#include "BindCache.hpp"
+
+#include <mod/Config.hpp>
+#include <mod/lib/Algorithm/Parallel.hpp>
+#include <mod/lib/Graph/Single.hpp>
+#include <mod/lib/Rules/Real.hpp>
+
+#include <mutex>
+
+namespace mod::lib::DG {
+
+std::optional<std::size_t>
+BindCache::find(const lib::Rules::Real &r, const lib::Graph::Single &g, bool count) const {
+	{
+		std::shared_lock<std::shared_mutex> lock(mtx);
+		const auto iter = numResults.find({r.getId(), g.getId()});
+		if(iter != numResults.end()) {
+			const auto res = iter->second;
+			lock.unlock();
+			if(count) incrementConcurrently(getConfig().dg.numBindCacheHits());
+			return res;
+		}
+	}
+	if(count) incrementConcurrently(getConfig().dg.numBindCacheMisses());
+	return {};
+}
+
+void BindCache::insert(const lib::Rules::Real &r, const lib::Graph::Single &g, std::size_t numResults) {
+	std::unique_lock<std::shared_mutex> lock(mtx);
+	this->numResults.emplace(std::make_pair(r.getId(), g.getId()), numResults);
+}
+
+} // namespace mod::lib::DG
@@ -0,0 +1,48 @@
+#ifndef MOD_LIB_DG_BINDCACHE_HPP
+#define MOD_LIB_DG_BINDCACHE_HPP
+
+#include <boost/functional/hash.hpp>
+
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace mod::lib::Graph {
+struct Single;
+} // namespace mod::lib::Graph
+namespace mod::lib::Rules {
+struct Real;
+} // namespace mod::lib::Rules
+namespace mod::lib::DG {
+
+// For pairs of a rule and a graph of a DG, the number of results of composing the bind rule of the graph
+// with the rule, i.e., of binding the graph in the first round of applying the rule.
+// A graph which can not be bound to any left component of a rule in the first round,
+// can not be bound in the later rounds either, where the rule only has fewer components left
+// and its labels can only have become more specific,
+// so such known-empty pairs can be skipped in all rounds, also in later executions on the same DG.
+// The pairs are identified by the ids of the rule and the graph, where the graphs are those of the DG,
+// so their ids are final.
+// All functions are thread-safe.
+struct BindCache {
+	// The recorded number of results, if known.
+	// The lookup is counted in config.dg.numBindCacheHits or numBindCacheMisses,
+	// unless count is false, e.g., because the pair has been looked up before in the same rule application.
+	std::optional<std::size_t> find(const lib::Rules::Real &r, const lib::Graph::Single &g, bool count = true) const;
+	// Whether the pair is known to have no results.
+	bool isKnownEmpty(const lib::Rules::Real &r, const lib::Graph::Single &g, bool count = true) const {
+		const auto res = find(r, g, count);
+		return res && *res == 0;
+	}
+	// Only record results of compositions which were not stopped early.
+	void insert(const lib::Rules::Real &r, const lib::Graph::Single &g, std::size_t numResults);
+private:
+	mutable std::shared_mutex mtx;
+	std::unordered_map<std::pair<std::size_t, std::size_t>, std::size_t,
+			boost::hash<std::pair<std::size_t, std::size_t>>> numResults;
+};
+
+} // namespace mod::lib::DG
+
+#endif // MOD_LIB_DG_BINDCACHE_HPP
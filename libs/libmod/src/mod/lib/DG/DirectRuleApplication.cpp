@@ -0,0 +1,445 @@
+#include "DirectRuleApplication.hpp"
+
+#include <mod/lib/Graph/LabelledGraph.hpp>
+#include <mod/lib/Graph/Single.hpp>
+#include <mod/lib/Graph/Properties/String.hpp>
+#include <mod/lib/LabelledUnionGraph.hpp>
+#include <mod/lib/Rules/Real.hpp>
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+
+namespace mod::lib::DG {
+namespace {
+using jla_boost::asRange;
+using lib::DPO::Membership;
+using HostGraph = lib::Graph::GraphType;
+using HostVertex = lib::Graph::Vertex;
+using UnionGraph = LabelledUnionGraph<lib::Graph::LabelledGraph>;
+using UnionVertex = boost::graph_traits<UnionGraph::GraphType>::vertex_descriptor;
+using RuleVertex = lib::Rules::LabelledRule::Vertex;
+using RuleEdge = lib::Rules::LabelledRule::Edge;
+const RuleVertex NullRuleVertex = boost::graph_traits<lib::Rules::LabelledRule::GraphType>::null_vertex();
+constexpr std::size_t None = -1;
+
+// The left side of a rule, prepared for matching one connected component at a time.
+struct Pattern {
+	// A vertex of a component, in the order they are matched.
+	struct Step {
+		RuleVertex v;
+		std::size_t vId;
+		InternedString label;
+		std::size_t degree;
+		bool deleted;
+		// the position of an earlier vertex adjacent to this one, or -1 for the first vertex
+		int parent;
+		// the positions of the earlier vertices adjacent to this one, with the labels of the edges
+		std::vector<std::pair<std::size_t, InternedString>> backEdges;
+	};
+public:
+	explicit Pattern(const lib::Rules::LabelledRule &rDPO) : rDPO(rDPO) {
+		const auto lgLeft = get_labelled_left(rDPO);
+		const auto &gLeft = get_graph(lgLeft);
+		const auto &pString = get_string(lgLeft);
+		const auto compMap = get_component(lgLeft);
+		numVertices = num_vertices(get_graph(rDPO));
+		components.resize(get_num_connected_components(lgLeft));
+		// each component in breadth-first order, so each vertex but the first has an earlier neighbour
+		std::vector<int> position(numVertices, -1);
+		for(const auto vRoot : asRange(vertices(gLeft))) {
+			const auto vRootId = get(boost::vertex_index_t(), gLeft, vRoot);
+			auto &comp = components[compMap[vRootId]];
+			if(!comp.empty()) continue;
+			const auto addStep = [&](RuleVertex v, int parent) {
+				const auto vId = get(boost::vertex_index_t(), gLeft, v);
+				position[vId] = comp.size();
+				const auto edgeRange = out_edges(v, gLeft);
+				comp.push_back(Step{v, vId, pString[v], std::size_t(std::distance(edgeRange.first, edgeRange.second)),
+				                    membership(rDPO, v) == Membership::L, parent, {}});
+			};
+			addStep(vRoot, -1);
+			for(std::size_t i = 0; i != comp.size(); ++i) {
+				for(const auto e : asRange(out_edges(comp[i].v, gLeft))) {
+					const auto vAdj = target(e, gLeft);
+					const auto vAdjId = get(boost::vertex_index_t(), gLeft, vAdj);
+					if(position[vAdjId] == -1) addStep(vAdj, i);
+				}
+			}
+			for(auto &s : comp) {
+				for(const auto e : asRange(out_edges(s.v, gLeft))) {
+					const auto pos = position[get(boost::vertex_index_t(), gLeft, target(e, gLeft))];
+					if(pos < position[s.vId])
+						s.backEdges.emplace_back(pos, pString[e]);
+				}
+			}
+		}
+		// the created edges between vertices in the context, which must not be parallel to an edge of an educt
+		const auto &gCombined = get_graph(rDPO);
+		for(const auto e : asRange(edges(gCombined))) {
+			if(membership(rDPO, e) != Membership::R) continue;
+			const auto vSrc = source(e, gCombined);
+			const auto vTar = target(e, gCombined);
+			if(membership(rDPO, vSrc) == Membership::K && membership(rDPO, vTar) == Membership::K)
+				createdContextEdges.emplace_back(vSrc, vTar);
+		}
+	}
+
+	// The edge of the left side between the two vertices, if any.
+	std::optional<RuleEdge> findLeftEdge(RuleVertex vSrc, RuleVertex vTar) const {
+		const auto &gLeft = get_graph(get_labelled_left(rDPO));
+		for(const auto e : asRange(out_edges(vSrc, gLeft)))
+			if(target(e, gLeft) == vTar) return e;
+		return {};
+	}
+public:
+	const lib::Rules::LabelledRule &rDPO;
+	std::size_t numVertices;
+	std::vector<std::vector<Step>> components;
+	std::vector<std::pair<RuleVertex, RuleVertex>> createdContextEdges;
+};
+
+// The educts bound so far, and the images of the vertices of the matched components.
+struct PartialMatch {
+	std::vector<std::size_t> graphs; // indices into the given graphs, non-decreasing
+	std::vector<UnionVertex> vertexMap; // by the vertex index of the rule, valid for the matched components
+	std::vector<bool> componentMatched;
+	std::size_t numMatched = 0;
+};
+
+// The graph derived by a complete match, before it is split into products.
+struct DerivedGraph {
+	// the educt vertices which are not deleted, in order, and then the created vertices
+	std::vector<InternedString> vertexLabels;
+	// the edges of the educts which are not deleted, and then the created edges
+	std::vector<std::tuple<std::size_t, std::size_t, InternedString>> edges;
+public:
+	// Together with the educts, the key identifies the derivation of the match.
+	std::vector<std::size_t> makeKey(const std::vector<std::size_t> &graphs) const {
+		std::vector<std::size_t> res{graphs.size()};
+		res.insert(res.end(), graphs.begin(), graphs.end());
+		res.push_back(vertexLabels.size());
+		for(const auto label : vertexLabels)
+			res.push_back(label.getId());
+		std::vector<std::tuple<std::size_t, std::size_t, std::size_t>> sortedEdges;
+		sortedEdges.reserve(edges.size());
+		for(const auto &[src, tar, label] : edges)
+			sortedEdges.emplace_back(std::min(src, tar), std::max(src, tar), label.getId());
+		std::sort(sortedEdges.begin(), sortedEdges.end());
+		for(const auto &[src, tar, label] : sortedEdges) {
+			res.push_back(src);
+			res.push_back(tar);
+			res.push_back(label);
+		}
+		return res;
+	}
+};
+
+struct Matcher {
+	Matcher(int verbosity, IO::Logger logger, const lib::Rules::Real &r,
+	        const std::vector<const lib::Graph::Single *> &graphs,
+	        const GetIndexKey &getIndexKey, const OnDirectDerivation &onDerivation)
+			: verbosity(verbosity), logger(logger), r(r), pattern(r.getDPORule()), graphs(graphs),
+			  getIndexKey(getIndexKey), onDerivation(onDerivation) {}
+
+	// Extends m with a copy of graphs[gIdx] and at least one more component matched into it.
+	// The complete matches are handled, and the partial ones are appended to 'partials' if keepPartial.
+	void bind(const PartialMatch &m, std::size_t gIdx, std::vector<PartialMatch> &partials, bool keepPartial) {
+		cur = m;
+		cur.graphs.push_back(gIdx);
+		host = &graphs[gIdx]->getLabelledGraph();
+		used.assign(num_vertices(get_graph(*host)), false);
+		out = &partials;
+		this->keepPartial = keepPartial;
+		numNew = 0;
+		assignComponent(0);
+	}
+private:
+	// Decides for each component from c and onwards whether to match it into the current educt or not.
+	void assignComponent(std::size_t c) {
+		if(c == pattern.components.size()) {
+			if(numNew == 0) return;
+			if(cur.numMatched == pattern.components.size()) handleComplete();
+			else if(keepPartial) out->push_back(cur);
+			return;
+		}
+		if(cur.componentMatched[c]) {
+			assignComponent(c + 1);
+			return;
+		}
+		cur.componentMatched[c] = true;
+		++cur.numMatched;
+		++numNew;
+		matchStep(c, 0);
+		--numNew;
+		--cur.numMatched;
+		cur.componentMatched[c] = false;
+		assignComponent(c + 1);
+	}
+
+	void matchStep(std::size_t c, std::size_t pos) {
+		const auto &comp = pattern.components[c];
+		if(pos == comp.size()) {
+			assignComponent(c + 1);
+			return;
+		}
+		const auto &g = get_graph(*host);
+		const auto &pString = get_string(*host);
+		const auto gIdx = cur.graphs.size() - 1;
+		const auto &s = comp[pos];
+		const auto tryVertex = [&](const HostVertex vHost) {
+			const auto vHostId = get(boost::vertex_index_t(), g, vHost);
+			if(used[vHostId]) return;
+			if(pString[vHost] != s.label) return;
+			const auto deg = out_degree(vHost, g);
+			// a deleted vertex must not have edges outside the match
+			if(deg < s.degree || (s.deleted && deg != s.degree)) return;
+			for(const auto &[posAdj, label] : s.backEdges) {
+				const auto ep = edge(vHost, cur.vertexMap[comp[posAdj].vId].v, g);
+				if(!ep.second || pString[ep.first] != label) return;
+			}
+			used[vHostId] = true;
+			cur.vertexMap[s.vId] = UnionVertex{gIdx, vHost};
+			matchStep(c, pos + 1);
+			used[vHostId] = false;
+		};
+		if(s.parent == -1) {
+			for(const auto vHost : asRange(vertices(g)))
+				tryVertex(vHost);
+		} else {
+			const auto vParent = cur.vertexMap[comp[s.parent].vId].v;
+			for(const auto e : asRange(out_edges(vParent, g)))
+				tryVertex(target(e, g));
+		}
+	}
+
+	void handleComplete() {
+		// an edge created between matched vertices must not be parallel to an edge of the educts,
+		// unless that edge is deleted
+		for(const auto &[vSrc, vTar] : pattern.createdContextEdges) {
+			const auto vSrcHost = cur.vertexMap[get(boost::vertex_index_t(), get_graph(pattern.rDPO), vSrc)];
+			const auto vTarHost = cur.vertexMap[get(boost::vertex_index_t(), get_graph(pattern.rDPO), vTar)];
+			if(vSrcHost.gIdx != vTarHost.gIdx) continue;
+			const auto &g = get_graph(graphs[cur.graphs[vSrcHost.gIdx]]->getLabelledGraph());
+			if(!edge(vSrcHost.v, vTarHost.v, g).second) continue;
+			const auto eLeft = pattern.findLeftEdge(vSrc, vTar);
+			if(!eLeft || membership(pattern.rDPO, *eLeft) != Membership::L) {
+				if(verbosity >= V_RuleApplication_Binding)
+					logger.indent() << "Skipping match, it would create a parallel edge." << std::endl;
+				return;
+			}
+		}
+		std::vector<const lib::Graph::Single *> educts;
+		educts.reserve(cur.graphs.size());
+		for(const auto gIdx : cur.graphs)
+			educts.push_back(graphs[gIdx]);
+		if(verbosity >= V_RuleApplication_Binding) {
+			logger.indent() << "Match of " << r.getName() << " into";
+			for(const auto *g : educts) logger.s << " " << g->getName();
+			logger.s << std::endl;
+		}
+		// Matches which derive the same graph from the same educts, e.g., due to symmetries of the rule,
+		// give the same derivation, so only the first of them is handled.
+		// Matches which only differ by a symmetry of the educts give isomorphic products,
+		// so they are handled as separate derivations, which the DG then merges.
+		const DerivedGraph derived = makeDerivedGraph(cur, educts);
+		if(!handled.insert(derived.makeKey(cur.graphs)).second) {
+			if(verbosity >= V_RuleApplication_Binding)
+				logger.indent() << "Skipping match, it gives the same derivation as an earlier match." << std::endl;
+			return;
+		}
+		onDerivation(educts, [this, &derived]() {
+			return makeProducts(derived);
+		});
+	}
+
+	DerivedGraph makeDerivedGraph(const PartialMatch &m, const std::vector<const lib::Graph::Single *> &educts) const {
+		const auto &rDPO = pattern.rDPO;
+		const auto &gCombined = get_graph(rDPO);
+		const auto lgRight = get_labelled_right(rDPO);
+		const auto &rpString = get_string(lgRight);
+		UnionGraph eductUnion;
+		for(const auto *g : educts)
+			eductUnion.push_back(&g->getLabelledGraph());
+		const auto &gUnion = get_graph(eductUnion);
+		const auto &upString = get_string(eductUnion);
+		const auto unionIndex = [&gUnion](UnionVertex v) {
+			return get(boost::vertex_index_t(), gUnion, v);
+		};
+
+		// the vertices of the derived graph: the educt vertices which are not deleted, then the created vertices
+		std::vector<RuleVertex> preimage(num_vertices(gUnion), NullRuleVertex);
+		for(const auto &comp : pattern.components)
+			for(const auto &s : comp)
+				preimage[unionIndex(m.vertexMap[s.vId])] = s.v;
+		std::vector<std::size_t> unionToResult(num_vertices(gUnion), None), ruleToResult(pattern.numVertices, None);
+		DerivedGraph res;
+		auto &vertexLabels = res.vertexLabels;
+		for(const auto v : asRange(vertices(gUnion))) {
+			const auto vId = unionIndex(v);
+			const auto vRule = preimage[vId];
+			if(vRule == NullRuleVertex) {
+				unionToResult[vId] = vertexLabels.size();
+				vertexLabels.push_back(upString[v]);
+			} else if(membership(rDPO, vRule) == Membership::K) {
+				unionToResult[vId] = vertexLabels.size();
+				ruleToResult[get(boost::vertex_index_t(), gCombined, vRule)] = vertexLabels.size();
+				vertexLabels.push_back(rpString[vRule]);
+			}
+		}
+		for(const auto v : asRange(vertices(gCombined))) {
+			if(membership(rDPO, v) != Membership::R) continue;
+			ruleToResult[get(boost::vertex_index_t(), gCombined, v)] = vertexLabels.size();
+			vertexLabels.push_back(rpString[v]);
+		}
+
+		// the edges of the educts which are not deleted, then the created edges
+		auto &resultEdges = res.edges;
+		for(const auto e : asRange(edges(gUnion))) {
+			const auto vSrc = source(e, gUnion);
+			const auto vTar = target(e, gUnion);
+			const auto vSrcRule = preimage[unionIndex(vSrc)];
+			const auto vTarRule = preimage[unionIndex(vTar)];
+			std::optional<RuleEdge> eLeft;
+			if(vSrcRule != NullRuleVertex && vTarRule != NullRuleVertex)
+				eLeft = pattern.findLeftEdge(vSrcRule, vTarRule);
+			if(eLeft && membership(rDPO, *eLeft) == Membership::L) continue;
+			const auto rSrc = unionToResult[unionIndex(vSrc)];
+			const auto rTar = unionToResult[unionIndex(vTar)];
+			// the dangling condition was checked when matching
+			assert(rSrc != None);
+			assert(rTar != None);
+			resultEdges.emplace_back(rSrc, rTar, eLeft ? rpString[*eLeft] : upString[e]);
+		}
+		for(const auto e : asRange(edges(gCombined))) {
+			if(membership(rDPO, e) != Membership::R) continue;
+			const auto toResult = [&](RuleVertex v) {
+				const auto vId = get(boost::vertex_index_t(), gCombined, v);
+				if(membership(rDPO, v) == Membership::R) return ruleToResult[vId];
+				else return unionToResult[unionIndex(m.vertexMap[vId])];
+			};
+			resultEdges.emplace_back(toResult(source(e, gCombined)), toResult(target(e, gCombined)), rpString[e]);
+		}
+		return res;
+	}
+
+	ProductCandidates makeProducts(const DerivedGraph &derived) const {
+		const auto &vertexLabels = derived.vertexLabels;
+		const auto &resultEdges = derived.edges;
+		// each connected component is a product, ordered by their first vertex
+		std::vector<std::size_t> parent(vertexLabels.size());
+		for(std::size_t i = 0; i != parent.size(); ++i) parent[i] = i;
+		const auto find = [&parent](std::size_t v) {
+			while(parent[v] != v) v = parent[v] = parent[parent[v]];
+			return v;
+		};
+		for(const auto &[rSrc, rTar, label] : resultEdges) {
+			const auto a = find(rSrc), b = find(rTar);
+			if(a < b) parent[b] = a;
+			else parent[a] = b;
+		}
+		std::vector<std::size_t> componentOf(vertexLabels.size(), None);
+		std::size_t numProducts = 0;
+		for(std::size_t v = 0; v != vertexLabels.size(); ++v) {
+			const auto root = find(v);
+			if(componentOf[root] == None) componentOf[root] = numProducts++;
+			componentOf[v] = componentOf[root];
+		}
+		std::vector<GraphData> products(numProducts);
+		std::vector<HostVertex> vertexMap(vertexLabels.size());
+		for(std::size_t v = 0; v != vertexLabels.size(); ++v) {
+			auto &p = products[componentOf[v]];
+			vertexMap[v] = add_vertex(*p.gPtr);
+			p.pStringPtr->addVertex(vertexMap[v], vertexLabels[v]);
+		}
+		for(const auto &[rSrc, rTar, label] : resultEdges) {
+			auto &p = products[componentOf[rSrc]];
+			const auto ep = add_edge(vertexMap[rSrc], vertexMap[rTar], *p.gPtr);
+			assert(ep.second);
+			p.pStringPtr->addEdge(ep.first, label);
+		}
+
+		ProductCandidates res;
+		res.graphs.reserve(numProducts);
+		res.indexKeys.reserve(numProducts);
+		const auto firstId = lib::Graph::Single::reserveIds(numProducts);
+		for(std::size_t i = 0; i != numProducts; ++i) {
+			auto &p = products[i];
+			res.graphs.push_back(std::make_unique<lib::Graph::Single>(std::move(p.gPtr), std::move(p.pStringPtr),
+			                                                          nullptr, firstId + i));
+			res.indexKeys.push_back(getIndexKey(*res.graphs.back()));
+		}
+		return res;
+	}
+private:
+	const int verbosity;
+	IO::Logger logger;
+	const lib::Rules::Real &r;
+	const Pattern pattern;
+	const std::vector<const lib::Graph::Single *> &graphs;
+	const GetIndexKey &getIndexKey;
+	const OnDirectDerivation &onDerivation;
+private: // the state of bind
+	PartialMatch cur;
+	const lib::Graph::LabelledGraph *host;
+	std::vector<bool> used; // by the vertex index of the host
+	std::vector<PartialMatch> *out;
+	bool keepPartial;
+	std::size_t numNew;
+private:
+	// the keys of the derivations handled so far, see DerivedGraph::makeKey
+	std::set<std::vector<std::size_t>> handled;
+};
+
+} // namespace
+
+bool canApplyDirectly(const lib::Rules::Real &r, LabelSettings labelSettings) {
+	if(labelSettings.type != LabelType::String) return false;
+	if(labelSettings.withStereo) return false;
+	return get_match_constraints(get_labelled_left(r.getDPORule())).empty();
+}
+
+void applyDirectly(int verbosity, IO::Logger logger, const lib::Rules::Real &r,
+                   const std::vector<const lib::Graph::Single *> &graphs, std::size_t numFirst,
+                   const GetIndexKey &getIndexKey, const SkipEduct &skipTried,
+                   const OnDirectDerivation &onDerivation) {
+	assert(numFirst <= graphs.size());
+	Matcher matcher(verbosity, logger, r, graphs, getIndexKey, onDerivation);
+	const auto numComponents = get_num_connected_components(get_labelled_left(r.getDPORule()));
+	std::vector<PartialMatch> partials(1), nextPartials;
+	partials.front().vertexMap.resize(num_vertices(get_graph(r.getDPORule())));
+	partials.front().componentMatched.resize(numComponents, false);
+	// each round binds one more educt, as bindGraphs does
+	for(std::size_t round = 0; round != numComponents && !partials.empty(); ++round) {
+		if(verbosity >= V_RuleApplication) {
+			logger.indent() << "Direct bind round " << (round + 1) << " with "
+			                << (round == 0 ? numFirst : graphs.size()) << " graphs and "
+			                << partials.size() << " partial matches." << std::endl;
+		}
+		const bool keepPartial = round + 1 != numComponents;
+		std::vector<const lib::Graph::Single *> educts;
+		for(const auto &m : partials) {
+			const std::size_t first = m.graphs.empty() ? 0 : m.graphs.back();
+			const std::size_t last = round == 0 ? numFirst : graphs.size();
+			if(!keepPartial && skipTried) {
+				educts.clear();
+				for(const auto gIdx : m.graphs)
+					educts.push_back(graphs[gIdx]);
+			}
+			for(std::size_t gIdx = first; gIdx < last; ++gIdx) {
+				if(!keepPartial && skipTried && skipTried(educts, graphs[gIdx])) {
+					if(verbosity >= V_RuleApplication_Binding)
+						logger.indent() << "Skipping " << graphs[gIdx]->getName() << ", already tried." << std::endl;
+					continue;
+				}
+				matcher.bind(m, gIdx, nextPartials, keepPartial);
+			}
+		}
+		std::swap(partials, nextPartials);
+		nextPartials.clear();
+	}
+}
+
+} // namespace mod::lib::DG
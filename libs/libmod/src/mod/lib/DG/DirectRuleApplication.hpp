@@ -0,0 +1,53 @@
+#ifndef MOD_LIB_DG_DIRECTRULEAPPLICATION_HPP
+#define MOD_LIB_DG_DIRECTRULEAPPLICATION_HPP
+
+#include <mod/lib/DG/RuleApplicationUtils.hpp>
+#include <mod/lib/IO/IO.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace mod::lib::DG {
+
+// Rule application where the left side of the rule is matched directly into the disjoint union of the educts,
+// instead of composing the rule with the bind rule of one educt at a time as with bindGraphs.
+// No intermediate rules are made: a partial match only records the educts and the images of the matched
+// left-side vertices, and the products are made directly from the educts and a complete match.
+// The matches are those the compositions would find:
+// - monomorphisms of the left side where each educt has at least one component mapped into it,
+// - which satisfy the dangling condition, i.e., each deleted vertex has no edges outside the match,
+// - and which do not create an edge parallel to an edge of an educt.
+// The multisets of educts are enumerated as by bindGraphs in the rule strategy,
+// i.e., as non-decreasing sequences of indices into the given graphs.
+// A multiset may give several derivations, and the same derivation may be found from several matches.
+// Matches which derive the same graph from the same educts are only reported once,
+// but matches which differ by a symmetry of the educts give isomorphic products,
+// so derivations must still be deduplicated as the ones from bindGraphs are.
+// The number of times a derivation is reported may therefore differ from bindGraphs,
+// and so may the order in which the derivations are found.
+
+// Whether applyDirectly supports the rule under the label settings,
+// i.e., string labels without stereo, and no match constraints.
+bool canApplyDirectly(const lib::Rules::Real &r, LabelSettings labelSettings);
+
+// Called for each derivation with the educts in binding order.
+// The products are made by makeProducts, with their keys from getIndexKey, so they can be skipped,
+// e.g., if a predicate rejects the derivation.
+using OnDirectDerivation = std::function<void(const std::vector<const lib::Graph::Single *> &educts,
+                                              const std::function<ProductCandidates()> &makeProducts)>;
+
+// Whether binding g after the given educts should be skipped, see applyDirectly.
+using SkipEduct = std::function<bool(const std::vector<const lib::Graph::Single *> &educts,
+                                     const lib::Graph::Single *g)>;
+
+// Finds the derivations of r for multisets of 'graphs' with at least one of the first numFirst graphs.
+// If skipTried is given, it is used when binding the last possible educt, as bindGraphs uses it in the last round.
+// pre: canApplyDirectly(r, labelSettings)
+void applyDirectly(int verbosity, IO::Logger logger, const lib::Rules::Real &r,
+                   const std::vector<const lib::Graph::Single *> &graphs, std::size_t numFirst,
+                   const GetIndexKey &getIndexKey, const SkipEduct &skipTried,
+                   const OnDirectDerivation &onDerivation);
+
+} // namespace mod::lib::DG
+
+#endif // MOD_LIB_DG_DIRECTRULEAPPLICATION_HPP
@@ -0,0 +1,557 @@
+#include "BinaryDump.hpp"
+
+#include <mod/Error.hpp>
+#include <mod/lib/DG/Hyper.hpp>
+#include <mod/lib/DG/NonHyper.hpp>
+#include <mod/lib/Graph/Single.hpp>
+#include <mod/lib/Graph/IO/Read.hpp>
+#include <mod/lib/Graph/IO/Write.hpp>
+#include <mod/lib/Graph/Properties/Stereo.hpp>
+#include <mod/lib/Graph/Properties/String.hpp>
+#include <mod/lib/IO/Config.hpp>
+#include <mod/lib/IO/IO.hpp>
+#include <mod/lib/Rules/Real.hpp>
+#include <mod/lib/Rules/IO/Write.hpp>
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace mod::lib::DG::BinaryDump {
+namespace {
+
+// File format, all integers in native byte order:
+//   header: "MODDGBIN", uint32 version,
+//           uint8 label type, uint8 label relation, uint8 with stereo, uint8 stereo relation,
+//           uint32 number of strings, vertices, rules, and edges,
+//           uint64 file offset of each of the sections below, in order
+//   string table: uint64 offsets[numStrings + 1] into the string data, followed by the string data
+//   vertices: for each vertex, uint32 id, uint32 string id of the graph name,
+//             uint64 offset of the graph relative to the start of the graph section
+//   graphs: for each graph, uint32 n, uint32 m, uint32 vertex label string ids[n],
+//           uint32 rowStart[n + 1], uint32 neighbours[2m], uint32 edge indices[2m],
+//           uint32 edge label string ids[m]
+//   rules: uint32 string id of the GML of each rule
+//   edges: uint32 ids[numEdges]
+//          uint32 sourceStart[numEdges + 1], uint32 sources[]
+//          uint32 targetStart[numEdges + 1], uint32 targets[]
+//          uint32 ruleStart[numEdges + 1], uint32 rule offsets[]
+// The vertex and edge ids are those of the JSON format, i.e., increasing and all distinct.
+// Edge i of a graph has the label eLabels[i], and it is listed in the rows of both its end points.
+constexpr char magic[] = {'M', 'O', 'D', 'D', 'G', 'B', 'I', 'N'};
+constexpr std::uint32_t version = 1;
+constexpr std::size_t numSections = 12;
+constexpr std::size_t headerSize = sizeof(magic) + 4 + 4 + 4 * 4 + numSections * 8;
+
+struct Writer {
+	std::uint32_t intern(const std::string &s) {
+		const auto iter = stringIds.find(s);
+		if(iter != stringIds.end()) return iter->second;
+		const std::uint32_t id = stringOffsets.size() - 1;
+		stringIds.emplace(s, id);
+		strings += s;
+		stringOffsets.push_back(strings.size());
+		return id;
+	}
+
+	void addVertex(std::uint32_t id, const std::string &name,
+	               const lib::Graph::GraphType &graph, const lib::Graph::PropString &str) {
+		appendInt(vertexData, id);
+		appendInt(vertexData, intern(name));
+		appendInt(vertexData, std::uint64_t(graphData.size()));
+
+		const std::uint32_t n = num_vertices(graph);
+		const std::uint32_t m = num_edges(graph);
+		appendInt(graphData, n);
+		appendInt(graphData, m);
+		for(const auto v : asRange(vertices(graph)))
+			appendInt(graphData, intern(str[v]));
+		std::uint32_t rowStart = 0;
+		appendInt(graphData, rowStart);
+		for(const auto v : asRange(vertices(graph))) {
+			rowStart += out_degree(v, graph);
+			appendInt(graphData, rowStart);
+		}
+		for(const auto v : asRange(vertices(graph)))
+			for(const auto e : asRange(out_edges(v, graph)))
+				appendInt(graphData, std::uint32_t(get(boost::vertex_index_t(), graph, target(e, graph))));
+		for(const auto v : asRange(vertices(graph)))
+			for(const auto e : asRange(out_edges(v, graph)))
+				appendInt(graphData, std::uint32_t(get(boost::edge_index_t(), graph, e)));
+		for(const auto e : asRange(edges(graph)))
+			appendInt(graphData, intern(str[e]));
+	}
+
+	void addRule(const std::string &gml) {
+		ruleStrings.push_back(intern(gml));
+	}
+
+	template<typename Sources, typename Targets, typename Rules>
+	void addEdge(std::uint32_t id, const Sources &srcs, const Targets &tars, const Rules &rules) {
+		edgeIds.push_back(id);
+		for(const auto src : srcs) sources.push_back(src);
+		sourceStart.push_back(sources.size());
+		for(const auto tar : tars) targets.push_back(tar);
+		targetStart.push_back(targets.size());
+		for(const auto r : rules) ruleIds.push_back(r);
+		ruleStart.push_back(ruleIds.size());
+	}
+
+	void write(const std::string &file, LabelSettings ls) const {
+		std::ofstream ofs(file, std::ios::binary);
+		if(!ofs) throw LogicError("Can not open file '" + file + "'.");
+		std::string header(magic, sizeof(magic));
+		appendInt(header, version);
+		header += char(ls.type);
+		header += char(ls.relation);
+		header += char(ls.withStereo);
+		header += char(ls.stereoRelation);
+		appendInt(header, std::uint32_t(stringOffsets.size() - 1));
+		appendInt(header, std::uint32_t(vertexData.size() / 16));
+		appendInt(header, std::uint32_t(ruleStrings.size()));
+		appendInt(header, std::uint32_t(edgeIds.size()));
+		const std::vector<std::uint64_t> sizes{
+				8 * stringOffsets.size(), strings.size(), vertexData.size(), graphData.size(),
+				4 * ruleStrings.size(), 4 * edgeIds.size(),
+				4 * sourceStart.size(), 4 * sources.size(),
+				4 * targetStart.size(), 4 * targets.size(),
+				4 * ruleStart.size(), 4 * ruleIds.size()
+		};
+		assert(sizes.size() == numSections);
+		std::uint64_t offset = headerSize;
+		for(const auto size : sizes) {
+			appendInt(header, offset);
+			offset += size;
+		}
+		assert(header.size() == headerSize);
+		ofs << header;
+		writeInts(ofs, stringOffsets);
+		ofs << strings << vertexData << graphData;
+		for(const auto *v : {&ruleStrings, &edgeIds, &sourceStart, &sources, &targetStart, &targets, &ruleStart, &ruleIds})
+			writeInts(ofs, *v);
+		if(!ofs) throw LogicError("Error while writing to file '" + file + "'.");
+	}
+private:
+	template<typename Int>
+	static void appendInt(std::string &s, Int i) {
+		s.append(reinterpret_cast<const char *>(&i), sizeof(i));
+	}
+
+	template<typename Int>
+	static void writeInts(std::ostream &s, const std::vector<Int> &v) {
+		s.write(reinterpret_cast<const char *>(v.data()), v.size() * sizeof(Int));
+	}
+private:
+	std::unordered_map<std::string, std::uint32_t> stringIds;
+	std::vector<std::uint64_t> stringOffsets{0};
+	std::string strings;
+	std::string vertexData, graphData;
+	std::vector<std::uint32_t> ruleStrings, edgeIds;
+	std::vector<std::uint32_t> sourceStart{0}, sources, targetStart{0}, targets, ruleStart{0}, ruleIds;
+};
+
+template<typename Int>
+Int readInt(const char *p) {
+	Int i;
+	std::memcpy(&i, p, sizeof(Int));
+	return i;
+}
+
+} // namespace
+
+bool isBinaryDump(const std::string &file) {
+	std::ifstream ifs(file, std::ios::binary);
+	char magicRead[sizeof(magic)];
+	if(!ifs.read(magicRead, sizeof(magic))) return false;
+	return std::memcmp(magicRead, magic, sizeof(magic)) == 0;
+}
+
+//------------------------------------------------------------------------------
+// View
+//------------------------------------------------------------------------------
+
+std::uint32_t View::Range::size() const {
+	return n;
+}
+
+std::uint32_t View::Range::operator[](std::uint32_t i) const {
+	assert(i < n);
+	return readInt<std::uint32_t>(first + 4 * i);
+}
+
+std::unique_ptr<View> View::open(const std::string &file, std::ostream &err) {
+	std::unique_ptr<View> view(new View());
+	try {
+		view->file.open(file);
+	} catch(const BOOST_IOSTREAMS_FAILURE &e) {
+		err << "Could not open file '" << file << "':\n" << e.what();
+		return {};
+	}
+	const char *data = view->file.data();
+	const std::uint64_t size = view->file.size();
+	if(size < headerSize || std::memcmp(data, magic, sizeof(magic)) != 0) {
+		err << "File '" << file << "' is not a binary DG dump.";
+		return {};
+	}
+	const char *p = data + sizeof(magic);
+	const auto versionRead = readInt<std::uint32_t>(p);
+	p += 4;
+	if(versionRead != version) {
+		err << "Binary DG dump '" << file << "' has version " << versionRead
+		    << ", but version " << version << " is required.";
+		return {};
+	}
+	{
+		const auto type = std::uint8_t(p[0]), relation = std::uint8_t(p[1]);
+		const auto withStereo = std::uint8_t(p[2]), stereoRelation = std::uint8_t(p[3]);
+		p += 4;
+		if(type > 1 || relation > 2 || withStereo > 1 || stereoRelation > 2) {
+			err << "Corrupt label settings in binary DG dump '" << file << "'.";
+			return {};
+		}
+		view->labelSettings = LabelSettings(LabelType(type), LabelRelation(relation), withStereo != 0,
+		                                    LabelRelation(stereoRelation));
+	}
+	for(auto *n : {&view->numStrings, &view->numVertices, &view->numRules, &view->numEdges}) {
+		*n = readInt<std::uint32_t>(p);
+		p += 4;
+	}
+	std::uint64_t *const offsets[] = {
+			&view->offStringOffsets, &view->offStrings, &view->offVertices, &view->offGraphs,
+			&view->offRules, &view->offEdgeIds,
+			&view->offSourceStart, &view->offSources,
+			&view->offTargetStart, &view->offTargets,
+			&view->offRuleStart, &view->offRuleIds
+	};
+	static_assert(std::size(offsets) == numSections);
+	std::uint64_t prev = headerSize;
+	for(auto *off : offsets) {
+		*off = readInt<std::uint64_t>(p);
+		p += 8;
+		if(*off < prev || *off > size) {
+			err << "Corrupt section table in binary DG dump '" << file << "'.";
+			return {};
+		}
+		prev = *off;
+	}
+	// check that each section has the size required by the counts
+	const auto sectionEnd = [&](std::size_t i) {
+		return i + 1 == numSections ? size : *offsets[i + 1];
+	};
+	const auto checkSection = [&](std::size_t i, std::uint64_t required) {
+		return sectionEnd(i) - *offsets[i] == required;
+	};
+	bool ok = checkSection(0, 8 * (std::uint64_t(view->numStrings) + 1))
+	          && checkSection(2, 16 * std::uint64_t(view->numVertices))
+	          && checkSection(4, 4 * std::uint64_t(view->numRules))
+	          && checkSection(5, 4 * std::uint64_t(view->numEdges))
+	          && checkSection(6, 4 * (std::uint64_t(view->numEdges) + 1))
+	          && checkSection(8, 4 * (std::uint64_t(view->numEdges) + 1))
+	          && checkSection(10, 4 * (std::uint64_t(view->numEdges) + 1));
+	if(ok) {
+		// the string table and the CSR offsets must be non-decreasing and end at the data size
+		const auto checkStarts = [&](std::uint64_t offStart, std::uint64_t count, std::uint64_t dataSize, auto at) {
+			if(at(offStart) != 0) return false;
+			for(std::uint64_t i = 0; i != count; ++i)
+				if(at(offStart + (i + 1) * sizeof(at(0))) < at(offStart + i * sizeof(at(0))))
+					return false;
+			return at(offStart + count * sizeof(at(0))) == dataSize;
+		};
+		ok = checkStarts(view->offStringOffsets, view->numStrings, sectionEnd(1) - view->offStrings,
+		                 [&](std::uint64_t off) { return readInt<std::uint64_t>(data + off); })
+		     && checkStarts(view->offSourceStart, view->numEdges, (sectionEnd(7) - view->offSources) / 4,
+		                    [&](std::uint64_t off) { return readInt<std::uint32_t>(data + off); })
+		     && checkStarts(view->offTargetStart, view->numEdges, (sectionEnd(9) - view->offTargets) / 4,
+		                    [&](std::uint64_t off) { return readInt<std::uint32_t>(data + off); })
+		     && checkStarts(view->offRuleStart, view->numEdges, (sectionEnd(11) - view->offRuleIds) / 4,
+		                    [&](std::uint64_t off) { return readInt<std::uint32_t>(data + off); });
+	}
+	if(ok) {
+		for(std::uint32_t i = 0; i != view->numVertices; ++i) {
+			if(view->getInt(view->offVertices + 16 * i + 4) >= view->numStrings
+			   || view->getInt64(view->offVertices + 16 * i + 8) >= view->offRules - view->offGraphs) {
+				ok = false;
+				break;
+			}
+		}
+		for(std::uint32_t i = 0; i != view->numRules; ++i)
+			if(view->getInt(view->offRules + 4 * i) >= view->numStrings)
+				ok = false;
+	}
+	if(!ok) {
+		err << "Corrupt data in binary DG dump '" << file << "'.";
+		return {};
+	}
+	return view;
+}
+
+View::~View() = default;
+
+LabelSettings View::getLabelSettings() const {
+	return labelSettings;
+}
+
+std::uint32_t View::getNumVertices() const {
+	return numVertices;
+}
+
+std::uint32_t View::getVertexId(std::uint32_t i) const {
+	assert(i < numVertices);
+	return getInt(offVertices + 16 * i);
+}
+
+std::string_view View::getVertexName(std::uint32_t i) const {
+	assert(i < numVertices);
+	return getString(getInt(offVertices + 16 * i + 4));
+}
+
+std::unique_ptr<lib::Graph::Single> View::makeVertexGraph(std::uint32_t i, std::ostream &err) const {
+	assert(i < numVertices);
+	const auto corrupt = [&]() {
+		err << "Corrupt graph data in binary DG dump, for graph '" << getVertexName(i)
+		    << "', in vertex " << getVertexId(i) << ".";
+		return nullptr;
+	};
+	const std::uint64_t offset = offGraphs + getInt64(offVertices + 16 * i + 8);
+	if(offRules - offset < 8) return corrupt();
+	const std::uint32_t n = getInt(offset);
+	const std::uint32_t m = getInt(offset + 4);
+	const std::uint64_t offVLabels = offset + 8;
+	const std::uint64_t offRowStart = offVLabels + 4 * std::uint64_t(n);
+	const std::uint64_t offAdj = offRowStart + 4 * (std::uint64_t(n) + 1);
+	const std::uint64_t offAdjEdge = offAdj + 8 * std::uint64_t(m);
+	const std::uint64_t offELabels = offAdjEdge + 8 * std::uint64_t(m);
+	if(offELabels + 4 * std::uint64_t(m) > offRules) return corrupt();
+	if(getInt(offRowStart) != 0 || getInt(offRowStart + 4 * std::uint64_t(n)) != 2 * m) return corrupt();
+
+	auto g = std::make_unique<lib::Graph::GraphType>();
+	auto pString = std::make_unique<lib::Graph::PropString>(*g);
+	for(std::uint32_t v = 0; v != n; ++v) {
+		const auto label = getInt(offVLabels + 4 * v);
+		if(label >= numStrings) return corrupt();
+		const auto vNew = add_vertex(*g);
+		pString->addVertex(vNew, InternedString(getString(label)));
+	}
+	// recover the end points of each edge from the two rows it is listed in
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> ends(m, {n, n});
+	std::vector<std::uint8_t> numSeen(m, 0);
+	for(std::uint32_t v = 0; v != n; ++v) {
+		const auto first = getInt(offRowStart + 4 * v), last = getInt(offRowStart + 4 * (v + 1));
+		if(last < first || last > 2 * m) return corrupt();
+		for(std::uint32_t k = first; k != last; ++k) {
+			const auto u = getInt(offAdj + 4 * std::uint64_t(k));
+			const auto e = getInt(offAdjEdge + 4 * std::uint64_t(k));
+			if(u >= n || u == v || e >= m) return corrupt();
+			if(numSeen[e] == 0) ends[e] = {v, u};
+			else if(numSeen[e] != 1 || ends[e] != std::make_pair(u, v)) return corrupt();
+			++numSeen[e];
+		}
+	}
+	for(std::uint32_t e = 0; e != m; ++e) {
+		if(numSeen[e] != 2) return corrupt();
+		const auto label = getInt(offELabels + 4 * e);
+		if(label >= numStrings) return corrupt();
+		const auto vSrc = vertex(ends[e].first, *g);
+		const auto vTar = vertex(ends[e].second, *g);
+		if(edge(vSrc, vTar, *g).second) return corrupt();
+		const auto eNew = add_edge(vSrc, vTar, *g);
+		pString->addEdge(eNew.first, InternedString(getString(label)));
+	}
+	return std::make_unique<lib::Graph::Single>(std::move(g), std::move(pString), nullptr);
+}
+
+std::uint32_t View::getNumRules() const {
+	return numRules;
+}
+
+std::string_view View::getRuleGML(std::uint32_t i) const {
+	assert(i < numRules);
+	return getString(getInt(offRules + 4 * i));
+}
+
+std::uint32_t View::getNumEdges() const {
+	return numEdges;
+}
+
+std::uint32_t View::getEdgeId(std::uint32_t i) const {
+	assert(i < numEdges);
+	return getInt(offEdgeIds + 4 * i);
+}
+
+View::Range View::getEdgeSources(std::uint32_t i) const {
+	return getCSRRange(offSourceStart, offSources, i);
+}
+
+View::Range View::getEdgeTargets(std::uint32_t i) const {
+	return getCSRRange(offTargetStart, offTargets, i);
+}
+
+View::Range View::getEdgeRules(std::uint32_t i) const {
+	return getCSRRange(offRuleStart, offRuleIds, i);
+}
+
+std::string_view View::getString(std::uint32_t id) const {
+	assert(id < numStrings);
+	const auto first = getInt64(offStringOffsets + 8 * std::uint64_t(id));
+	const auto last = getInt64(offStringOffsets + 8 * (std::uint64_t(id) + 1));
+	return std::string_view(file.data() + offStrings + first, last - first);
+}
+
+View::Range View::getCSRRange(std::uint64_t offStart, std::uint64_t offData, std::uint32_t i) const {
+	assert(i < numEdges);
+	const auto first = getInt(offStart + 4 * std::uint64_t(i));
+	const auto last = getInt(offStart + 4 * (std::uint64_t(i) + 1));
+	return Range(file.data() + offData + 4 * std::uint64_t(first), last - first);
+}
+
+std::uint32_t View::getInt(std::uint64_t offset) const {
+	assert(offset + 4 <= file.size());
+	return readInt<std::uint32_t>(file.data() + offset);
+}
+
+std::uint64_t View::getInt64(std::uint64_t offset) const {
+	assert(offset + 8 <= file.size());
+	return readInt<std::uint64_t>(file.data() + offset);
+}
+
+//------------------------------------------------------------------------------
+// Writing and conversion
+//------------------------------------------------------------------------------
+
+void write(const NonHyper &dgNonHyper, const std::string &file) {
+	if(dgNonHyper.getLabelSettings().withStereo)
+		throw mod::LogicError("Can not yet dump DGs with stereo data.");
+
+	using VertexKind = HyperVertexKind;
+	const auto &dgHyper = dgNonHyper.getHyper();
+	const auto &dg = dgHyper.getGraph();
+
+	Writer w;
+	for(const auto v : asRange(vertices(dg))) {
+		if(dg[v].kind != VertexKind::Vertex) continue;
+		const lib::Graph::Single *g = dg[v].graph;
+		assert(g);
+		w.addVertex(get(boost::vertex_index_t(), dg, v), g->getName(), g->getGraph(), g->getStringState());
+	}
+
+	std::set<const lib::Rules::Real *, lib::Rules::LessById> rules;
+	for(const auto v : asRange(vertices(dg))) {
+		if(dg[v].kind != VertexKind::Edge) continue;
+		for(const auto *r : dgHyper.getRulesFromEdge(v))
+			rules.insert(r);
+	}
+	std::unordered_map<const lib::Rules::Real *, std::uint32_t> idFromRule;
+	for(const auto *r : rules) {
+		std::ostringstream ss;
+		Rules::Write::gml(*r, false, ss);
+		idFromRule.emplace(r, idFromRule.size());
+		w.addRule(ss.str());
+	}
+
+	std::vector<std::uint32_t> srcs, tars, ruleIds;
+	for(const auto v : asRange(vertices(dg))) {
+		if(dg[v].kind != VertexKind::Edge) continue;
+		srcs.clear();
+		tars.clear();
+		ruleIds.clear();
+		for(const auto e : asRange(in_edges(v, dg)))
+			srcs.push_back(get(boost::vertex_index_t(), dg, source(e, dg)));
+		for(const auto e : asRange(out_edges(v, dg)))
+			tars.push_back(get(boost::vertex_index_t(), dg, target(e, dg)));
+		for(const auto *r : dgHyper.getRulesFromEdge(v)) {
+			const auto iter = idFromRule.find(r);
+			assert(iter != end(idFromRule));
+			ruleIds.push_back(iter->second);
+		}
+		w.addEdge(get(boost::vertex_index_t(), dg, v), srcs, tars, ruleIds);
+	}
+	w.write(file, dgNonHyper.getLabelSettings());
+}
+
+bool fromJson(const nlohmann::json &j, const std::string &file, std::ostream &err) {
+	const LabelSettings ls = from_json(j["labelSettings"]);
+	if(ls.withStereo) {
+		err << "Can not yet convert DG dumps with stereo data.";
+		return false;
+	}
+	Writer w;
+	for(const auto &jv : j["vertices"]) {
+		const int id = jv[0].get<int>();
+		const auto &name = jv[1].get<std::string>();
+		lib::IO::Warnings warnings;
+		auto gDatasRes = lib::Graph::Read::gml(warnings, jv[2].get<std::string>());
+		err << warnings;
+		if(!gDatasRes) {
+			err << gDatasRes.extractError() << '\n';
+			err << "Error when loading graph GML in DG dump, for graph '" << name << "', in vertex " << id << ".";
+			return false;
+		}
+		auto gDatas = std::move(*gDatasRes);
+		if(gDatas.size() != 1) {
+			err << "Loaded graph has multiple connected components (" << gDatas.size() << "). ";
+			err << "Error when loading graph GML in DG dump, for graph '" << name << "', in vertex " << id << ".";
+			return false;
+		}
+		w.addVertex(id, name, *gDatas.front().g, *gDatas.front().pString);
+	}
+	if(j.contains("rules")) {
+		for(const auto &jr : j["rules"])
+			w.addRule(jr.get<std::string>());
+	}
+	if(j.contains("edges")) {
+		std::vector<std::uint32_t> ruleIds;
+		for(const auto &je : j["edges"]) {
+			ruleIds.clear();
+			if(je.size() > 3) {
+				for(const auto &jr : je[3])
+					ruleIds.push_back(jr.get<std::uint32_t>());
+			}
+			w.addEdge(je[0].get<std::uint32_t>(), je[1].get<std::vector<std::uint32_t>>(),
+			          je[2].get<std::vector<std::uint32_t>>(), ruleIds);
+		}
+	}
+	w.write(file, ls);
+	return true;
+}
+
+std::optional<nlohmann::json> toJson(const View &view, std::ostream &err) {
+	nlohmann::json j;
+	j["version"] = 3;
+	j["labelSettings"] = view.getLabelSettings();
+
+	auto jVertices = nlohmann::json::array();
+	for(std::uint32_t i = 0; i != view.getNumVertices(); ++i) {
+		const auto g = view.makeVertexGraph(i, err);
+		if(!g) return {};
+		std::ostringstream ss;
+		lib::Graph::Write::gml(*g, false, ss);
+		jVertices.push_back(nlohmann::json::array({view.getVertexId(i), std::string(view.getVertexName(i)), ss.str()}));
+	}
+	j["vertices"] = std::move(jVertices);
+
+	auto jRules = nlohmann::json::array();
+	for(std::uint32_t i = 0; i != view.getNumRules(); ++i)
+		jRules.push_back(std::string(view.getRuleGML(i)));
+	j["rules"] = std::move(jRules);
+
+	const auto toArray = [](View::Range r) {
+		auto a = nlohmann::json::array();
+		for(std::uint32_t k = 0; k != r.size(); ++k)
+			a.push_back(r[k]);
+		return a;
+	};
+	auto jEdges = nlohmann::json::array();
+	for(std::uint32_t i = 0; i != view.getNumEdges(); ++i) {
+		jEdges.push_back(nlohmann::json::array({view.getEdgeId(i), toArray(view.getEdgeSources(i)),
+		                                        toArray(view.getEdgeTargets(i)), toArray(view.getEdgeRules(i))}));
+	}
+	j["edges"] = std::move(jEdges);
+	return j;
+}
+
+} // namespace mod::lib::DG::BinaryDump
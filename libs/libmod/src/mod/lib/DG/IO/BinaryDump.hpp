@@ -0,0 +1,90 @@
+#ifndef MOD_LIB_DG_IO_BINARYDUMP_HPP
+#define MOD_LIB_DG_IO_BINARYDUMP_HPP
+
+#include <mod/Config.hpp>
+#include <mod/lib/IO/Json.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mod::lib::Graph {
+struct Single;
+} // namespace mod::lib::Graph
+namespace mod::lib::DG {
+struct NonHyper;
+} // namespace mod::lib::DG
+namespace mod::lib::DG::BinaryDump {
+
+// A binary alternative to the JSON dump (see Write::dumpToJson), with the same content:
+// the label settings, the vertices with graph names and graphs, the rules as GML, and the hyperedges.
+// All strings are stored once in a string table, graphs are stored in CSR form, and so are the
+// sources, targets, and rules of the hyperedges.
+// A dump is read through a View of the memory mapped file, and graphs are only constructed on request.
+// Note that loading a dump into a DG requests every graph, as each is checked against the graph database,
+// so there the savings are in the parsing and in the memory for the file content.
+
+// Whether the file starts with the magic bytes of a binary dump.
+bool isBinaryDump(const std::string &file);
+
+struct View {
+	// A view of a list of integers in the mapped file.
+	struct Range {
+		Range(const char *first, std::uint32_t n) : first(first), n(n) {}
+		std::uint32_t size() const;
+		std::uint32_t operator[](std::uint32_t i) const;
+	private:
+		const char *first;
+		std::uint32_t n;
+	};
+public:
+	// Returns nullptr if the file can not be opened or is not a valid binary dump, with a message in err.
+	static std::unique_ptr<View> open(const std::string &file, std::ostream &err);
+	~View();
+	LabelSettings getLabelSettings() const;
+	std::uint32_t getNumVertices() const;
+	std::uint32_t getVertexId(std::uint32_t i) const;
+	std::string_view getVertexName(std::uint32_t i) const;
+	// Returns nullptr if the graph data is corrupt, with a message in err.
+	// The name of the graph is not set.
+	std::unique_ptr<lib::Graph::Single> makeVertexGraph(std::uint32_t i, std::ostream &err) const;
+	std::uint32_t getNumRules() const;
+	std::string_view getRuleGML(std::uint32_t i) const;
+	std::uint32_t getNumEdges() const;
+	std::uint32_t getEdgeId(std::uint32_t i) const;
+	Range getEdgeSources(std::uint32_t i) const;
+	Range getEdgeTargets(std::uint32_t i) const;
+	Range getEdgeRules(std::uint32_t i) const;
+private:
+	View() = default;
+	std::string_view getString(std::uint32_t id) const;
+	Range getCSRRange(std::uint64_t offStart, std::uint64_t offData, std::uint32_t i) const;
+	std::uint32_t getInt(std::uint64_t offset) const;
+	std::uint64_t getInt64(std::uint64_t offset) const;
+private:
+	boost::iostreams::mapped_file_source file;
+	LabelSettings labelSettings{LabelType::String, LabelRelation::Isomorphism};
+	std::uint32_t numStrings, numVertices, numRules, numEdges;
+	std::uint64_t offStringOffsets, offStrings, offVertices, offGraphs, offRules, offEdgeIds;
+	std::uint64_t offSourceStart, offSources, offTargetStart, offTargets, offRuleStart, offRuleIds;
+};
+
+// Writes a binary dump of dg.
+// Throws LogicError if the file can not be opened, or if the DG has stereo data.
+void write(const NonHyper &dg, const std::string &file);
+
+// Converts between the JSON representation (see Write::dumpToJson and Read::loadDump) and the binary format.
+// The JSON data must have been validated by Read::loadDump.
+// On invalid input data, fromJson returns false and toJson returns an empty optional, with a message in err.
+// Throws LogicError if the output file can not be opened.
+bool fromJson(const nlohmann::json &j, const std::string &file, std::ostream &err);
+std::optional<nlohmann::json> toJson(const View &view, std::ostream &err);
+
+} // namespace mod::lib::DG::BinaryDump
+
+#endif // MOD_LIB_DG_IO_BINARYDUMP_HPP
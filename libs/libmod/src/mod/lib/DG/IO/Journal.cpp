@@ -0,0 +1,297 @@
+#include "Journal.hpp"
+
+#include <mod/Error.hpp>
+#include <mod/lib/Graph/Single.hpp>
+#include <mod/lib/Graph/IO/Write.hpp>
+#include <mod/lib/IO/Config.hpp>
+#include <mod/lib/Rules/Real.hpp>
+#include <mod/lib/Rules/IO/Write.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mod::lib::DG::Journal {
+namespace {
+
+// File format, all integers in native byte order:
+//   header: "MODDGLOG", uint32 version,
+//           uint8 label type, uint8 label relation, uint8 with stereo, uint8 stereo relation
+//   records: uint8 kind, followed by
+//     'V', a vertex: uint32 id, string graph name, string graph GML
+//     'R', a rule, with the next rule offset: string rule GML
+//     'E', a hyperedge: uint32 id, uint32 n, n uint32 source ids, uint32 m, m uint32 target ids,
+//          uint32 k, k uint32 rule offsets
+//     'A', an additional rule for a hyperedge: uint32 id, uint32 rule offset
+//   where a string is a uint32 length followed by the characters.
+// Each rule is written before the first record using it.
+constexpr char magic[] = {'M', 'O', 'D', 'D', 'G', 'L', 'O', 'G'};
+constexpr std::uint32_t version = 1;
+constexpr std::size_t flushSize = 1 << 16;
+
+struct Reader {
+	Reader(const char *first, const char *last) : first(first), last(last) {}
+
+	bool read(std::uint8_t &i) {
+		if(first == last) return false;
+		i = *first;
+		++first;
+		return true;
+	}
+
+	bool read(std::uint32_t &i) {
+		if(last - first < 4) return false;
+		std::memcpy(&i, first, 4);
+		first += 4;
+		return true;
+	}
+
+	bool read(std::string &s) {
+		std::uint32_t size;
+		if(!read(size)) return false;
+		if(static_cast<std::size_t>(last - first) < size) return false;
+		s.assign(first, first + size);
+		first += size;
+		return true;
+	}
+
+	bool read(std::vector<std::uint32_t> &v) {
+		std::uint32_t size;
+		if(!read(size)) return false;
+		if(static_cast<std::size_t>(last - first) / 4 < size) return false;
+		v.resize(size);
+		for(auto &i : v) read(i);
+		return true;
+	}
+public:
+	const char *first;
+	const char *const last;
+};
+
+} // namespace
+
+Writer::Writer(const std::string &file, LabelSettings labelSettings) : file(file) {
+	fd = ::open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if(fd == -1) throw LogicError("Can not open file '" + file + "'.");
+	buffer.append(magic, sizeof(magic));
+	appendInt(version);
+	buffer += char(labelSettings.type);
+	buffer += char(labelSettings.relation);
+	buffer += char(labelSettings.withStereo);
+	buffer += char(labelSettings.stereoRelation);
+	lastFlush = lastSync = std::chrono::steady_clock::now();
+	sync();
+}
+
+Writer::~Writer() {
+	try {
+		sync();
+	} catch(const LogicError &e) {
+		std::cout << "WARNING: " << e.what() << std::endl;
+	}
+	::close(fd);
+}
+
+void Writer::addVertex(std::size_t id, const lib::Graph::Single &g) {
+	std::ostringstream ss;
+	lib::Graph::Write::gml(g, false, ss);
+	buffer += 'V';
+	appendInt(id);
+	appendString(g.getName());
+	appendString(ss.str());
+	endRecord();
+}
+
+void Writer::addEdge(std::size_t id, const std::vector<std::size_t> &sources, const std::vector<std::size_t> &targets,
+                     const std::vector<const lib::Rules::Real *> &rules) {
+	std::vector<std::uint32_t> rIds;
+	rIds.reserve(rules.size());
+	for(const auto *r : rules)
+		rIds.push_back(getRuleId(*r));
+	buffer += 'E';
+	appendInt(id);
+	appendInt(sources.size());
+	for(const auto src : sources) appendInt(src);
+	appendInt(targets.size());
+	for(const auto tar : targets) appendInt(tar);
+	appendInt(rIds.size());
+	for(const auto rId : rIds) appendInt(rId);
+	endRecord();
+}
+
+void Writer::addRuleToEdge(std::size_t id, const lib::Rules::Real &r) {
+	const auto rId = getRuleId(r);
+	buffer += 'A';
+	appendInt(id);
+	appendInt(rId);
+	endRecord();
+}
+
+void Writer::sync() {
+	flush();
+	if(::fsync(fd) != 0)
+		throw LogicError("Error while syncing journal file '" + file + "': " + std::strerror(errno));
+	lastSync = std::chrono::steady_clock::now();
+}
+
+std::uint32_t Writer::getRuleId(const lib::Rules::Real &r) {
+	const auto iter = ruleIds.find(&r);
+	if(iter != ruleIds.end()) return iter->second;
+	const std::uint32_t rId = ruleIds.size();
+	ruleIds.emplace(&r, rId);
+	std::ostringstream ss;
+	lib::Rules::Write::gml(r, false, ss);
+	buffer += 'R';
+	appendString(ss.str());
+	return rId;
+}
+
+void Writer::appendInt(std::uint32_t i) {
+	buffer.append(reinterpret_cast<const char *>(&i), sizeof(i));
+}
+
+void Writer::appendString(const std::string &s) {
+	appendInt(s.size());
+	buffer += s;
+}
+
+void Writer::endRecord() {
+	const auto now = std::chrono::steady_clock::now();
+	if(now - lastSync >= std::chrono::seconds(getConfig().dg.journalSyncInterval.get()))
+		sync();
+	else if(buffer.size() >= flushSize || now - lastFlush >= std::chrono::seconds(1))
+		flush();
+}
+
+void Writer::flush() {
+	std::size_t written = 0;
+	while(written != buffer.size()) {
+		const auto res = ::write(fd, buffer.data() + written, buffer.size() - written);
+		if(res == -1) {
+			if(errno == EINTR) continue;
+			throw LogicError("Error while writing to journal file '" + file + "': " + std::strerror(errno));
+		}
+		written += res;
+	}
+	buffer.clear();
+	lastFlush = std::chrono::steady_clock::now();
+}
+
+//------------------------------------------------------------------------------
+
+bool isJournal(const std::string &file) {
+	std::ifstream ifs(file, std::ios::binary);
+	char magicRead[sizeof(magic)];
+	if(!ifs.read(magicRead, sizeof(magic))) return false;
+	return std::memcmp(magicRead, magic, sizeof(magic)) == 0;
+}
+
+std::optional<nlohmann::json> loadAsDump(const std::string &file, std::ostream &err) {
+	boost::iostreams::mapped_file_source ifs;
+	try {
+		ifs.open(file);
+	} catch(const BOOST_IOSTREAMS_FAILURE &e) {
+		err << "Could not open file '" << file << "':\n" << e.what();
+		return {};
+	}
+	Reader r(ifs.data(), ifs.data() + ifs.size());
+	if(ifs.size() < sizeof(magic) + 8 || std::memcmp(r.first, magic, sizeof(magic)) != 0) {
+		err << "File '" << file << "' is not a DG journal.";
+		return {};
+	}
+	r.first += sizeof(magic);
+	std::uint32_t versionRead;
+	r.read(versionRead);
+	if(versionRead != version) {
+		err << "DG journal '" << file << "' has version " << versionRead
+		    << ", but version " << version << " is required.";
+		return {};
+	}
+	std::uint8_t type, relation, withStereo, stereoRelation;
+	r.read(type);
+	r.read(relation);
+	r.read(withStereo);
+	r.read(stereoRelation);
+	if(type > 1 || relation > 2 || withStereo > 1 || stereoRelation > 2) {
+		err << "Corrupt label settings in DG journal '" << file << "'.";
+		return {};
+	}
+
+	nlohmann::json j;
+	j["version"] = 3;
+	j["labelSettings"] = LabelSettings(LabelType(type), LabelRelation(relation), withStereo != 0,
+	                                   LabelRelation(stereoRelation));
+	auto jVertices = nlohmann::json::array();
+	auto jRules = nlohmann::json::array();
+	auto jEdges = nlohmann::json::array();
+	std::unordered_map<std::uint32_t, std::size_t> edgeFromId;
+	const auto corrupt = [&](const char *msg) {
+		err << "Corrupt data in DG journal '" << file << "' at offset " << (r.first - ifs.data()) << ". " << msg;
+		return std::nullopt;
+	};
+	while(r.first != r.last) {
+		const char *recordStart = r.first;
+		std::uint8_t kind;
+		r.read(kind);
+		bool complete = true;
+		switch(kind) {
+		case 'V': {
+			std::uint32_t id;
+			std::string name, gml;
+			complete = r.read(id) && r.read(name) && r.read(gml);
+			if(complete)
+				jVertices.push_back(nlohmann::json::array({id, std::move(name), std::move(gml)}));
+			break;
+		}
+		case 'R': {
+			std::string gml;
+			complete = r.read(gml);
+			if(complete) jRules.push_back(std::move(gml));
+			break;
+		}
+		case 'E': {
+			std::uint32_t id;
+			std::vector<std::uint32_t> srcs, tars, rIds;
+			complete = r.read(id) && r.read(srcs) && r.read(tars) && r.read(rIds);
+			if(!complete) break;
+			for(const auto rId : rIds)
+				if(rId >= jRules.size()) return corrupt("Rule offset out of range.");
+			if(!edgeFromId.emplace(id, jEdges.size()).second) return corrupt("Duplicate hyperedge.");
+			jEdges.push_back(nlohmann::json::array({id, srcs, tars, rIds}));
+			break;
+		}
+		case 'A': {
+			std::uint32_t id, rId;
+			complete = r.read(id) && r.read(rId);
+			if(!complete) break;
+			const auto iter = edgeFromId.find(id);
+			if(iter == edgeFromId.end()) return corrupt("Unknown hyperedge.");
+			if(rId >= jRules.size()) return corrupt("Rule offset out of range.");
+			jEdges[iter->second][3].push_back(rId);
+			break;
+		}
+		default:
+			r.first = recordStart;
+			return corrupt("Unknown record type.");
+		}
+		if(!complete) {
+			std::cout << "WARNING: the DG journal '" << file << "' ends with a truncated record, which is ignored."
+			          << std::endl;
+			break;
+		}
+	}
+	j["vertices"] = std::move(jVertices);
+	j["rules"] = std::move(jRules);
+	j["edges"] = std::move(jEdges);
+	return j;
+}
+
+} // namespace mod::lib::DG::Journal
@@ -0,0 +1,67 @@
+#ifndef MOD_LIB_DG_IO_JOURNAL_HPP
+#define MOD_LIB_DG_IO_JOURNAL_HPP
+
+#include <mod/Config.hpp>
+#include <mod/lib/IO/Json.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mod::lib::Graph {
+struct Single;
+} // namespace mod::lib::Graph
+namespace mod::lib::Rules {
+struct Real;
+} // namespace mod::lib::Rules
+namespace mod::lib::DG::Journal {
+
+// A journal is an append-only log of the vertices and hyperedges of a DG, in the order they are created.
+// It is written while the DG is being built, so that the DG can be recovered if the program is terminated
+// before the DG can be dumped.
+// The ids are those of the vertices and hyperedges in the DG, as in the dump formats.
+
+struct Writer {
+	// Throws LogicError if the file can not be opened.
+	Writer(const std::string &file, LabelSettings labelSettings);
+	Writer(const Writer &) = delete;
+	Writer &operator=(const Writer &) = delete;
+	// Writes the remaining records and syncs the file.
+	~Writer();
+	void addVertex(std::size_t id, const lib::Graph::Single &g);
+	void addEdge(std::size_t id, const std::vector<std::size_t> &sources, const std::vector<std::size_t> &targets,
+	             const std::vector<const lib::Rules::Real *> &rules);
+	void addRuleToEdge(std::size_t id, const lib::Rules::Real &r);
+	// Writes all records to the file and waits for them to reach the disk.
+	void sync();
+private:
+	std::uint32_t getRuleId(const lib::Rules::Real &r);
+	void appendInt(std::uint32_t i);
+	void appendString(const std::string &s);
+	// Called after each record. Hands the buffered records to the OS at least once per second,
+	// and syncs the file every config.dg.journalSyncInterval seconds.
+	void endRecord();
+	void flush();
+private:
+	const std::string file;
+	int fd;
+	std::string buffer;
+	std::unordered_map<const lib::Rules::Real *, std::uint32_t> ruleIds;
+	std::chrono::steady_clock::time_point lastFlush, lastSync;
+};
+
+// Whether the file starts with the magic bytes of a journal.
+bool isJournal(const std::string &file);
+// Replays the journal into the JSON representation of a dump, as returned by Read::loadDump.
+// A truncated last record, e.g., from a process being killed, is ignored with a warning.
+// Returns an empty optional, with a message in err, if the file can not be opened or is corrupt.
+std::optional<nlohmann::json> loadAsDump(const std::string &file, std::ostream &err);
+
+} // namespace mod::lib::DG::Journal
+
+#endif // MOD_LIB_DG_IO_JOURNAL_HPP
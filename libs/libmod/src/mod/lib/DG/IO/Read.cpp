@@ -7,6 +7,8 @@
 #include <mod/rule/Rule.hpp>
 #include <mod/lib/DG/Dump.hpp>
 #include <mod/lib/DG/NonHyperBuilder.hpp>
+#include <mod/lib/DG/IO/BinaryDump.hpp>
+#include <mod/lib/DG/IO/Journal.hpp>
 #include <mod/lib/Graph/Single.hpp>
 #include <mod/lib/Graph/Properties/Stereo.hpp>
 #include <mod/lib/Graph/Properties/String.hpp>
@@ -126,8 +128,20 @@ std::unique_ptr<NonHyper> dump(const std::vector<std::shared_ptr<graph::Graph>>
 		ifs.close();
 		return Dump::load(graphDatabase, ruleDatabase, file, err);
 	}
+	if(BinaryDump::isBinaryDump(file)) {
+		ifs.close();
+		const auto view = BinaryDump::View::open(file, err);
+		if(!view) return {};
+		auto dgInternal = std::make_unique<NonHyperBuilder>(view->getLabelSettings(), graphDatabase, graphPolicy);
+		{ // construction
+			auto b = dgInternal->build();
+			auto res = b.trustLoadDump(*view, ruleDatabase, err, verbosity);
+			if(!res) return {};
+		}
+		return std::unique_ptr<NonHyper>(dgInternal.release());
+	}
 	ifs.close();
-	auto jOpt = loadDump(file, err);
+	auto jOpt = Journal::isJournal(file) ? Journal::loadAsDump(file, err) : loadDump(file, err);
 	if(!jOpt) return {};
 	auto &j = *jOpt;
 
@@ -13,6 +13,7 @@
 #include <mod/rule/Rule.hpp>
 #include <mod/lib/Chem/MoleculeUtil.hpp>
 #include <mod/lib/DG/Hyper.hpp>
+#include <mod/lib/DG/IO/Journal.hpp>
 #include <mod/lib/DG/IO/Write.hpp>
 #include <mod/lib/Graph/Single.hpp>
 #include <mod/lib/Graph/Properties/Molecule.hpp>
@@ -26,12 +27,14 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <unordered_set>
 
 namespace mod::lib::DG {
 namespace {
-std::size_t nextDGNum = 0;
+std::atomic<std::size_t> nextDGNum(0);
 } // namespace
 
 NonHyper::NonHyper(LabelSettings labelSettings,
@@ -114,6 +117,7 @@ void NonHyper::calculateEpilogue() {
 	// annotate the graph with reversible pairs
 	findReversiblePairs();
 	hyperCreator.reset();
+	journal.reset();
 	hasCalculated = true;
 }
 
@@ -156,15 +160,30 @@ bool NonHyper::trustAddGraphAsVertex(std::shared_ptr<graph::Graph> g) {
 
 std::pair<std::shared_ptr<graph::Graph>, std::unique_ptr<lib::Graph::Single>>
 NonHyper::checkIfNew(std::unique_ptr<lib::Graph::Single> gCand) const {
+	assert(gCand);
+	const auto indexKey = getGraphIndexKey(*gCand);
+	return checkIfNew(std::move(gCand), indexKey);
+}
+
+std::pair<std::shared_ptr<graph::Graph>, std::unique_ptr<lib::Graph::Single>>
+NonHyper::checkIfNew(std::unique_ptr<lib::Graph::Single> gCand, std::size_t indexKey) const {
 	assert(gCand);
 	{
-		const auto g = graphDatabase.findIsomorphic(gCand.get());
+		const auto g = graphDatabase.findIsomorphic(gCand.get(), indexKey);
 		if(g) return {g, std::move(gCand)};
 	}
 	auto g = graph::Graph::create(std::move(gCand));
 	return {g, nullptr};
 }
 
+std::size_t NonHyper::getGraphIndexKey(const lib::Graph::Single &g) const {
+	return graphDatabase.getIndexKey(&g);
+}
+
+void NonHyper::prepareForConcurrentCheckIfNew() {
+	graphDatabase.prepareForConcurrentLookup();
+}
+
 bool NonHyper::addProduct(std::shared_ptr<graph::Graph> g) {
 	assert(g);
 	const bool isNewGraph = trustAddGraph(g);
@@ -188,6 +207,19 @@ std::pair<NonHyper::Edge, bool> NonHyper::isDerivation(const GraphMultiset &gmsS
 	return edge(iterLeft->second, iterRight->second, dg);
 }
 
+std::vector<GraphMultiset> NonHyper::findDerivationTargets(const GraphMultiset &gmsSrc,
+                                                           const lib::Rules::Real *r) const {
+	std::vector<GraphMultiset> res;
+	const auto iterLeft = multisetToVertex.find(gmsSrc);
+	if(iterLeft == end(multisetToVertex)) return res;
+	for(const auto e : asRange(out_edges(iterLeft->second, dg))) {
+		const auto &rules = dg[e].rules;
+		if(std::find(begin(rules), end(rules), r) != end(rules))
+			res.push_back(dg[target(e, dg)].graphs);
+	}
+	return res;
+}
+
 std::pair<NonHyper::Edge, bool> NonHyper::suggestDerivation(
 		const GraphMultiset &gmsSrc, const GraphMultiset &gmsTar, const lib::Rules::Real *r) {
 	assert(!gmsSrc.empty());
@@ -199,13 +231,16 @@ std::pair<NonHyper::Edge, bool> NonHyper::suggestDerivation(
 		e = add_edge(vSrc, vTar, dg);
 		if(r) dg[e.first].rules.push_back(r);
 		dg[e.first].hyper = hyperCreator->addEdge(e.first);
+		if(journal) journalEdge(dg[e.first].hyper);
 	} else {
 		e.second = false;
 		if(r) {
 			auto &rules = dg[e.first].rules;
 			auto iter = std::find(rules.begin(), rules.end(), r);
-			if(iter == rules.end())
+			if(iter == rules.end()) {
 				rules.push_back(r);
+				if(journal) journal->addRuleToEdge(dg[e.first].hyper, *r);
+			}
 		}
 	}
 	return e;
@@ -222,10 +257,38 @@ NonHyper::Vertex NonHyper::getVertex(const GraphMultiset &gms) {
 	Vertex v = add_vertex(dg);
 	dg[v].graphs = gms;
 	multisetToVertex[gms] = v;
-	for(auto *gSub : gms) hyperCreator->addVertex(gSub);
+	for(auto *gSub : gms) {
+		const bool isNew = journal && !hyper->isVertexGraph(gSub);
+		hyperCreator->addVertex(gSub);
+		if(isNew) journal->addVertex(hyper->getVertexFromGraph(gSub), *gSub);
+	}
 	return v;
 }
 
+void NonHyper::startJournal(std::unique_ptr<Journal::Writer> journal) {
+	assert(hyperCreator);
+	assert(journal);
+	this->journal = std::move(journal);
+	const auto &dgHyper = hyper->getGraph();
+	for(const auto v : asRange(vertices(dgHyper))) {
+		if(dgHyper[v].kind == HyperVertexKind::Vertex)
+			this->journal->addVertex(v, *dgHyper[v].graph);
+		else
+			journalEdge(v);
+	}
+	this->journal->sync();
+}
+
+void NonHyper::journalEdge(HyperVertex v) {
+	const auto &dgHyper = hyper->getGraph();
+	std::vector<std::size_t> sources, targets;
+	for(const auto e : asRange(in_edges(v, dgHyper)))
+		sources.push_back(source(e, dgHyper));
+	for(const auto e : asRange(out_edges(v, dgHyper)))
+		targets.push_back(target(e, dgHyper));
+	journal->addEdge(v, sources, targets, dg[dgHyper[v].edge].rules);
+}
+
 void NonHyper::findReversiblePairs() {
 	for(Edge e : asRange(edges(dg))) {
 		Vertex vSource = source(e, dg);
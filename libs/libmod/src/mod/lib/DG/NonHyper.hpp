@@ -23,6 +23,9 @@ struct PropString;
 } // namespace mod::lib::Graph
 namespace mod::lib::DG {
 struct HyperCreator;
+namespace Journal {
+struct Writer;
+} // namespace Journal
 
 struct NonHyper {
 	friend struct HyperCreator;
@@ -73,6 +76,15 @@ protected: // calculation
 	// Does NOT change the graphDatabse.
 	std::pair<std::shared_ptr<graph::Graph>, std::unique_ptr<lib::Graph::Single>>
 	checkIfNew(std::unique_ptr<lib::Graph::Single> g) const;
+	// As above, but with indexKey == getGraphIndexKey(*g) computed in advance.
+	std::pair<std::shared_ptr<graph::Graph>, std::unique_ptr<lib::Graph::Single>>
+	checkIfNew(std::unique_ptr<lib::Graph::Single> g, std::size_t indexKey) const;
+	// The key g is indexed by in the graph database.
+	// It only reads g and the database settings, so it may be called concurrently for different graphs,
+	// as long as the database is not modified.
+	std::size_t getGraphIndexKey(const lib::Graph::Single &g) const;
+	// See Graph::Collection::prepareForConcurrentLookup.
+	void prepareForConcurrentCheckIfNew();
 	// trustAddGraph and then rename if it was a new graph.
 	// Returns the value from trustAddGraph.
 	bool addProduct(std::shared_ptr<graph::Graph> g);
@@ -81,6 +93,8 @@ protected: // calculation
 	std::pair<Edge, bool> isDerivation(const GraphMultiset &gmsSrc,
 	                                   const GraphMultiset &gmsTar,
 	                                   const lib::Rules::Real *r) const;
+	// the targets of the derivations from gmsSrc which use the rule r, in the order they were added
+	std::vector<GraphMultiset> findDerivationTargets(const GraphMultiset &gmsSrc, const lib::Rules::Real *r) const;
 	// adds a derivation if it does not exist already
 	// the edge descriptor of the derivation is returned, along with the existence status before the call
 	// the rule may be nullptr
@@ -88,10 +102,14 @@ protected: // calculation
 	                                        const GraphMultiset &gmsTar,
 	                                        const lib::Rules::Real *r);
 	const GraphType &getGraphDuringCalculation() const;
+	// From now on, write each new vertex and hyperedge to the journal, starting with the existing ones.
+	// The journal is closed when the calculation ends.
+	void startJournal(std::unique_ptr<Journal::Writer> journal);
 private: // calculation
 	// adds the graph as a vertex, if it's not there already, and returns the vertex
 	Vertex getVertex(const GraphMultiset &gms);
 	void findReversiblePairs();
+	void journalEdge(HyperVertex v);
 public: // post calculation
 	const GraphType &getGraph() const;
 	const Hyper &getHyper() const;
@@ -116,6 +134,7 @@ private: // calculation
 	bool hasCalculated = false;
 	unsigned int productNum = 0;
 	std::vector<std::shared_ptr<graph::Graph> > products;
+	std::unique_ptr<Journal::Writer> journal;
 public:
 	static void diff(const NonHyper &dg1, const NonHyper &dg2);
 };
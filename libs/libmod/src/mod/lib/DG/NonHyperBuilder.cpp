@@ -7,6 +7,8 @@
 #include <mod/lib/DG/RuleApplicationUtils.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
 #include <mod/lib/DG/Strategies/Strategy.hpp>
+#include <mod/lib/DG/IO/BinaryDump.hpp>
+#include <mod/lib/DG/IO/Journal.hpp>
 #include <mod/lib/DG/IO/Read.hpp>
 #include <mod/lib/Graph/IO/Read.hpp>
 #include <mod/lib/Graph/Properties/Term.hpp>
@@ -19,6 +21,8 @@
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+
 namespace mod::lib::DG {
 
 ExecuteResult::ExecuteResult(NonHyperBuilder *owner, int execution)
@@ -101,8 +105,9 @@ std::pair<NonHyper::Edge, bool> Builder::addDerivation(const Derivations &d, Iso
 }
 
 struct NonHyperBuilder::ExecutionEnv final : public Strategies::ExecutionEnv {
-	ExecutionEnv(NonHyperBuilder &owner, LabelSettings labelSettings, Rules::GraphAsRuleCache &graphAsRuleCache)
-			: Strategies::ExecutionEnv(labelSettings, graphAsRuleCache), owner(owner) {}
+	ExecutionEnv(NonHyperBuilder &owner, LabelSettings labelSettings, Rules::GraphAsRuleCache &graphAsRuleCache,
+	             BindCache &bindCache)
+			: Strategies::ExecutionEnv(labelSettings, graphAsRuleCache, bindCache), owner(owner) {}
 
 	void tryAddGraph(std::shared_ptr<graph::Graph> gCand) override {
 		owner.tryAddGraph(gCand);
@@ -140,6 +145,23 @@ struct NonHyperBuilder::ExecutionEnv final : public Strategies::ExecutionEnv {
 		return owner.checkIfNew(std::move(g)).first;
 	}
 
+	virtual std::shared_ptr<graph::Graph>
+	checkIfNew(std::unique_ptr<lib::Graph::Single> g, std::size_t indexKey) const override {
+		return owner.checkIfNew(std::move(g), indexKey).first;
+	}
+
+	std::size_t getGraphIndexKey(const lib::Graph::Single &g) const override {
+		return owner.getGraphIndexKey(g);
+	}
+
+	std::shared_ptr<graph::Graph> findIsomorphic(std::shared_ptr<graph::Graph> g) const override {
+		return owner.getGraphDatabase().findIsomorphic(g);
+	}
+
+	void prepareForConcurrentCheckIfNew() override {
+		owner.prepareForConcurrentCheckIfNew();
+	}
+
 	bool addProduct(std::shared_ptr<graph::Graph> g) override {
 		return owner.addProduct(g);
 	}
@@ -150,10 +172,25 @@ struct NonHyperBuilder::ExecutionEnv final : public Strategies::ExecutionEnv {
 		return owner.isDerivation(gmsSrc, gmsTar, r).second;
 	}
 
-	bool suggestDerivation(const GraphMultiset &gmsSrc,
+	std::vector<GraphMultiset>
+	findDerivationTargets(const GraphMultiset &gmsSrc, const lib::Rules::Real *r) const override {
+		return owner.findDerivationTargets(gmsSrc, r);
+	}
+
+	void suggestDerivation(const GraphMultiset &gmsSrc,
 	                       const GraphMultiset &gmsTar,
-	                       const lib::Rules::Real *r) override {
-		return owner.suggestDerivation(gmsSrc, gmsTar, r).second;
+	                       const lib::Rules::Real *r,
+	                       std::function<void()> onNew) override {
+		if(owner.suggestDerivation(gmsSrc, gmsTar, r).second)
+			onNew();
+	}
+
+	bool hasOnlyNativePredicates() const override {
+		const auto isNative = [](const auto &pred) {
+			return pred->isNative();
+		};
+		return std::all_of(leftPredicates.begin(), leftPredicates.end(), isNative)
+		       && std::all_of(rightPredicates.begin(), rightPredicates.end(), isNative);
 	}
 
 	void pushLeftPredicate(std::shared_ptr<mod::Function<bool(const mod::Derivation &)> > pred) override {
@@ -172,6 +209,10 @@ struct NonHyperBuilder::ExecutionEnv final : public Strategies::ExecutionEnv {
 		rightPredicates.pop_back();
 	}
 
+	unsigned int getNumThreads() const override {
+		return getConfig().common.numThreads.get();
+	}
+
 public:
 	NonHyperBuilder &owner;
 private: // state for computation
@@ -183,7 +224,8 @@ private: // state for computation
 ExecuteResult
 Builder::execute(std::unique_ptr<Strategies::Strategy> strategy_, int verbosity, bool ignoreRuleLabelTypes) {
 	NonHyperBuilder::StrategyExecution exec{
-			std::make_unique<NonHyperBuilder::ExecutionEnv>(*dg, dg->getLabelSettings(), dg->graphAsRuleCache),
+			std::make_unique<NonHyperBuilder::ExecutionEnv>(*dg, dg->getLabelSettings(), dg->graphAsRuleCache,
+			                                                 dg->bindCache),
 			std::make_unique<Strategies::GraphState>(),
 			std::move(strategy_)
 	};
@@ -220,6 +262,10 @@ Builder::execute(std::unique_ptr<Strategies::Strategy> strategy_, int verbosity,
 			}
 		});
 	}
+	// the rules may also be used by DGs built concurrently from other threads
+	exec.strategy->forEachRule([this](const lib::Rules::Real &r) {
+		lib::RC::prepareForConcurrentComposition(r, dg->getLabelSettings());
+	});
 
 	exec.strategy->execute(Strategies::PrintSettings(std::cout, false, verbosity), *exec.input);
 	dg->executions.push_back(std::move(exec));
@@ -232,6 +278,8 @@ Builder::apply(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
                int verbosity, IsomorphismPolicy graphPolicy) {
 	IO::Logger logger(std::cout);
 	dg->rules.insert(rOrig);
+	// the rule may also be used by DGs built concurrently from other threads
+	lib::RC::prepareForConcurrentComposition(rOrig->getRule(), dg->getLabelSettings());
 	switch(graphPolicy) {
 	case IsomorphismPolicy::Check:
 		for(const auto &g: graphs)
@@ -257,6 +305,9 @@ Builder::apply(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
 
 	std::vector<BoundRule> resultRules;
 	const auto ls = dg->getLabelSettings();
+	const GetIndexKey getIndexKey = [this](const lib::Graph::Single &g) {
+		return dg->getGraphIndexKey(g);
+	};
 	{
 		// we must bind each graph, so increase the span of graphs one at a time,
 		// and only keep bound rules that still have left-hand components
@@ -267,7 +318,7 @@ Builder::apply(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
 					isLast = round + 1 == libGraphs.size(),
 					assumeConfluence = getConfig().dg.applyAssumeConfluence.get(),
 					&resultRules]
-					(IO::Logger logger, BoundRule br) -> bool {
+					(IO::Logger logger, BoundRule br, std::optional<ProductCandidates>) -> bool {
 				if(isLast) {
 					// save only the fully bound ones
 					if(br.rule->isOnlyRightSide()) {
@@ -286,7 +337,9 @@ Builder::apply(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
 					verbosity, logger,
 					round,
 					firstGraph, firstGraph + round + 1, inputRules,
-					dg->graphAsRuleCache, ls,
+					dg->graphAsRuleCache, &dg->bindCache, ls,
+					getConfig().common.numThreads.get(),
+					nullptr, // the products are only made for the results used
 					onOutput);
 			for(BoundRule &br: outputRules) {
 				// always go to the next graph
@@ -317,9 +370,9 @@ Builder::apply(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
 		const auto &r = *br.rule;
 		assert(r.isOnlyRightSide());
 		auto products = splitRule(
-				r.getDPORule(), ls.type, ls.withStereo,
-				[this](std::unique_ptr<lib::Graph::Single> gCand) {
-					return dg->checkIfNew(std::move(gCand)).first;
+				makeProductCandidates(r.getDPORule(), ls.withStereo, getIndexKey), ls.type, ls.withStereo,
+				[this](std::unique_ptr<lib::Graph::Single> gCand, std::size_t indexKey) {
+					return dg->checkIfNew(std::move(gCand), indexKey).first;
 				},
 				[verbosity, &logger](std::shared_ptr<graph::Graph> gWrapped, std::shared_ptr<graph::Graph> gPrev) {
 					if(verbosity >= V_RuleApplication_Binding) {
@@ -386,6 +439,9 @@ Builder::applyRelaxed(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
 		libGraphs.push_back(&g->getGraph());
 
 	const auto ls = dg->getLabelSettings();
+	const GetIndexKey getIndexKey = [this](const lib::Graph::Single &g) {
+		return dg->getGraphIndexKey(g);
+	};
 	// we must bind each graph, so increase the span of graphs one at a time,
 	// and only keep bound rules that still have left-hand components
 	std::vector<BoundRule> inputRules{{&rOrig->getRule(), {}, 0}};
@@ -394,8 +450,8 @@ Builder::applyRelaxed(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
 		const auto firstGraph = libGraphs.begin();
 		const auto lastGraph = libGraphs.end();
 
-		const auto onOutput = [this, verbosity, ls, &res, rOrig]
-				(IO::Logger logger, BoundRule br) -> bool {
+		const auto onOutput = [this, verbosity, ls, &res, rOrig, &getIndexKey]
+				(IO::Logger logger, BoundRule br, std::optional<ProductCandidates> candidates) -> bool {
 			if(!br.rule->isOnlyRightSide())
 				return true;
 
@@ -408,10 +464,14 @@ Builder::applyRelaxed(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
 			}
 
 			assert(r.isOnlyRightSide());
+			if(candidates)
+				candidates = commitProductCandidates(std::move(*candidates));
+			else
+				candidates = makeProductCandidates(r.getDPORule(), ls.withStereo, getIndexKey);
 			auto products = splitRule(
-					r.getDPORule(), ls.type, ls.withStereo,
-					[this](std::unique_ptr<lib::Graph::Single> gCand) {
-						return dg->checkIfNew(std::move(gCand)).first;
+					std::move(*candidates), ls.type, ls.withStereo,
+					[this](std::unique_ptr<lib::Graph::Single> gCand, std::size_t indexKey) {
+						return dg->checkIfNew(std::move(gCand), indexKey).first;
 					},
 					[verbosity, &logger](std::shared_ptr<graph::Graph> gWrapped, std::shared_ptr<graph::Graph> gPrev) {
 						if(verbosity >= V_RuleApplication_Binding) {
@@ -452,7 +512,9 @@ Builder::applyRelaxed(const std::vector<std::shared_ptr<graph::Graph>> &graphs,
 				(verbosity, logger,
 				 round,
 				 firstGraph, lastGraph, inputRules,
-				 dg->graphAsRuleCache, ls,
+				 dg->graphAsRuleCache, &dg->bindCache, ls,
+				 getConfig().common.numThreads.get(),
+				 getIndexKey,
 				 onOutput);
 		for(BoundRule &br: outputRules) {
 			// always go to the next graph
@@ -527,6 +589,12 @@ void Builder::addAbstract(const std::string &description) {
 	}
 }
 
+void Builder::startJournal(const std::string &file) {
+	if(dg->getLabelSettings().withStereo)
+		throw LogicError("Can not yet journal DGs with stereo data.");
+	dg->startJournal(std::make_unique<Journal::Writer>(file, dg->getLabelSettings()));
+}
+
 bool Builder::load(const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
                    const std::string &file, std::ostream &err, int verbosity) {
 	boost::iostreams::mapped_file_source ifs;
@@ -543,43 +611,54 @@ bool Builder::load(const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
 		return false;
 	}
 	ifs.close();
-	auto jOpt = lib::DG::Read::loadDump(file, err);
-	if(!jOpt) return {};
-	auto &j = *jOpt;
-
-	LabelSettings labelSettings = from_json(j["labelSettings"]);
-	if(labelSettings != dg->getLabelSettings()) {
+	const auto checkLabelSettings = [&](LabelSettings labelSettings) {
+		if(labelSettings == dg->getLabelSettings()) return true;
 		err << "Mismatch of label settings. This DG has "
 		    << dg->getLabelSettings()
 		    << " but the dump to be loaded has "
 		    << labelSettings << ".";
 		return false;
-	}
+	};
+	if(lib::DG::BinaryDump::isBinaryDump(file)) {
+		const auto view = lib::DG::BinaryDump::View::open(file, err);
+		if(!view) return false;
+		if(!checkLabelSettings(view->getLabelSettings())) return false;
+		return trustLoadDump(*view, ruleDatabase, err, verbosity);
+	}
+	auto jOpt = lib::DG::Journal::isJournal(file)
+	            ? lib::DG::Journal::loadAsDump(file, err)
+	            : lib::DG::Read::loadDump(file, err);
+	if(!jOpt) return {};
+	auto &j = *jOpt;
+
+	if(!checkLabelSettings(from_json(j["labelSettings"]))) return false;
 	auto res = trustLoadDump(std::move(j), ruleDatabase, err, verbosity);
 	return res;
 }
 
-bool Builder::trustLoadDump(nlohmann::json &&j,
-                            const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
-                            std::ostream &err,
-                            int verbosity) {
-	constexpr int V_Link = 2;
+namespace {
 
-	assert(j["version"].get<int>() == 3);
+// Adaptor of a JSON dump to the interface of BinaryDump::View.
+struct JsonDump {
+	explicit JsonDump(const nlohmann::json &j)
+			: jVertices(j["vertices"]),
+			  jRules(j.contains("rules") ? j["rules"] : empty),
+			  jEdges(j.contains("edges") ? j["edges"] : empty) {}
 
-	// first do graph wrapping against the underlying graph database
-	// we assume that the incomming graphs are all pairwise non-isomorphic
-	struct Vertex {
-		int id;
-		std::shared_ptr<graph::Graph> graph;
-		bool wasNew;
-	};
-	auto &jVertices = j["vertices"];
-	std::vector<Vertex> vertices;
-	vertices.reserve(jVertices.size());
-	for(auto &jv: jVertices) {
-		Vertex v;
-		v.id = jv[0].get<int>();
+	std::size_t getNumVertices() const {
+		return jVertices.size();
+	}
+
+	int getVertexId(std::size_t i) const {
+		return jVertices[i][0].get<int>();
+	}
+
+	const std::string &getVertexName(std::size_t i) const {
+		return jVertices[i][1].get_ref<const std::string &>();
+	}
+
+	std::unique_ptr<lib::Graph::Single> makeVertexGraph(std::size_t i, std::ostream &err) const {
+		const auto &jv = jVertices[i];
 		const std::string &gml = jv[2].get<std::string>();
 		lib::IO::Warnings warnings;
 		auto gDatasRes = lib::Graph::Read::gml(warnings, gml);
@@ -587,19 +666,94 @@ bool Builder::trustLoadDump(nlohmann::json &&j,
 		if(!gDatasRes) {
 			err << gDatasRes.extractError() << '\n';
 			err << "Error when loading graph GML in DG dump, for graph '";
-			err << jv[1].get<std::string>() << "', in vertex " << v.id << ".";
-			return false;
+			err << jv[1].get<std::string>() << "', in vertex " << getVertexId(i) << ".";
+			return nullptr;
 		}
 		auto gDatas = std::move(*gDatasRes);
 		if(gDatas.size() != 1) {
 			err << "Loaded graph has multiple connected components (" << gDatas.size() << "). ";
 			err << "Error when loading graph GML in DG dump, for graph '";
-			err << jv[1].get<std::string>() << "', in vertex " << v.id << ".";
-			return false;
+			err << jv[1].get<std::string>() << "', in vertex " << getVertexId(i) << ".";
+			return nullptr;
 		}
-		auto gCand = std::make_unique<lib::Graph::Single>(
+		return std::make_unique<lib::Graph::Single>(
 				std::move(gDatas.front().g), std::move(gDatas.front().pString), std::move(gDatas.front().pStereo));
-		gCand->setName(jv[1].get<std::string>());
+	}
+
+	std::size_t getNumRules() const {
+		return jRules.size();
+	}
+
+	const std::string &getRuleGML(std::size_t i) const {
+		return jRules[i].get_ref<const std::string &>();
+	}
+
+	std::size_t getNumEdges() const {
+		return jEdges.size();
+	}
+
+	int getEdgeId(std::size_t i) const {
+		return jEdges[i][0].get<int>();
+	}
+
+	const nlohmann::json &getEdgeSources(std::size_t i) const {
+		return jEdges[i][1];
+	}
+
+	const nlohmann::json &getEdgeTargets(std::size_t i) const {
+		return jEdges[i][2];
+	}
+
+	const nlohmann::json &getEdgeRules(std::size_t i) const {
+		return jEdges[i].size() > 3 ? jEdges[i][3] : empty;
+	}
+private:
+	static const nlohmann::json empty;
+	const nlohmann::json &jVertices, &jRules, &jEdges;
+};
+
+const nlohmann::json JsonDump::empty = nlohmann::json::array();
+
+} // namespace
+
+bool Builder::trustLoadDump(nlohmann::json &&j,
+                            const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
+                            std::ostream &err,
+                            int verbosity) {
+	assert(j["version"].get<int>() == 3);
+	return trustLoadDumpImpl(JsonDump(j), ruleDatabase, err, verbosity);
+}
+
+bool Builder::trustLoadDump(const BinaryDump::View &view,
+                            const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
+                            std::ostream &err,
+                            int verbosity) {
+	return trustLoadDumpImpl(view, ruleDatabase, err, verbosity);
+}
+
+template<typename Dump>
+bool Builder::trustLoadDumpImpl(const Dump &dump,
+                                const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
+                                std::ostream &err,
+                                int verbosity) {
+	constexpr int V_Link = 2;
+
+	// first do graph wrapping against the underlying graph database
+	// we assume that the incomming graphs are all pairwise non-isomorphic
+	struct Vertex {
+		int id;
+		std::shared_ptr<graph::Graph> graph;
+		bool wasNew;
+	};
+	const int numVertices = dump.getNumVertices();
+	std::vector<Vertex> vertices;
+	vertices.reserve(numVertices);
+	for(int i = 0; i != numVertices; ++i) {
+		Vertex v;
+		v.id = dump.getVertexId(i);
+		auto gCand = dump.makeVertexGraph(i, err);
+		if(!gCand) return false;
+		gCand->setName(std::string(dump.getVertexName(i)));
 		auto p = dg->checkIfNew(std::move(gCand));
 		v.graph = p.first;
 		v.wasNew = p.second == nullptr;
@@ -608,13 +762,15 @@ bool Builder::trustLoadDump(nlohmann::json &&j,
 	// now the vertices are ready to be added
 
 	// prepare the rules, we assume those in the dump are unique
-	const auto &jRules = j["rules"];
+	const int numRules = dump.getNumRules();
 	std::vector<std::shared_ptr<rule::Rule>> rules;
-	rules.reserve(jRules.size());
+	rules.reserve(numRules);
 	const auto ls = dg->getLabelSettings();
-	for(const auto &j: jRules) {
-		const std::string &jr = j.get<std::string>();
-		auto rCand = rule::Rule::fromGMLString(jr, false);
+	// the rule database may also be used concurrently from other threads
+	for(const auto &r : ruleDatabase)
+		lib::RC::prepareForConcurrentComposition(r->getRule(), ls);
+	for(int i = 0; i != numRules; ++i) {
+		auto rCand = rule::Rule::fromGMLString(std::string(dump.getRuleGML(i)), false);
 		const auto iter = std::find_if(ruleDatabase.begin(), ruleDatabase.end(), [rCand, ls](const auto &r) {
 			return r->isomorphism(rCand, 1, ls) == 1;
 		});
@@ -632,9 +788,7 @@ bool Builder::trustLoadDump(nlohmann::json &&j,
 
 	// do merge of vertices and edges in order of increasing id
 	std::unordered_map<int, const lib::Graph::Single *> graphFromId;
-	const auto &jEdges = j["edges"];
-	const int numVertices = vertices.size();
-	const int numEdges = jEdges.size();
+	const int numEdges = dump.getNumEdges();
 	int iVertices = 0;
 	int iEdges = 0;
 	for(int id = 0; id != numVertices + numEdges; ++id) {
@@ -643,41 +797,45 @@ bool Builder::trustLoadDump(nlohmann::json &&j,
 			const bool wasNewAsVertex = dg->trustAddGraphAsVertex(v.graph);
 			graphFromId[v.id] = &v.graph->getGraph();
 			if(verbosity >= V_Link && !v.wasNew) {
-				std::cout << "DG loading: loaded graph '" << jVertices[iVertices][1].get<std::string>()
+				std::cout << "DG loading: loaded graph '" << dump.getVertexName(iVertices)
 				          << "' isomorphic to existing graph '" << v.graph->getName() << "'." << std::endl;
 			}
 			//if(wasNewAsVertex) giveProductStatus(v.graph);
 			(void) wasNewAsVertex;
 			++iVertices;
-		} else if(iEdges < numEdges && jEdges[iEdges][0].get<int>() == id) {
-			const auto &e = jEdges[iEdges];
+		} else if(iEdges < numEdges && dump.getEdgeId(iEdges) == id) {
+			const auto &srcs = dump.getEdgeSources(iEdges);
+			const auto &tars = dump.getEdgeTargets(iEdges);
 			std::vector<const lib::Graph::Single *> srcGraphs, tarGraphs;
-			srcGraphs.reserve(e[1].size());
-			tarGraphs.reserve(e[2].size());
-			for(int src: e[1]) {
+			srcGraphs.reserve(srcs.size());
+			tarGraphs.reserve(tars.size());
+			for(std::size_t k = 0; k != srcs.size(); ++k) {
+				const int src = srcs[k];
 				auto gIter = graphFromId.find(src);
 				if(gIter == end(graphFromId)) {
-					err << "Corrupt data for edge " << e[0].get<int>() << ". Source " << src << " is not a yet a vertex.";
+					err << "Corrupt data for edge " << id << ". Source " << src << " is not a yet a vertex.";
 					return false;
 				}
 				srcGraphs.push_back(gIter->second);
 			}
-			for(int tar: e[2]) {
+			for(std::size_t k = 0; k != tars.size(); ++k) {
+				const int tar = tars[k];
 				auto gIter = graphFromId.find(tar);
 				if(gIter == end(graphFromId)) {
-					err << "Corrupt data for edge " << e[0].get<int>() << ". Target " << tar << " is not a yet a vertex.";
+					err << "Corrupt data for edge " << id << ". Target " << tar << " is not a yet a vertex.";
 					return false;
 				}
 				tarGraphs.push_back(gIter->second);
 			}
 			GraphMultiset gmsSrc(std::move(srcGraphs)), gmsTar(std::move(tarGraphs));
-			const auto &ruleIds = e[3];
-			if(ruleIds.empty()) {
+			const auto &ruleIds = dump.getEdgeRules(iEdges);
+			if(ruleIds.size() == 0) {
 				dg->suggestDerivation(std::move(gmsSrc), std::move(gmsTar), nullptr);
 			} else {
-				for(const int rId: ruleIds) {
+				for(std::size_t k = 0; k != ruleIds.size(); ++k) {
+					const int rId = ruleIds[k];
 					if(rId < 0 || rId >= rules.size()) {
-						err << "Corrupt data for edge " << e[0].get<int>() << ". Rule offset " << rId << " is not in range.";
+						err << "Corrupt data for edge " << id << ". Rule offset " << rId << " is not in range.";
 						return false;
 					}
 					const auto r = rules[rId];
@@ -691,7 +849,7 @@ bool Builder::trustLoadDump(nlohmann::json &&j,
 			err << ", vertices: " << iVertices << " of " << numVertices;
 			if(iVertices < numVertices) err << ", next vertex: " << vertices[iVertices].id;
 			err << ", edges: " << iEdges << " of " << numEdges;
-			if(iEdges < numEdges) err << ", next edge: " << jEdges[iEdges][0].get<int>();
+			if(iEdges < numEdges) err << ", next edge: " << dump.getEdgeId(iEdges);
 			err << ").";
 			return false;
 		}
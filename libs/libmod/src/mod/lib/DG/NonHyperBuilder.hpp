@@ -2,11 +2,15 @@
 #define MOD_LIB_DG_NONHYPERBUILDER_HPP
 
 #include <mod/Derivation.hpp>
+#include <mod/lib/DG/BindCache.hpp>
 #include <mod/lib/DG/NonHyper.hpp>
 #include <mod/lib/IO/Json.hpp>
 #include <mod/lib/Rules/GraphAsRuleCache.hpp>
 
 namespace mod::lib::DG {
+namespace BinaryDump {
+struct View;
+} // namespace BinaryDump
 namespace Strategies {
 struct GraphState;
 } // namespace Strategies
@@ -39,6 +43,7 @@ public:
 	applyRelaxed(const std::vector<std::shared_ptr<graph::Graph>> &graphs, std::shared_ptr<rule::Rule> r,
 	             int verbosity, IsomorphismPolicy graphPolicy);
 	void addAbstract(const std::string &description);
+	void startJournal(const std::string &file);
 	bool load(const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
 	          const std::string &file, std::ostream &err, int verbosity);
 public:
@@ -47,6 +52,14 @@ public:
 	bool trustLoadDump(nlohmann::json &&j,
 	                   const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
 	                   std::ostream &err, int verbosity);
+	bool trustLoadDump(const BinaryDump::View &view,
+	                   const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
+	                   std::ostream &err, int verbosity);
+private:
+	template<typename Dump>
+	bool trustLoadDumpImpl(const Dump &dump,
+	                       const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
+	                       std::ostream &err, int verbosity);
 private:
 	NonHyperBuilder *dg;
 };
@@ -70,6 +83,7 @@ private:
 	};
 	std::vector<StrategyExecution> executions;
 	Rules::GraphAsRuleCache graphAsRuleCache; // referenced by the ExecutionEnvs
+	BindCache bindCache; // referenced by the ExecutionEnvs
 };
 
 } // namespace mod::lib::DG
@@ -2,6 +2,8 @@
 #define MOD_LIB_DG_RULEAPPLICATIONUTILS_HPP
 
 #include <mod/graph/Graph.hpp>
+#include <mod/lib/Algorithm/Parallel.hpp>
+#include <mod/lib/DG/BindCache.hpp>
 #include <mod/lib/Graph/Single.hpp>
 #include <mod/lib/Graph/Properties/Stereo.hpp>
 #include <mod/lib/Graph/Properties/String.hpp>
@@ -11,6 +13,12 @@
 #include <mod/lib/Rules/Real.hpp>
 #include <mod/lib/Stereo/CloneUtil.hpp>
 
+#include <boost/functional/hash.hpp>
+
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
 namespace mod::lib::DG {
 
 struct BoundRule {
@@ -32,6 +40,17 @@ public:
 		return 1 == lib::Rules::Real::isomorphism(*rule, *other.rule, 1, ls);
 	}
 
+	// pre: this->makeCanonical() must have been called.
+	// Returns a hash of the bound graphs and the rule, such that bound rules
+	// for which isomorphicTo is true have the same fingerprint.
+	std::size_t fingerprint(const LabelType labelType) const {
+		std::size_t res = nextGraphOffset;
+		for(const auto *g : boundGraphs)
+			boost::hash_combine(res, g->getId());
+		boost::hash_combine(res, lib::Rules::Real::fingerprint(*rule, labelType));
+		return res;
+	}
+
 	friend std::ostream &operator<<(std::ostream &s, const BoundRule &br) {
 		s << "{rule=" << br.rule->getName() << ", boundGraphs=[";
 		bool first = true;
@@ -52,160 +71,26 @@ inline int toRCVerbosity(int verbosity) {
 	return std::max(0, verbosity - V_RuleApplication_Binding);
 }
 
-// BoundRules are given to onOutput. It must return a boolean indicating
-// whether to continue the search.
-// If a rule in a BoundRule given to onOutput is only-right-side,
-// then onOutput gains responsibility for it.
-// Otherwise, if there are still left-hand elements, then
-// bindGraphs retains responsibility, and will return a list of all these.
-// This is to do isomorphism checks.
-template<typename Iter, typename OnOutput>
-[[nodiscard]] std::vector<BoundRule> bindGraphs(
-		const int verbosity, IO::Logger &logger,
-		const int bindRound,
-		const Iter firstGraph, const Iter lastGraph,
-		const std::vector<BoundRule> &inputRules,
-		Rules::GraphAsRuleCache &graphAsRuleCache,
-		const LabelSettings labelSettings,
-		OnOutput onOutput) {
-	if(verbosity >= V_RuleApplication) {
-		logger.indent() << "Bind round " << (bindRound + 1) << " with "
-		                << (lastGraph - firstGraph) << " graphs "
-		                << "and " << inputRules.size() << " rules." << std::endl;
-		++logger.indentLevel;
-	}
-	int numDup = 0;
-	int numUnique = 0;
-	std::vector<BoundRule> outputRules;
-	for(const BoundRule &brInput : inputRules) {
-		if(verbosity >= V_RuleApplication_Binding) {
-			logger.indent() << "Processing input rule " << brInput << std::endl;
-			++logger.indentLevel;
-		}
-		// try to bind with all graphs that haven't been tried yet
-		assert(brInput.nextGraphOffset <= lastGraph - firstGraph);
-		const auto brFirstGraph = firstGraph + brInput.nextGraphOffset;
-		for(auto iterGraph = brFirstGraph; iterGraph != lastGraph; ++iterGraph) {
-			const auto *g = *iterGraph;
-			if(verbosity >= V_RuleApplication_Binding) {
-				logger.indent() << "Trying to bind " << g->getName() << " to " << brInput << ":" << std::endl;
-				++logger.indentLevel;
-			}
-			const auto reporter =
-					[labelSettings, &logger, &brInput, &outputRules, firstGraph, iterGraph, onOutput, &numUnique, &numDup]
-							(std::unique_ptr<lib::Rules::Real> r) -> bool {
-						BoundRule brOutput{r.release(), brInput.boundGraphs,
-						                   static_cast<int>(iterGraph - firstGraph)};
-						brOutput.boundGraphs.push_back(*iterGraph);
-						if(!brOutput.rule->isOnlyRightSide()) {
-							// check if we have it already
-							brOutput.makeCanonical();
-							for(const BoundRule &brStored : outputRules) {
-								if(brStored.isomorphicTo(brOutput, labelSettings)) {
-									delete brOutput.rule;
-									++numDup;
-									return true;
-								}
-							}
-							// we store a copy of the bound info so the user can mess with their copy
-							outputRules.push_back(brOutput);
-						}
-						++numUnique;
-						return onOutput(logger, std::move(brOutput));
-					};
-			const lib::Rules::Real &rFirst = graphAsRuleCache.getBindRule(g)->getRule();
-			const lib::Rules::Real &rSecond = *brInput.rule;
-			lib::RC::Super mm(toRCVerbosity(verbosity), logger, true, true);
-			lib::RC::composeRuleRealByMatchMaker(rFirst, rSecond, mm, reporter, labelSettings);
-			if(verbosity >= V_RuleApplication_Binding)
-				--logger.indentLevel;
-		}
-		if(verbosity >= V_RuleApplication_Binding)
-			--logger.indentLevel;
-	}
-	if(verbosity >= V_RuleApplication) {
-		logger.indent() << "Result of bind round " << (bindRound + 1) << ": "
-		                << numUnique << " rules + " << numDup << " duplicates" << std::endl;
-		--logger.indentLevel;
-	}
-	return outputRules;
+// Whether bindGraphs may run its compositions concurrently.
+inline bool canBindConcurrently(const int verbosity, const LabelSettings labelSettings) {
+	return lib::RC::canComposeConcurrently(toRCVerbosity(verbosity), labelSettings);
 }
 
+// Whether the binding of a graph to a bound rule should be skipped, see bindGraphs.
+using SkipBinding = std::function<bool(const BoundRule &, const lib::Graph::Single *)>;
+// Called for a binding skipped due to a SkipBinding, see bindGraphs.
+using OnSkippedBinding = std::function<void(const BoundRule &, const lib::Graph::Single *)>;
 
-struct BoundRuleStorage {
-	BoundRuleStorage(bool verbose, IO::Logger logger,
-	                 LabelType labelType,
-	                 bool withStereo,
-	                 std::vector<BoundRule> &ruleStore,
-	                 const BoundRule &rule,
-	                 const lib::Graph::Single *graph)
-			: verbose(verbose), logger(logger), labelType(labelType), withStereo(withStereo),
-			  ruleStore(ruleStore), rule(rule), graph(graph) {}
+// Gives the key a graph is indexed by in the graph database, see NonHyper::getGraphIndexKey.
+using GetIndexKey = std::function<std::size_t(const lib::Graph::Single &)>;
 
-	void add(lib::Rules::Real *r) {
-		BoundRule p{r, rule.boundGraphs, -1};
-		p.boundGraphs.push_back(graph);
-		bool found = false;
-		const bool doBoundRulesDuplicateCheck = true;
-		// if it's only right side, we will rather split it instead
-		if(doBoundRulesDuplicateCheck && !r->isOnlyRightSide()) {
-			std::vector<const lib::Graph::Single *> &rThis = p.boundGraphs;
-
-			std::sort(begin(rThis), end(rThis), [](const lib::Graph::Single *g1, const lib::Graph::Single *g2) {
-				return g1->getId() < g2->getId();
-			});
-
-			for(BoundRule &rp : ruleStore) {
-				if(rThis.size() != rp.boundGraphs.size()) continue;
-				std::vector<const lib::Graph::Single *> &rOther = rp.boundGraphs;
-
-				std::sort(rOther.begin(), rOther.end(), [](const lib::Graph::Single *g1, const lib::Graph::Single *g2) {
-					return g1->getId() < g2->getId();
-				});
-				bool doContinue = false;
-				for(unsigned int i = 0; i < rThis.size(); i++) {
-					if(rThis[i] != rOther[i]) {
-						doContinue = true;
-						break;
-					}
-				}
-				if(doContinue) continue;
-				found = 1 == lib::Rules::Real::isomorphism(*r, *rp.rule, 1,
-				                                           {labelType, LabelRelation::Isomorphism, withStereo,
-				                                            LabelRelation::Isomorphism});
-				if(found) break;
-			}
-		}
-		if(found) {
-			//			std::cout << "Duplicate BRP found" << std::endl;
-			delete r;
-		} else {
-			ruleStore.push_back(p);
-			if(verbose) {
-				logger.indent() << "BoundRules: added <" << r->getName() << ", {";
-				for(const auto *g : p.boundGraphs)
-					logger.s << " " << g->getName();
-				logger.s << " }> onlyRight: " << std::boolalpha << r->isOnlySide(lib::Rules::Membership::R)
-				         << std::endl;
-			}
-		}
-	}
-
-private:
-	const bool verbose;
-	IO::Logger logger;
-	const LabelType labelType;
-	const bool withStereo;
-	std::vector<BoundRule> &ruleStore;
-	const BoundRule &rule;
-	const lib::Graph::Single *graph;
+// The products of an only-right-side rule, i.e., the connected components of its right side,
+// each with its key for the graph database.
+struct ProductCandidates {
+	std::vector<std::unique_ptr<lib::Graph::Single>> graphs;
+	std::vector<std::size_t> indexKeys;
 };
 
-
-// ===========================================================================
-// ===========================================================================
-// ===========================================================================
-
 struct GraphData {
 	using SideVertex = boost::graph_traits<lib::DPO::CombinedRule::SideProjectedGraphType>::vertex_descriptor;
 public:
@@ -217,19 +102,21 @@ public:
 	std::vector<SideVertex> vertexMap;
 };
 
-template<typename CheckIfNew, typename OnDup>
-std::vector<std::shared_ptr<graph::Graph>> splitRule(const lib::Rules::LabelledRule &rDPO,
-                                                     const LabelType labelType,
-                                                     const bool withStereo,
-                                                     CheckIfNew checkIfNew,
-                                                     OnDup onDup) {
-	if(get_num_connected_components(get_labelled_right(rDPO)) == 0) return {};
+inline std::size_t getNumProducts(const lib::Rules::LabelledRule &rDPO) {
+	return get_num_connected_components(get_labelled_right(rDPO));
+}
+
+// The products get the ids [firstId, firstId + getNumProducts(rDPO)), see lib::Graph::Single::reserveIds.
+// Only the rule and the products are accessed, besides the calls to getIndexKey,
+// so it may be called concurrently for different rules when withStereo is false.
+inline ProductCandidates makeProductCandidates(const lib::Rules::LabelledRule &rDPO,
+                                               const bool withStereo,
+                                               const std::size_t firstId,
+                                               const GetIndexKey &getIndexKey) {
+	if(getNumProducts(rDPO) == 0) return {};
 	using Vertex = lib::Graph::Vertex;
-	using Edge = lib::Graph::Edge;
-	using SideVertex = boost::graph_traits<lib::DPO::CombinedRule::SideProjectedGraphType>::vertex_descriptor;
-	using SideEdge = boost::graph_traits<lib::DPO::CombinedRule::SideProjectedGraphType>::edge_descriptor;
 
-	std::vector<GraphData> products(get_num_connected_components(get_labelled_right(rDPO)));
+	std::vector<GraphData> products(getNumProducts(rDPO));
 	const auto &compMap = get_component(get_labelled_right(rDPO));
 	const auto &gRight = get_R_projected(rDPO);
 	auto rpString = get_string(get_labelled_right(rDPO));
@@ -287,12 +174,48 @@ std::vector<std::shared_ptr<graph::Graph>> splitRule(const lib::Rules::LabelledR
 		} // end foreach product
 	} // end of stereo prop
 	// wrap them
+	ProductCandidates res;
+	res.graphs.reserve(products.size());
+	res.indexKeys.reserve(products.size());
+	for(std::size_t i = 0; i != products.size(); ++i) {
+		auto &g = products[i];
+		res.graphs.push_back(std::make_unique<lib::Graph::Single>(std::move(g.gPtr), std::move(g.pStringPtr),
+		                                                          std::move(g.pStereoPtr), firstId + i));
+		res.indexKeys.push_back(getIndexKey(*res.graphs.back()));
+	}
+	return res;
+}
+
+inline ProductCandidates makeProductCandidates(const lib::Rules::LabelledRule &rDPO,
+                                               const bool withStereo,
+                                               const GetIndexKey &getIndexKey) {
+	const auto firstId = lib::Graph::Single::reserveIds(getNumProducts(rDPO));
+	return makeProductCandidates(rDPO, withStereo, firstId, getIndexKey);
+}
+
+// Products made up front by bindGraphs have temporary ids. This gives them the ids they would have had
+// if they were made by makeProductCandidates at this point, e.g., after a left predicate has accepted the derivation,
+// so the ids do not depend on whether the products were made concurrently.
+inline ProductCandidates commitProductCandidates(ProductCandidates products) {
+	const auto firstId = lib::Graph::Single::reserveIds(products.graphs.size());
+	for(std::size_t i = 0; i != products.graphs.size(); ++i)
+		products.graphs[i]->renumber(firstId + i);
+	return products;
+}
+
+// Checks the products against the graph database, with checkIfNew(std::move(gCand), indexKey),
+// and against each other.
+template<typename CheckIfNew, typename OnDup>
+std::vector<std::shared_ptr<graph::Graph>> splitRule(ProductCandidates products,
+                                                     const LabelType labelType,
+                                                     const bool withStereo,
+                                                     CheckIfNew checkIfNew,
+                                                     OnDup onDup) {
+	assert(products.graphs.size() == products.indexKeys.size());
 	std::vector<std::shared_ptr<graph::Graph>> right;
-	for(auto &g : products) {
+	for(std::size_t i = 0; i != products.graphs.size(); ++i) {
 		// check against the database
-		auto gCand = std::make_unique<lib::Graph::Single>(std::move(g.gPtr), std::move(g.pStringPtr),
-		                                                  std::move(g.pStereoPtr));
-		std::shared_ptr<graph::Graph> gWrapped = checkIfNew(std::move(gCand));
+		std::shared_ptr<graph::Graph> gWrapped = checkIfNew(std::move(products.graphs[i]), products.indexKeys[i]);
 		// checkIfNew does not add the graph, so we must check against the previous products as well
 		for(auto gPrev : right) {
 			const auto ls = mod::LabelSettings(labelType, LabelRelation::Isomorphism, withStereo,
@@ -309,6 +232,325 @@ std::vector<std::shared_ptr<graph::Graph>> splitRule(const lib::Rules::LabelledR
 	return right;
 }
 
+// BoundRules are given to onOutput. It must return a boolean indicating
+// whether to continue the search.
+// If a rule in a BoundRule given to onOutput is only-right-side,
+// then onOutput gains responsibility for it.
+// Otherwise, if there are still left-hand elements, then
+// bindGraphs retains responsibility, and will return a list of all these.
+// This is to do isomorphism checks.
+// If getProductIndexKey is set and the bindings are done concurrently, then each only-right-side rule
+// is given to onOutput along with its products, made concurrently, see makeProductCandidates.
+// The products then have temporary ids, and onOutput must give them their real ids with commitProductCandidates
+// before using them.
+// Otherwise onOutput is given std::nullopt and must make the products itself, if it needs them,
+// e.g., only after a left predicate has accepted the derivation.
+// If skipBinding is set and returns true for an input rule and a graph, then that binding is not attempted,
+// e.g., because it has been tried before.
+// If onSkipped is set, then it is called for each binding skipped by skipBinding,
+// in the same order and from the same thread as onOutput would have been called for its results.
+// If bindCache is not null, then the bindings to input rules without bound graphs are skipped if they are known
+// to give no results, and their number of results is recorded otherwise.
+// With numThreads != 1 the compositions and the products may be computed concurrently (see canBindConcurrently),
+// but onOutput is always called from the calling thread and in the same order as with numThreads == 1.
+template<typename Iter, typename OnOutput>
+[[nodiscard]] std::vector<BoundRule> bindGraphs(
+		const int verbosity, IO::Logger &logger,
+		const int bindRound,
+		const Iter firstGraph, const Iter lastGraph,
+		const std::vector<BoundRule> &inputRules,
+		Rules::GraphAsRuleCache &graphAsRuleCache,
+		BindCache *bindCache,
+		const LabelSettings labelSettings,
+		const unsigned int numThreads,
+		const GetIndexKey &getProductIndexKey,
+		OnOutput onOutput,
+		const SkipBinding &skipBinding = nullptr,
+		const OnSkippedBinding &onSkipped = nullptr) {
+	if(verbosity >= V_RuleApplication) {
+		logger.indent() << "Bind round " << (bindRound + 1) << " with "
+		                << (lastGraph - firstGraph) << " graphs "
+		                << "and " << inputRules.size() << " rules." << std::endl;
+		++logger.indentLevel;
+	}
+	int numDup = 0;
+	int numUnique = 0;
+	std::vector<BoundRule> outputRules;
+	// fingerprint -> index in outputRules
+	std::unordered_multimap<std::size_t, std::size_t> outputIndex;
+	const auto handleResult = [labelSettings, &logger, &outputRules, &outputIndex, firstGraph, &onOutput,
+	                           &numUnique, &numDup]
+			(const BoundRule &brInput, const Iter iterGraph, std::unique_ptr<lib::Rules::Real> r,
+			 std::optional<ProductCandidates> products) -> bool {
+		BoundRule brOutput{r.release(), brInput.boundGraphs,
+		                   static_cast<int>(iterGraph - firstGraph)};
+		brOutput.boundGraphs.push_back(*iterGraph);
+		if(!brOutput.rule->isOnlyRightSide()) {
+			// check if we have it already
+			brOutput.makeCanonical();
+			const auto fp = brOutput.fingerprint(labelSettings.type);
+			const auto candidates = outputIndex.equal_range(fp);
+			for(auto iter = candidates.first; iter != candidates.second; ++iter) {
+				if(outputRules[iter->second].isomorphicTo(brOutput, labelSettings)) {
+					delete brOutput.rule;
+					++numDup;
+					return true;
+				}
+			}
+			// we store a copy of the bound info so the user can mess with their copy
+			outputIndex.emplace(fp, outputRules.size());
+			outputRules.push_back(brOutput);
+		}
+		++numUnique;
+		return onOutput(logger, std::move(brOutput), std::move(products));
+	};
+	const auto logBindBegin = [verbosity, &logger](const BoundRule &brInput, const lib::Graph::Single *g) {
+		if(verbosity >= V_RuleApplication_Binding) {
+			logger.indent() << "Trying to bind " << g->getName() << " to " << brInput << ":" << std::endl;
+			++logger.indentLevel;
+		}
+	};
+	const auto logBindEnd = [verbosity, &logger]() {
+		if(verbosity >= V_RuleApplication_Binding)
+			--logger.indentLevel;
+	};
+	const auto logInputBegin = [verbosity, &logger](const BoundRule &brInput) {
+		if(verbosity >= V_RuleApplication_Binding) {
+			logger.indent() << "Processing input rule " << brInput << std::endl;
+			++logger.indentLevel;
+		}
+	};
+	const auto logInputEnd = logBindEnd;
+	// only the bindings to the original rules are cached
+	const auto useCache = [bindCache](const BoundRule &brInput) {
+		return bindCache && brInput.boundGraphs.empty();
+	};
+	const auto isKnownEmpty = [&useCache, bindCache](const BoundRule &brInput, const lib::Graph::Single *g) {
+		return useCache(brInput) && bindCache->isKnownEmpty(*brInput.rule, *g);
+	};
+	const auto skip = [verbosity, &logger, &skipBinding, &onSkipped, &isKnownEmpty]
+			(const BoundRule &brInput, const lib::Graph::Single *g) {
+		if(skipBinding && skipBinding(brInput, g)) {
+			if(verbosity >= V_RuleApplication_Binding)
+				logger.indent() << "Skipping." << std::endl;
+			if(onSkipped) onSkipped(brInput, g);
+			return true;
+		}
+		if(isKnownEmpty(brInput, g)) {
+			if(verbosity >= V_RuleApplication_Binding)
+				logger.indent() << "Skipping, known to give no results." << std::endl;
+			return true;
+		}
+		return false;
+	};
+	// stereo inference for the products is not prepared for concurrency,
+	// so then there is no gain in making the products up front
+	const auto wantsProducts = [&getProductIndexKey, labelSettings](const lib::Rules::Real &r) {
+		return getProductIndexKey && !labelSettings.withStereo && r.isOnlyRightSide();
+	};
+
+	if(resolveNumThreads(numThreads) == 1 || !canBindConcurrently(verbosity, labelSettings)) {
+		for(const BoundRule &brInput : inputRules) {
+			logInputBegin(brInput);
+			// try to bind with all graphs that haven't been tried yet
+			assert(brInput.nextGraphOffset <= lastGraph - firstGraph);
+			const auto brFirstGraph = firstGraph + brInput.nextGraphOffset;
+			for(auto iterGraph = brFirstGraph; iterGraph != lastGraph; ++iterGraph) {
+				const auto *g = *iterGraph;
+				logBindBegin(brInput, g);
+				if(skip(brInput, g)) {
+					logBindEnd();
+					continue;
+				}
+				std::size_t numResults = 0;
+				bool stopped = false;
+				const auto reporter = [&](std::unique_ptr<lib::Rules::Real> r) -> bool {
+					++numResults;
+					// the products are made by onOutput, so they are not made for rejected derivations
+					stopped = !handleResult(brInput, iterGraph, std::move(r), std::nullopt);
+					return !stopped;
+				};
+				const lib::Rules::Real &rFirst = graphAsRuleCache.getBindRule(g)->getRule();
+				const lib::Rules::Real &rSecond = *brInput.rule;
+				lib::RC::Super mm(toRCVerbosity(verbosity), logger, true, true);
+				lib::RC::composeRuleRealByMatchMaker(rFirst, rSecond, mm, reporter, labelSettings);
+				// a stopped composition may have had more results
+				if(!stopped && useCache(brInput))
+					bindCache->insert(rSecond, *g, numResults);
+				logBindEnd();
+			}
+			logInputEnd();
+		}
+	} else {
+		// Each task is the binding of a single graph to a single input rule.
+		// The compositions of a batch of tasks are done concurrently, then the products of the results,
+		// and the results are then handled in task order, which is the same order as the serial version above uses.
+		struct Task {
+			const BoundRule *brInput;
+			Iter iterGraph;
+			const lib::Rules::Real *rFirst; // nullptr if the binding is skipped
+			bool skippedBySkipBinding;
+			std::vector<std::unique_ptr<lib::Rules::Real>> results;
+			std::vector<std::optional<ProductCandidates>> products; // for each result, if wanted
+		};
+		// a result to make products for, with the first of its temporary graph ids
+		struct ProductJob {
+			Task *t;
+			std::size_t result;
+			std::size_t firstId;
+		};
+		constexpr std::size_t firstTemporaryGraphId = std::size_t(1) << 63;
+		std::vector<ProductJob> productJobs;
+		std::vector<Task> tasks;
+		for(const BoundRule &brInput : inputRules) {
+			assert(brInput.nextGraphOffset <= lastGraph - firstGraph);
+			lib::RC::prepareForConcurrentComposition(*brInput.rule, labelSettings);
+			const auto brFirstGraph = firstGraph + brInput.nextGraphOffset;
+			for(auto iterGraph = brFirstGraph; iterGraph != lastGraph; ++iterGraph)
+				tasks.push_back(Task{&brInput, iterGraph, nullptr, false, {}, {}});
+		}
+		const std::size_t batchSize = 64 * std::size_t(resolveNumThreads(numThreads));
+		for(std::size_t batchBegin = 0; batchBegin < tasks.size(); batchBegin += batchSize) {
+			const std::size_t batchEnd = std::min(tasks.size(), batchBegin + batchSize);
+			// the cache is not synchronised, so fetch the bind rules up front
+			for(std::size_t i = batchBegin; i != batchEnd; ++i) {
+				auto &t = tasks[i];
+				if(skipBinding && skipBinding(*t.brInput, *t.iterGraph)) {
+					t.skippedBySkipBinding = true;
+					continue;
+				}
+				if(isKnownEmpty(*t.brInput, *t.iterGraph)) continue;
+				t.rFirst = &graphAsRuleCache.getBindRule(*t.iterGraph)->getRule();
+				lib::RC::prepareForConcurrentComposition(*t.rFirst, labelSettings);
+			}
+			parallelFor(numThreads, batchEnd - batchBegin, [&tasks, batchBegin, &logger, labelSettings](std::size_t i) {
+				auto &t = tasks[batchBegin + i];
+				if(!t.rFirst) return;
+				const auto reporter = [&t](std::unique_ptr<lib::Rules::Real> r) -> bool {
+					t.results.push_back(std::move(r));
+					return true;
+				};
+				lib::RC::Super mm(0, logger, true, true);
+				lib::RC::composeRuleRealByMatchMaker(*t.rFirst, *t.brInput->rule, mm, reporter, labelSettings);
+			});
+			// The products may still be rejected by a left predicate, so they only get temporary ids,
+			// above those of all real graphs, also those in IdRanges. The real ids are reserved by
+			// commitProductCandidates when a product is accepted.
+			productJobs.clear();
+			std::size_t nextTemporaryId = firstTemporaryGraphId;
+			for(std::size_t i = batchBegin; i != batchEnd; ++i) {
+				auto &t = tasks[i];
+				t.products.resize(t.results.size());
+				for(std::size_t j = 0; j != t.results.size(); ++j) {
+					if(!wantsProducts(*t.results[j])) continue;
+					productJobs.push_back(ProductJob{&t, j, nextTemporaryId});
+					nextTemporaryId += getNumProducts(t.results[j]->getDPORule());
+				}
+			}
+			parallelFor(numThreads, productJobs.size(), [&productJobs, &getProductIndexKey](std::size_t i) {
+				const auto &job = productJobs[i];
+				const auto &rDPO = job.t->results[job.result]->getDPORule();
+				job.t->products[job.result] = makeProductCandidates(rDPO, false, job.firstId, getProductIndexKey);
+			});
+			for(std::size_t i = batchBegin; i != batchEnd; ++i) {
+				auto &t = tasks[i];
+				if(t.iterGraph == firstGraph + t.brInput->nextGraphOffset)
+					logInputBegin(*t.brInput);
+				logBindBegin(*t.brInput, *t.iterGraph);
+				if(!t.rFirst && verbosity >= V_RuleApplication_Binding)
+					logger.indent() << "Skipping." << std::endl;
+				if(t.skippedBySkipBinding && onSkipped)
+					onSkipped(*t.brInput, *t.iterGraph);
+				// all results have been computed, even if the serial search would have been stopped
+				if(t.rFirst && useCache(*t.brInput))
+					bindCache->insert(*t.brInput->rule, **t.iterGraph, t.results.size());
+				// if the serial search would have been stopped, then the remaining results are simply discarded
+				for(std::size_t j = 0; j != t.results.size(); ++j)
+					if(!handleResult(*t.brInput, t.iterGraph, std::move(t.results[j]), std::move(t.products[j]))) break;
+				t.results.clear();
+				t.products.clear();
+				logBindEnd();
+				if(t.iterGraph + 1 == lastGraph)
+					logInputEnd();
+			}
+		}
+	}
+	if(verbosity >= V_RuleApplication) {
+		logger.indent() << "Result of bind round " << (bindRound + 1) << ": "
+		                << numUnique << " rules + " << numDup << " duplicates" << std::endl;
+		--logger.indentLevel;
+	}
+	return outputRules;
+}
+
+
+struct BoundRuleStorage {
+	BoundRuleStorage(bool verbose, IO::Logger logger,
+	                 LabelType labelType,
+	                 bool withStereo,
+	                 std::vector<BoundRule> &ruleStore,
+	                 const BoundRule &rule,
+	                 const lib::Graph::Single *graph)
+			: verbose(verbose), logger(logger), labelType(labelType), withStereo(withStereo),
+			  ruleStore(ruleStore), rule(rule), graph(graph) {
+		for(std::size_t i = 0; i != ruleStore.size(); ++i) {
+			if(ruleStore[i].rule->isOnlyRightSide()) continue;
+			ruleStore[i].makeCanonical();
+			index.emplace(ruleStore[i].fingerprint(labelType), i);
+		}
+	}
+
+	void add(lib::Rules::Real *r) {
+		BoundRule p{r, rule.boundGraphs, -1};
+		p.boundGraphs.push_back(graph);
+		bool found = false;
+		const bool doBoundRulesDuplicateCheck = true;
+		// if it's only right side, we will rather split it instead
+		const bool doCheck = doBoundRulesDuplicateCheck && !r->isOnlyRightSide();
+		std::size_t fp = 0;
+		if(doCheck) {
+			p.makeCanonical();
+			fp = p.fingerprint(labelType);
+			const auto candidates = index.equal_range(fp);
+			for(auto iter = candidates.first; iter != candidates.second; ++iter) {
+				const BoundRule &rp = ruleStore[iter->second];
+				if(p.boundGraphs != rp.boundGraphs) continue;
+				found = 1 == lib::Rules::Real::isomorphism(*r, *rp.rule, 1,
+				                                           {labelType, LabelRelation::Isomorphism, withStereo,
+				                                            LabelRelation::Isomorphism});
+				if(found) break;
+			}
+		}
+		if(found) {
+			//			std::cout << "Duplicate BRP found" << std::endl;
+			delete r;
+		} else {
+			// only-right-side rules are never isomorphic to the ones we check
+			if(doCheck) index.emplace(fp, ruleStore.size());
+			ruleStore.push_back(p);
+			if(verbose) {
+				logger.indent() << "BoundRules: added <" << r->getName() << ", {";
+				for(const auto *g : p.boundGraphs)
+					logger.s << " " << g->getName();
+				logger.s << " }> onlyRight: " << std::boolalpha << r->isOnlySide(lib::Rules::Membership::R)
+				         << std::endl;
+			}
+		}
+	}
+
+private:
+	const bool verbose;
+	IO::Logger logger;
+	const LabelType labelType;
+	const bool withStereo;
+	std::vector<BoundRule> &ruleStore;
+	const BoundRule &rule;
+	const lib::Graph::Single *graph;
+	// fingerprint -> index in ruleStore
+	std::unordered_multimap<std::size_t, std::size_t> index;
+};
+
+
 } // namespace mod::lib::DG
 
 #endif // MOD_LIB_DG_RULEAPPLICATIONUTILS_HPP
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "BindHistory.hpp"
+
+#include <mod/Config.hpp>
+#include <mod/lib/Algorithm/Parallel.hpp>
+#include <mod/lib/DG/Strategies/GraphState.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace mod::lib::DG::Strategies {
+
+void BindHistory::addExecution(const GraphState &input) {
+	for(const auto *g : input.getUniverse())
+		executions.emplace(g, std::make_pair(numExecutions, -1));
+	for(const auto *g : input.getSubset()) {
+		assert(executions.find(g) != executions.end());
+		executions[g].second = numExecutions;
+	}
+	++numExecutions;
+}
+
+bool BindHistory::wasTried(const std::vector<const lib::Graph::Single *> &graphs, const lib::Graph::Single *g) const {
+	// it was tried in execution i iff all graphs were in universe i and one of them was in subset i,
+	// and as the universes only grow, that is iff firstUniverse <= i for the latest of those i
+	int firstUniverse = -1, lastSubset = -1;
+	const auto add = [&](const lib::Graph::Single *g) {
+		const auto iter = executions.find(g);
+		if(iter == executions.end()) return false;
+		firstUniverse = std::max(firstUniverse, iter->second.first);
+		lastSubset = std::max(lastSubset, iter->second.second);
+		return true;
+	};
+	if(!add(g)) return false;
+	for(const auto *gOther : graphs)
+		if(!add(gOther)) return false;
+	if(lastSubset < firstUniverse) return false;
+	// the rule strategies of a parallel strategy may ask concurrently
+	incrementConcurrently(getConfig().dg.numSemiNaiveSkips());
+	return true;
+}
+
+} // namespace mod::lib::DG::Strategies
@@ -0,0 +1,33 @@
+#ifndef MOD_LIB_DG_STRATEGIES_BINDHISTORY_HPP
+#define MOD_LIB_DG_STRATEGIES_BINDHISTORY_HPP
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mod::lib::Graph {
+struct Single;
+} // namespace mod::lib::Graph
+namespace mod::lib::DG::Strategies {
+struct GraphState;
+
+// The inputs of earlier executions of a rule strategy, for semi-naive evaluation in a repeat strategy.
+// A rule strategy tries each tuple of graphs from its input universe with at least one graph from its input subset,
+// so a tuple has been tried before if in some earlier execution all its graphs were in the universe,
+// and one of them was in the subset.
+// The universes of the executions must only grow.
+struct BindHistory {
+	// Records an execution with the given input.
+	void addExecution(const GraphState &input);
+	// Whether the tuple of the given graphs and g has been tried in a recorded execution.
+	// Each true result is counted in config.dg.numSemiNaiveSkips.
+	bool wasTried(const std::vector<const lib::Graph::Single *> &graphs, const lib::Graph::Single *g) const;
+private:
+	int numExecutions = 0;
+	// for each graph, the first execution with it in the universe and the last with it in the subset, or -1
+	std::unordered_map<const lib::Graph::Single *, std::pair<int, int>> executions;
+};
+
+} // namespace mod::lib::DG::Strategies
+
+#endif // MOD_LIB_DG_STRATEGIES_BINDHISTORY_HPP
@@ -0,0 +1,267 @@
+#include "ConcurrentExecutionEnv.hpp"
+
+#include <mod/Error.hpp>
+#include <mod/graph/Graph.hpp>
+#include <mod/lib/Graph/Collection.hpp>
+#include <mod/lib/Graph/Single.hpp>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+
+namespace mod::lib::DG::Strategies {
+
+struct ConcurrentExecutionEnv::Event {
+	std::size_t lane;
+	std::shared_ptr<graph::Graph> product; // if not null, then a product, otherwise a derivation
+	std::vector<const lib::Graph::Single *> src, tar;
+	const lib::Rules::Real *r = nullptr;
+	std::function<void()> onNew;
+};
+
+struct ConcurrentExecutionEnv::ProductEntry {
+	std::size_t lane;
+	std::shared_ptr<graph::Graph> g;
+};
+
+struct ConcurrentExecutionEnv::DerivationEntry {
+	std::size_t lane;
+	GraphMultiset src, tar;
+	const lib::Rules::Real *r;
+};
+
+namespace {
+
+std::size_t hashDerivation(const GraphMultiset &gmsSrc, const GraphMultiset &gmsTar) {
+	std::size_t res = std::hash<GraphMultiset>()(gmsSrc);
+	boost::hash_combine(res, std::hash<GraphMultiset>()(gmsTar));
+	return res;
+}
+
+} // namespace
+
+struct ConcurrentExecutionEnv::Lane : ExecutionEnv {
+	Lane(ConcurrentExecutionEnv &owner, std::size_t index)
+			: ExecutionEnv(owner.parent.labelSettings, owner.parent.graphAsRuleCache, owner.parent.bindCache),
+			  owner(owner), index(index),
+			  isoSettings(labelSettings.type, LabelRelation::Isomorphism,
+			              labelSettings.withStereo, LabelRelation::Isomorphism) {}
+
+	void tryAddGraph(std::shared_ptr<graph::Graph> g) override {
+		MOD_ABORT; // only rule strategies are executed in lanes
+	}
+
+	bool trustAddGraph(std::shared_ptr<graph::Graph> g) override {
+		MOD_ABORT;
+	}
+
+	bool trustAddGraphAsVertex(std::shared_ptr<graph::Graph> g) override {
+		MOD_ABORT;
+	}
+
+	bool doExit() const override {
+		return owner.parent.doExit();
+	}
+
+	// the predicates of the parent are native, see Parallel::canExecuteConcurrently
+	bool checkLeftPredicate(const mod::Derivation &d) const override {
+		return owner.parent.checkLeftPredicate(d);
+	}
+
+	bool checkRightPredicate(const mod::Derivation &d) const override {
+		return owner.parent.checkRightPredicate(d);
+	}
+
+	std::shared_ptr<graph::Graph> checkIfNew(std::unique_ptr<lib::Graph::Single> g) const override {
+		const auto indexKey = getGraphIndexKey(*g);
+		return checkIfNew(std::move(g), indexKey);
+	}
+
+	std::shared_ptr<graph::Graph>
+	checkIfNew(std::unique_ptr<lib::Graph::Single> g, std::size_t indexKey) const override {
+		std::vector<std::shared_ptr<graph::Graph>> found;
+		{
+			auto &shard = owner.products[indexKey % NumShards];
+			std::scoped_lock lock(shard.mtx);
+			const auto range = shard.entries.equal_range(indexKey);
+			for(auto iter = range.first; iter != range.second; ++iter)
+				if(iter->second.lane <= index)
+					found.push_back(iter->second.g);
+		}
+		// the products were prepared for concurrent isomorphism checks when they were published
+		for(const auto &gFound: found)
+			if(lib::Graph::Single::isomorphic(*g, gFound->getGraph(), isoSettings))
+				return gFound;
+		const lib::Graph::Single *gCand = g.get();
+		auto res = owner.parent.checkIfNew(std::move(g), indexKey);
+		if(&res->getGraph() == gCand) candidates.emplace(gCand, indexKey);
+		return res;
+	}
+
+	std::size_t getGraphIndexKey(const lib::Graph::Single &g) const override {
+		return owner.parent.getGraphIndexKey(g);
+	}
+
+	std::shared_ptr<graph::Graph> findIsomorphic(std::shared_ptr<graph::Graph> g) const override {
+		MOD_ABORT;
+	}
+
+	void prepareForConcurrentCheckIfNew() override {
+		MOD_ABORT;
+	}
+
+	bool addProduct(std::shared_ptr<graph::Graph> g) override {
+		const auto iter = candidates.find(&g->getGraph());
+		if(iter == candidates.end()) return false;
+		const auto indexKey = iter->second;
+		candidates.erase(iter);
+		lib::Graph::Collection::prepareForConcurrentLookup(g->getGraph(), isoSettings);
+		{
+			auto &shard = owner.products[indexKey % NumShards];
+			std::scoped_lock lock(shard.mtx);
+			shard.entries.emplace(indexKey, ProductEntry{index, g});
+		}
+		owner.events.append(Event{index, g, {}, {}, nullptr, nullptr});
+		return true;
+	}
+
+	// Exact for the parent and this lane, but it may or may not see the derivations of the lanes before this one.
+	bool isDerivation(const GraphMultiset &gmsSrc,
+	                  const GraphMultiset &gmsTar,
+	                  const lib::Rules::Real *r) const override {
+		if(owner.parent.isDerivation(gmsSrc, gmsTar, r)) return true;
+		const auto key = hashDerivation(gmsSrc, gmsTar);
+		auto &shard = owner.derivations[key % NumShards];
+		std::scoped_lock lock(shard.mtx);
+		const auto range = shard.entries.equal_range(key);
+		for(auto iter = range.first; iter != range.second; ++iter) {
+			const auto &e = iter->second;
+			if(e.lane <= index && e.r == r && e.src == gmsSrc && e.tar == gmsTar)
+				return true;
+		}
+		return false;
+	}
+
+	// Only the derivations of the parent, i.e., not those suggested by the lanes in this execution.
+	std::vector<GraphMultiset>
+	findDerivationTargets(const GraphMultiset &gmsSrc, const lib::Rules::Real *r) const override {
+		return owner.parent.findDerivationTargets(gmsSrc, r);
+	}
+
+	void suggestDerivation(const GraphMultiset &gmsSrc, const GraphMultiset &gmsTar, const lib::Rules::Real *r,
+	                       std::function<void()> onNew) override {
+		{
+			const auto key = hashDerivation(gmsSrc, gmsTar);
+			auto &shard = owner.derivations[key % NumShards];
+			std::scoped_lock lock(shard.mtx);
+			shard.entries.emplace(key, DerivationEntry{index, gmsSrc, gmsTar, r});
+		}
+		owner.events.append(Event{index, nullptr,
+		                          std::vector<const lib::Graph::Single *>(gmsSrc.begin(), gmsSrc.end()),
+		                          std::vector<const lib::Graph::Single *>(gmsTar.begin(), gmsTar.end()),
+		                          r, std::move(onNew)});
+	}
+
+	bool hasOnlyNativePredicates() const override {
+		return owner.parent.hasOnlyNativePredicates();
+	}
+
+	void pushLeftPredicate(std::shared_ptr<mod::Function<bool(const mod::Derivation &)> > pred) override {
+		MOD_ABORT;
+	}
+
+	void pushRightPredicate(std::shared_ptr<mod::Function<bool(const mod::Derivation &)> > pred) override {
+		MOD_ABORT;
+	}
+
+	void popLeftPredicate() override {
+		MOD_ABORT;
+	}
+
+	void popRightPredicate() override {
+		MOD_ABORT;
+	}
+
+	unsigned int getNumThreads() const override {
+		return 1; // the other lanes already use the threads
+	}
+public:
+	ConcurrentExecutionEnv &owner;
+	const std::size_t index;
+	const LabelSettings isoSettings;
+	std::size_t numIdsTaken = 0;
+	bool hasRun = false;
+	// the graphs created in this lane which are not in the graph database, and not yet products
+	mutable std::unordered_map<const lib::Graph::Single *, std::size_t> candidates;
+};
+
+ConcurrentExecutionEnv::ConcurrentExecutionEnv(ExecutionEnv &parent, std::size_t numLanes)
+		: parent(parent), firstId(lib::Graph::Single::reserveIds(0)) {
+	for(std::size_t i = 0; i != numLanes; ++i)
+		lanes.push_back(std::make_unique<Lane>(*this, i));
+}
+
+ConcurrentExecutionEnv::~ConcurrentExecutionEnv() = default;
+
+ExecutionEnv &ConcurrentExecutionEnv::getLane(std::size_t lane) {
+	assert(lane < lanes.size());
+	return *lanes[lane];
+}
+
+void ConcurrentExecutionEnv::runLane(std::size_t lane, std::function<void()> f) {
+	assert(lane < lanes.size());
+	auto &l = *lanes[lane];
+	assert(!l.hasRun);
+	l.hasRun = true;
+	// the temporary ids are above all real ids and in lane order
+	lib::Graph::Single::IdRange ids(firstId + lane * lib::Graph::Single::IdRange::Size);
+	f();
+	l.numIdsTaken = ids.getNumTaken();
+}
+
+void ConcurrentExecutionEnv::commit(
+		std::unordered_map<const lib::Graph::Single *, const lib::Graph::Single *> &replacements) {
+	// the events of each lane were appended by a single thread, so a stable sort restores the serial order
+	std::vector<std::size_t> order(events.size());
+	for(std::size_t i = 0; i != order.size(); ++i) order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+		return events[a].lane < events[b].lane;
+	});
+	// The serial id of a graph is its offset in the lane plus the number of ids taken by the lanes before.
+	// The ids are only reserved now, as other threads may have taken ids since firstId, e.g., for other DGs.
+	std::size_t numIdsTaken = 0;
+	for(const auto &l : lanes) numIdsTaken += l->numIdsTaken;
+	std::vector<std::size_t> idOffset(lanes.size() + 1, lib::Graph::Single::reserveIds(numIdsTaken));
+	for(std::size_t i = 0; i != lanes.size(); ++i)
+		idOffset[i + 1] = idOffset[i] + lanes[i]->numIdsTaken;
+
+	const auto map = [&replacements](std::vector<const lib::Graph::Single *> gs) {
+		for(auto &g: gs) {
+			const auto iter = replacements.find(g);
+			if(iter != replacements.end()) g = iter->second;
+		}
+		return GraphMultiset(std::move(gs));
+	};
+	for(const std::size_t i: order) {
+		Event &e = events[i];
+		if(e.product) {
+			const auto found = parent.findIsomorphic(e.product);
+			if(found) {
+				replacements.emplace(&e.product->getGraph(), &found->getGraph());
+			} else {
+				auto &g = const_cast<lib::Graph::Single &>(e.product->getGraph());
+				g.renumber(g.getId() - (firstId + e.lane * lib::Graph::Single::IdRange::Size) + idOffset[e.lane]);
+				const bool isNew = parent.addProduct(e.product);
+				assert(isNew);
+				(void) isNew;
+			}
+			e.product.reset();
+		} else {
+			parent.suggestDerivation(map(std::move(e.src)), map(std::move(e.tar)), e.r, std::move(e.onNew));
+		}
+	}
+	for(auto &shard: products) shard.entries.clear();
+	for(auto &shard: derivations) shard.entries.clear();
+}
+
+} // namespace mod::lib::DG::Strategies
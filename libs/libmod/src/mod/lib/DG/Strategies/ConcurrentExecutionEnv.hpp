@@ -0,0 +1,68 @@
+#ifndef MOD_LIB_DG_STRATEGIES_CONCURRENTEXECUTIONENV_HPP
+#define MOD_LIB_DG_STRATEGIES_CONCURRENTEXECUTIONENV_HPP
+
+#include <mod/lib/Algorithm/AppendLog.hpp>
+#include <mod/lib/DG/Strategies/Strategy.hpp>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mod::lib::DG::Strategies {
+
+// An execution environment for strategies executed concurrently, each in its own lane,
+// on top of a parent environment, e.g., the one of a NonHyperBuilder.
+// The graph database and the DG of the parent are only read while the lanes are running,
+// after prepareForConcurrentCheckIfNew has been called on the parent.
+// The products and derivations of the lanes are collected in thread-safe structures,
+// and added to the parent by commit, lane by lane,
+// so the result is the same as if the lanes were executed serially in order:
+// - The products are in a collection sharded by their index key, each shard with its own lock.
+//   A lane may find the products of the lanes before it, but never those of the lanes after it.
+// - The products and derivations are recorded in a lock-free append log.
+// - The derivations are also in a sharded map for isDerivation.
+// Only rule strategies can be executed in a lane, the predicates of the parent must be native,
+// and the functions of the parent which add graphs directly are not available.
+struct ConcurrentExecutionEnv {
+	ConcurrentExecutionEnv(ExecutionEnv &parent, std::size_t numLanes);
+	ConcurrentExecutionEnv(const ConcurrentExecutionEnv &) = delete;
+	ConcurrentExecutionEnv &operator=(const ConcurrentExecutionEnv &) = delete;
+	~ConcurrentExecutionEnv();
+	// The environment of the given lane.
+	ExecutionEnv &getLane(std::size_t lane);
+	// Calls f in the calling thread as lane 'lane', where f should use the environment from getLane(lane).
+	// The graphs created by f get temporary ids, which are made serial again by commit.
+	// Different lanes may be run concurrently, but each lane must only be run once.
+	void runLane(std::size_t lane, std::function<void()> f);
+	// Adds the products and derivations of all lanes to the parent, in lane order.
+	// The products that turned out to be isomorphic to graphs already in the parent are added to 'replacements',
+	// mapped to those graphs.
+	// It must not be called while lanes are running.
+	void commit(std::unordered_map<const lib::Graph::Single *, const lib::Graph::Single *> &replacements);
+private:
+	struct Lane;
+	struct Event;
+	struct ProductEntry;
+	struct DerivationEntry;
+	static constexpr std::size_t NumShards = 64;
+	template<typename Entry>
+	struct Shard {
+		std::mutex mtx;
+		std::unordered_multimap<std::size_t, Entry> entries;
+	};
+private:
+	ExecutionEnv &parent;
+	std::vector<std::unique_ptr<Lane>> lanes;
+	// the base of the temporary ids of the lanes, see commit for their real ids
+	const std::size_t firstId;
+	AppendLog<Event> events;
+	std::array<Shard<ProductEntry>, NumShards> products; // by index key
+	std::array<Shard<DerivationEntry>, NumShards> derivations; // by a hash of the multisets
+};
+
+} // namespace mod::lib::DG::Strategies
+
+#endif // MOD_LIB_DG_STRATEGIES_CONCURRENTEXECUTIONENV_HPP
@@ -70,6 +70,29 @@ bool GraphState::isInUniverse(const lib::Graph::Single *g) const {
 	return false;
 }
 
+void GraphState::replaceGraphs(
+		const std::unordered_map<const lib::Graph::Single *, const lib::Graph::Single *> &replacements) {
+	// an image may already be in the universe, so merge such duplicates
+	std::vector<int> oldToNew(universe.size());
+	GraphList newUniverse;
+	std::unordered_map<const lib::Graph::Single *, int> newIndex;
+	for(int i = 0; i != universe.size(); i++) {
+		const auto iter = replacements.find(universe[i]);
+		const auto *g = iter == replacements.end() ? universe[i] : iter->second;
+		const auto res = newIndex.emplace(g, newUniverse.size());
+		if(res.second) newUniverse.push_back(g);
+		oldToNew[i] = res.first->second;
+	}
+	std::swap(universe, newUniverse);
+	std::vector<int> newIndices;
+	for(int index : subset.indices) {
+		const int indexNew = oldToNew[index];
+		if(std::find(newIndices.begin(), newIndices.end(), indexNew) == newIndices.end())
+			newIndices.push_back(indexNew);
+	}
+	std::swap(subset.indices, newIndices);
+}
+
 bool operator==(const GraphState &a, const GraphState &b) {
 	if(a.universe.size() != b.universe.size()) return false;
 	if(a.subset.size() != b.subset.size()) return false;
@@ -76,6 +76,8 @@ public:
 	const Subset &getSubset() const;
 	const GraphList &getUniverse() const;
 	bool isInUniverse(const lib::Graph::Single *g) const;
+	// Each graph in the map is replaced by its image.
+	void replaceGraphs(const std::unordered_map<const lib::Graph::Single *, const lib::Graph::Single *> &replacements);
 	friend bool operator==(const GraphState &a, const GraphState &b);
 private:
 	int addUniverseGetIndex(const lib::Graph::Single *g);
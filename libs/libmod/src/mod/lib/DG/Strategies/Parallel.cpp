@@ -1,9 +1,17 @@
 #include "Parallel.hpp"
 
 #include <mod/Config.hpp>
+#include <mod/rule/Rule.hpp>
+#include <mod/lib/Algorithm/Parallel.hpp>
+#include <mod/lib/DG/RuleApplicationUtils.hpp>
+#include <mod/lib/DG/Strategies/ConcurrentExecutionEnv.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
+#include <mod/lib/DG/Strategies/Rule.hpp>
 #include <mod/lib/Graph/Single.hpp>
 #include <mod/lib/IO/IO.hpp>
+#include <mod/lib/RC/ComposeRuleReal.hpp>
+
+#include <unordered_map>
 
 namespace mod::lib::DG::Strategies {
 
@@ -46,24 +54,81 @@ bool Parallel::isConsumed(const Graph::Single *g) const {
 	return false;
 }
 
+bool Parallel::setBindHistory(const BindHistory *history) {
+	// all substrategies get the same input as this strategy
+	bool res = true;
+	for(auto &s : strats)
+		res = s->setBindHistory(history) && res;
+	return res;
+}
+
 void Parallel::setExecutionEnvImpl() {
 	for(auto &s : strats) s->setExecutionEnv(getExecutionEnv());
 }
 
-void Parallel::executeImpl(PrintSettings settings, const GraphState &input) {
-	if(settings.verbosity >= PrintSettings::V_Parallel) {
-		settings.indent() << "Parallel: " << strats.size() << " substrategies" << std::endl;
-		++settings.indentLevel;
+bool Parallel::canExecuteConcurrently(PrintSettings settings) {
+	if(strats.size() < 2) return false;
+	if(resolveNumThreads(getExecutionEnv().getNumThreads()) < 2) return false;
+	// the substrategies must not log, and the predicates must not call back into e.g. Python
+	if(settings.verbosity >= PrintSettings::V_Parallel) return false;
+	if(!getExecutionEnv().hasOnlyNativePredicates()) return false;
+	const auto ls = getExecutionEnv().labelSettings;
+	if(ls.withStereo || !canBindConcurrently(settings.ruleApplicationVerbosity(), ls)) return false;
+	for(const auto &s : strats)
+		if(!dynamic_cast<Rule *>(s.get())) return false;
+	return true;
+}
+
+void Parallel::executeConcurrently(PrintSettings settings, const GraphState &input) {
+	auto &env = getExecutionEnv();
+	// make everything the substrategies share ready for concurrent use
+	env.prepareForConcurrentCheckIfNew();
+	for(const auto *g : input.getUniverse())
+		lib::RC::prepareForConcurrentComposition(env.graphAsRuleCache.getBindRule(g)->getRule(), env.labelSettings);
+	forEachRule([&env](const lib::Rules::Real &r) {
+		lib::RC::prepareForConcurrentComposition(r, env.labelSettings);
+	});
+
+	ConcurrentExecutionEnv lanes(env, strats.size());
+	try {
+		for(unsigned int i = 0; i != strats.size(); i++)
+			strats[i]->setExecutionEnv(lanes.getLane(i));
+		parallelFor(env.getNumThreads(), strats.size(), [&](std::size_t i) {
+			lanes.runLane(i, [&]() {
+				strats[i]->execute(settings, input);
+			});
+		});
+	} catch(...) {
+		setExecutionEnvImpl();
+		throw;
 	}
-	for(unsigned int i = 0; i != strats.size(); i++) {
-		auto &s = strats[i];
+	setExecutionEnvImpl();
+
+	std::unordered_map<const lib::Graph::Single *, const lib::Graph::Single *> replacements;
+	lanes.commit(replacements);
+	// later substrategies may also use the products of earlier ones
+	for(auto &s : strats)
+		static_cast<Rule &>(*s).replaceOutputGraphs(replacements);
+}
+
+void Parallel::executeImpl(PrintSettings settings, const GraphState &input) {
+	if(canExecuteConcurrently(settings)) {
+		executeConcurrently(settings, input);
+	} else {
 		if(settings.verbosity >= PrintSettings::V_Parallel) {
-			settings.indent() << "Parallel, substrategy " << (i + 1) << ":" << std::endl;
+			settings.indent() << "Parallel: " << strats.size() << " substrategies" << std::endl;
 			++settings.indentLevel;
 		}
-		s->execute(settings, input);
-		if(settings.verbosity >= PrintSettings::V_Parallel)
-			--settings.indentLevel;
+		for(unsigned int i = 0; i != strats.size(); i++) {
+			auto &s = strats[i];
+			if(settings.verbosity >= PrintSettings::V_Parallel) {
+				settings.indent() << "Parallel, substrategy " << (i + 1) << ":" << std::endl;
+				++settings.indentLevel;
+			}
+			s->execute(settings, input);
+			if(settings.verbosity >= PrintSettings::V_Parallel)
+				--settings.indentLevel;
+		}
 	}
 	std::vector<const GraphState *> outputs;
 	for(const auto &s : strats) outputs.push_back(&s->getOutput());
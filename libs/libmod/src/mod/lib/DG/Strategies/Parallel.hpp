@@ -16,9 +16,15 @@ struct Parallel : Strategy {
 	virtual void forEachRule(std::function<void(const lib::Rules::Real&)> f) const override;
 	virtual void printInfo(PrintSettings settings) const override;
 	virtual bool isConsumed(const lib::Graph::Single *g) const override;
+	virtual bool setBindHistory(const BindHistory *history) override;
 private:
 	virtual void setExecutionEnvImpl() override;
 	virtual void executeImpl(PrintSettings settings, const GraphState &input) override;
+	// The substrategies can be executed concurrently, each in a lane of a ConcurrentExecutionEnv,
+	// if they are all rule strategies, and neither predicates, logging, nor stereo information is involved.
+	// The result is the same as when executed serially.
+	bool canExecuteConcurrently(PrintSettings settings);
+	void executeConcurrently(PrintSettings settings, const GraphState &input);
 private:
 	std::vector<std::unique_ptr<Strategy>> strats;
 };
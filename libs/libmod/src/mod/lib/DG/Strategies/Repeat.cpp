@@ -1,6 +1,7 @@
 #include "Repeat.hpp"
 
 #include <mod/Config.hpp>
+#include <mod/lib/DG/Strategies/BindHistory.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
 
 #include <ostream>
@@ -61,18 +62,30 @@ void Repeat::executeImpl(PrintSettings settings, const GraphState &input) {
 		settings.indent() << "Repeat, limit = " << limit << std::endl;
 	assert(limit >= 0);
 	++settings.indentLevel;
+	// With semi-naive evaluation the rule strategies only try the tuples of graphs not tried in earlier rounds.
+	// Those would only give derivations which are in the DG already, so their products are put in the subset from there.
+	// Without putAllProductsInSubset the subset only has graphs which were not in the universe in the earlier rounds,
+	// so no tuple would be skipped.
+	BindHistory history;
+	bool semiNaive = getConfig().dg.semiNaiveRepeat.get() && getConfig().dg.putAllProductsInSubset.get();
 	for(int i = 0; i != limit; ++i) {
 		{
 			auto subStrat = strat->clone();
 			subStrat->setExecutionEnv(getExecutionEnv());
+			if(semiNaive && !subStrat->setBindHistory(&history)) {
+				subStrat->setBindHistory(nullptr);
+				semiNaive = false;
+			}
 			if(settings.verbosity >= PrintSettings::V_Repeat)
 				settings.indent() << "Round " << (i + 1) << ":" << std::endl;
 			++settings.indentLevel;
-			if(i == 0)
-				subStrat->execute(settings, input);
-			else
-				subStrat->execute(settings, subStrats[i - 1]->getOutput());
+			const GraphState &roundInput = i == 0 ? input : subStrats[i - 1]->getOutput();
+			subStrat->execute(settings, roundInput);
 			--settings.indentLevel;
+			if(semiNaive) {
+				subStrat->setBindHistory(nullptr);
+				history.addExecution(roundInput);
+			}
 
 			if(settings.verbosity >= PrintSettings::V_Repeat) {
 				settings.indent() << "Round " << (i + 1) << ": Result subset has "
@@ -4,12 +4,18 @@
 #include <mod/Derivation.hpp>
 #include <mod/Misc.hpp>
 #include <mod/rule/Rule.hpp>
+#include <mod/lib/DG/DirectRuleApplication.hpp>
 #include <mod/lib/DG/RuleApplicationUtils.hpp>
+#include <mod/lib/DG/Strategies/BindHistory.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
 #include <mod/lib/IO/IO.hpp>
 #include <mod/lib/RC/ComposeRuleReal.hpp>
 #include <mod/lib/RC/MatchMaker/Super.hpp>
 
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace mod::lib::DG::Strategies {
 
 Rule::Rule(std::shared_ptr<rule::Rule> r)
@@ -53,6 +59,17 @@ bool Rule::isConsumed(const lib::Graph::Single *g) const {
 	return consumedGraphs.find(g) != consumedGraphs.end();
 }
 
+bool Rule::setBindHistory(const BindHistory *history) {
+	bindHistory = history;
+	return true;
+}
+
+void Rule::replaceOutputGraphs(
+		const std::unordered_map<const lib::Graph::Single *, const lib::Graph::Single *> &replacements) {
+	assert(output);
+	output->replaceGraphs(replacements);
+}
+
 namespace {
 
 struct Context {
@@ -62,35 +79,33 @@ struct Context {
 	std::unordered_set<const lib::Graph::Single *> &consumedGraphs;
 };
 
-void handleBoundRulePair(int verbosity, IO::Logger logger, Context context, const BoundRule &brp) {
-	assert(brp.rule);
-	// TODO: use a smart pointer so the rule for sure is deallocated, even though we do a 'continue'
-	const lib::Rules::Real &r = *brp.rule;
-	const auto &rDPO = r.getDPORule();
-	assert(r.isOnlyRightSide()); // otherwise, it should have been deallocated.
-	// All max component results should be only right side
+// The products are made by makeProducts after the left predicate has accepted the derivation.
+void handleDerivation(int verbosity, IO::Logger logger, Context context, const std::string &name,
+                      const std::vector<const lib::Graph::Single *> &educts,
+                      const std::function<ProductCandidates()> &makeProducts) {
 	mod::Derivation d;
 	d.r = context.r;
-	for(const lib::Graph::Single *g: brp.boundGraphs) d.left.push_back(g->getAPIReference());
+	for(const lib::Graph::Single *g: educts) d.left.push_back(g->getAPIReference());
 	{ // left predicate
 		bool result = context.executionEnv.checkLeftPredicate(d);
 		if(!result) {
 			if(verbosity >= PrintSettings::V_DerivationPredicatesFail)
-				logger.indent() << "Skipping " << r.getName() << " due to leftPredicate" << std::endl;
+				logger.indent() << "Skipping " << name << " due to leftPredicate" << std::endl;
 			return;
 		}
 	}
+	ProductCandidates products = makeProducts();
 	if(verbosity >= PrintSettings::V_RuleApplication) {
-		logger.indent() << "Splitting " << r.getName() << " into "
-		                << get_num_connected_components(get_labelled_right(rDPO))
+		logger.indent() << "Splitting " << name << " into "
+		                << products.graphs.size()
 		                << " graphs" << std::endl;
 		++logger.indentLevel;
 	}
-	const std::vector<const lib::Graph::Single *> &educts = brp.boundGraphs;
 	d.right = splitRule(
-			rDPO, context.executionEnv.labelSettings.type, context.executionEnv.labelSettings.withStereo,
-			[&context](std::unique_ptr<lib::Graph::Single> gCand) {
-				return context.executionEnv.checkIfNew(std::move(gCand));
+			std::move(products), context.executionEnv.labelSettings.type,
+			context.executionEnv.labelSettings.withStereo,
+			[&context](std::unique_ptr<lib::Graph::Single> gCand, std::size_t indexKey) {
+				return context.executionEnv.checkIfNew(std::move(gCand), indexKey);
 			},
 			[verbosity, &logger](std::shared_ptr<graph::Graph> gWrapped, std::shared_ptr<graph::Graph> gPrev) {
 				if(verbosity >= PrintSettings::V_RuleApplication)
@@ -114,7 +129,7 @@ void handleBoundRulePair(int verbosity, IO::Logger logger, Context context, cons
 		bool result = context.executionEnv.checkRightPredicate(d);
 		if(!result) {
 			if(verbosity >= PrintSettings::V_DerivationPredicatesFail)
-				logger.indent() << "Skipping " << r.getName() << " due to rightPredicate" << std::endl;
+				logger.indent() << "Skipping " << name << " due to rightPredicate" << std::endl;
 			return;
 		}
 	}
@@ -135,13 +150,54 @@ void handleBoundRulePair(int verbosity, IO::Logger logger, Context context, cons
 	for(const std::shared_ptr<graph::Graph> &g: d.right)
 		rightGraphs.push_back(&g->getGraph());
 	lib::DG::GraphMultiset gmsLeft(educts), gmsRight(std::move(rightGraphs));
-	bool inserted = context.executionEnv.suggestDerivation(gmsLeft, gmsRight, &context.r->getRule());
-	if(inserted) {
-		for(const lib::Graph::Single *g: educts)
-			context.consumedGraphs.insert(g);
+	context.executionEnv.suggestDerivation(gmsLeft, gmsRight, &context.r->getRule(),
+	                                       [&consumedGraphs = context.consumedGraphs, educts]() {
+		                                       for(const lib::Graph::Single *g: educts)
+			                                       consumedGraphs.insert(g);
+	                                       });
+}
+
+// With putAllProductsInSubset the tuples of educts skipped due to the bind history would still have put
+// their products in the subset. The derivations were found when the tuple was tried, so they are taken from the DG.
+void replayDerivations(int verbosity, IO::Logger logger, Context context,
+                       const std::vector<const lib::Graph::Single *> &educts, const lib::DG::GraphMultiset &gmsLeft) {
+	for(const auto &gmsRight: context.executionEnv.findDerivationTargets(gmsLeft, &context.r->getRule())) {
+		mod::Derivation d;
+		d.r = context.r;
+		for(const lib::Graph::Single *g: educts) d.left.push_back(g->getAPIReference());
+		if(!context.executionEnv.checkLeftPredicate(d)) {
+			if(verbosity >= PrintSettings::V_DerivationPredicatesFail)
+				logger.indent() << "Skipping replay of " << context.r->getName() << " due to leftPredicate" << std::endl;
+			continue;
+		}
+		for(const lib::Graph::Single *g: gmsRight) d.right.push_back(g->getAPIReference());
+		if(!context.executionEnv.checkRightPredicate(d)) {
+			if(verbosity >= PrintSettings::V_DerivationPredicatesFail)
+				logger.indent() << "Skipping replay of " << context.r->getName() << " due to rightPredicate" << std::endl;
+			continue;
+		}
+		for(const lib::Graph::Single *g: gmsRight)
+			context.output->addToSubset(g);
 	}
 }
 
+// If the products are not given, they are made after the left predicate has accepted the derivation.
+void handleBoundRulePair(int verbosity, IO::Logger logger, Context context, const BoundRule &brp,
+                         std::optional<ProductCandidates> products) {
+	assert(brp.rule);
+	// TODO: use a smart pointer so the rule for sure is deallocated, even though we do a 'continue'
+	const lib::Rules::Real &r = *brp.rule;
+	assert(r.isOnlyRightSide()); // otherwise, it should have been deallocated.
+	// All max component results should be only right side
+	handleDerivation(verbosity, logger, context, r.getName(), brp.boundGraphs, [&]() {
+		if(products) return commitProductCandidates(std::move(*products));
+		return makeProductCandidates(r.getDPORule(), context.executionEnv.labelSettings.withStereo,
+		                             [&context](const lib::Graph::Single &g) {
+			                             return context.executionEnv.getGraphIndexKey(g);
+		                             });
+	});
+}
+
 template<typename GraphRange>
 unsigned int bindGraphs(PrintSettings settings, Context context,
                         const GraphRange &graphRange,
@@ -179,7 +235,7 @@ unsigned int bindGraphs(PrintSettings settings, Context context,
 				processedRules++;
 				if(context.executionEnv.doExit()) delete brp.rule;
 				else if(brp.rule->isOnlyRightSide()) {
-					handleBoundRulePair(settings.verbosity, settings, context, brp);
+					handleBoundRulePair(settings.verbosity, settings, context, brp, std::nullopt);
 					delete brp.rule;
 				} else outputRules.push_back(brp);
 			}
@@ -291,14 +347,88 @@ void Rule::executeImpl(PrintSettings settings, const GraphState &input) {
 
 		Context context{r, getExecutionEnv(), output, consumedGraphs};
 		std::vector<BoundRule> inputRules{{rRaw, {}, 0}};
-		for(int round = 0; round != get_num_connected_components(get_labelled_left(rRaw->getDPORule())); ++round) {
+		const int numRounds = get_num_connected_components(get_labelled_left(rRaw->getDPORule()));
+		// in the last round the tuples of graphs are complete, so the history can tell if they have been tried
+		SkipBinding skipTried;
+		if(bindHistory) {
+			skipTried = [bindHistory = bindHistory](const BoundRule &br, const lib::Graph::Single *g) {
+				return bindHistory->wasTried(br.boundGraphs, g);
+			};
+		}
+		// A multiset of educts may be skipped once for each of its bound rules,
+		// but the derivations are only replayed the first time, so the predicates are called once for each.
+		std::unordered_set<lib::DG::GraphMultiset> replayed;
+		std::function<void(const std::vector<const lib::Graph::Single *> &)> replay;
+		OnSkippedBinding replaySkipped;
+		if(bindHistory && getConfig().dg.putAllProductsInSubset.get()) {
+			replay = [verbosity = settings.verbosity, logger = IO::Logger(settings), &context, &replayed]
+					(const std::vector<const lib::Graph::Single *> &educts) {
+				lib::DG::GraphMultiset gmsLeft(educts);
+				if(replayed.insert(gmsLeft).second)
+					replayDerivations(verbosity, logger, context, educts, gmsLeft);
+			};
+			replaySkipped = [&replay](const BoundRule &br, const lib::Graph::Single *g) {
+				std::vector<const lib::Graph::Single *> educts = br.boundGraphs;
+				educts.push_back(g);
+				replay(educts);
+			};
+		}
+		if(getConfig().dg.useDirectRuleApplication.get()
+		   && canApplyDirectly(*rRaw, getExecutionEnv().labelSettings)) {
+			// applyDirectly asks in binding order, so the replay can be done right away
+			SkipEduct skipTriedEduct;
+			if(bindHistory) {
+				skipTriedEduct = [bindHistory = bindHistory, &replay](const std::vector<const lib::Graph::Single *> &educts,
+				                                                      const lib::Graph::Single *g) {
+					if(!bindHistory->wasTried(educts, g)) return false;
+					if(replay) {
+						auto allEducts = educts;
+						allEducts.push_back(g);
+						replay(allEducts);
+					}
+					return true;
+				};
+			}
+			applyDirectly(settings.ruleApplicationVerbosity(), settings, *rRaw, graphs, subsetEnd - graphs.begin(),
+			              [&executionEnv = getExecutionEnv()](const lib::Graph::Single &g) {
+				              return executionEnv.getGraphIndexKey(g);
+			              },
+			              skipTriedEduct,
+			              [verbosity = settings.verbosity, logger = IO::Logger(settings), &context, this]
+					              (const std::vector<const lib::Graph::Single *> &educts,
+					               const std::function<ProductCandidates()> &makeProducts) {
+				              if(context.executionEnv.doExit()) return;
+				              handleDerivation(verbosity, logger, context, rRaw->getName(), educts, makeProducts);
+			              });
+			return;
+		}
+		// bindGraphs uses the cache for the first round, and a graph which does not bind to the original rule
+		// does not bind in the later rounds either.
+		// The later rounds look up each graph only once, and the graphs of the first round are not counted again.
+		std::unordered_map<const lib::Graph::Single *, bool> knownEmpty;
+		const SkipBinding skipKnownEmpty = [rRaw = rRaw, &bindCache = getExecutionEnv().bindCache, &knownEmpty]
+				(const BoundRule &br, const lib::Graph::Single *g) {
+			const auto iter = knownEmpty.find(g);
+			if(iter != knownEmpty.end()) return iter->second;
+			return knownEmpty[g] = bindCache.isKnownEmpty(*rRaw, *g);
+		};
+		const SkipBinding skipKnownEmptyOrTried = [&skipTried, &skipKnownEmpty]
+				(const BoundRule &br, const lib::Graph::Single *g) {
+			return skipKnownEmpty(br, g) || (skipTried && skipTried(br, g));
+		};
+		const auto getSkip = [&](int round) -> const SkipBinding & {
+			static const SkipBinding none;
+			if(round + 1 == numRounds) return round == 0 ? skipTried : skipKnownEmptyOrTried;
+			else return round == 0 ? none : skipKnownEmpty;
+		};
+		for(int round = 0; round != numRounds; ++round) {
 			const auto firstGraph = graphs.begin();
 			const auto lastGraph = round == 0 ? subsetEnd : graphs.end();
 
 			const auto onOutput = [verbosity = settings.verbosity, context]
-					(IO::Logger logger, BoundRule br) -> bool {
+					(IO::Logger logger, BoundRule br, std::optional<ProductCandidates> products) -> bool {
 				if(br.rule->isOnlyRightSide()) {
-					handleBoundRulePair(verbosity, logger, context, br);
+					handleBoundRulePair(verbosity, logger, context, br, std::move(products));
 					delete br.rule;
 				}
 				return true;
@@ -308,12 +438,22 @@ void Rule::executeImpl(PrintSettings settings, const GraphState &input) {
 					round,
 					firstGraph, lastGraph, inputRules,
 					getExecutionEnv().graphAsRuleCache,
+					&getExecutionEnv().bindCache,
 					getExecutionEnv().labelSettings,
-					onOutput);
+					getExecutionEnv().getNumThreads(),
+					[&executionEnv = getExecutionEnv()](const lib::Graph::Single &g) {
+						return executionEnv.getGraphIndexKey(g);
+					},
+					onOutput,
+					getSkip(round),
+					round + 1 == numRounds ? replaySkipped : nullptr);
 			if(round != 0) {
 				// in round 0 the inputRules is the actual original input rule, so don't delete it
 				for(auto &br: inputRules)
 					delete br.rule;
+			} else if(numRounds != 1) {
+				for(auto iter = firstGraph; iter != lastGraph; ++iter)
+					knownEmpty[*iter] = getExecutionEnv().bindCache.isKnownEmpty(*rRaw, **iter, false);
 			}
 			std::swap(inputRules, outputRules);
 		} // for each round based on numComponents
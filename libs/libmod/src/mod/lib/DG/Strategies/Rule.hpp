@@ -3,6 +3,7 @@
 
 #include <mod/lib/DG/Strategies/Strategy.hpp>
 
+#include <unordered_map>
 #include <unordered_set>
 
 namespace mod::lib::DG::Strategies {
@@ -15,12 +16,17 @@ struct Rule : Strategy {
 	virtual void forEachRule(std::function<void(const lib::Rules::Real &)> f) const override;
 	virtual void printInfo(PrintSettings settings) const override;
 	virtual bool isConsumed(const lib::Graph::Single *g) const override;
+	// Replaces graphs in the output, e.g., products which turned out to be isomorphic to graphs in the DG.
+	void replaceOutputGraphs(const std::unordered_map<const lib::Graph::Single *, const lib::Graph::Single *> &replacements);
+	// Only the new rule application uses the history.
+	virtual bool setBindHistory(const BindHistory *history) override;
 private:
 	virtual void executeImpl(PrintSettings settings, const GraphState &input) override;
 private:
 	std::shared_ptr<rule::Rule> r;
 	const lib::Rules::Real *rRaw;
 	std::unordered_set<const lib::Graph::Single *> consumedGraphs; // all those from lhs of derivations
+	const BindHistory *bindHistory = nullptr;
 };
 
 } // namespace mod::lib::DG::Strategies
@@ -68,6 +68,10 @@ void Strategy::printBaseInfo(PrintSettings settings) const {
 	s << '\n';
 }
 
+bool Strategy::setBindHistory(const BindHistory *history) {
+	return false;
+}
+
 void Strategy::setExecutionEnvImpl() {}
 
 //------------------------------------------------------------------------------
@@ -2,19 +2,22 @@
 #define MOD_LIB_DG_STRATEGIES_STRATEGY_HPP
 
 #include <mod/dg/Strategies.hpp>
+#include <mod/lib/DG/BindCache.hpp>
 #include <mod/lib/DG/NonHyper.hpp>
 #include <mod/lib/IO/IO.hpp>
 #include <mod/lib/Rules/GraphAsRuleCache.hpp>
 
+#include <functional>
 #include <iosfwd>
 #include <vector>
 
 namespace mod::lib::DG::Strategies {
+struct BindHistory;
 class GraphState;
 
 struct ExecutionEnv {
-	ExecutionEnv(LabelSettings labelSettings, Rules::GraphAsRuleCache &graphAsRuleCache)
-			: labelSettings(labelSettings), graphAsRuleCache(graphAsRuleCache) {}
+	ExecutionEnv(LabelSettings labelSettings, Rules::GraphAsRuleCache &graphAsRuleCache, BindCache &bindCache)
+			: labelSettings(labelSettings), graphAsRuleCache(graphAsRuleCache), bindCache(bindCache) {}
 	virtual ~ExecutionEnv() {};
 	// May throw LogicError if exists.
 	virtual void tryAddGraph(std::shared_ptr<graph::Graph> g) = 0;
@@ -26,18 +29,37 @@ struct ExecutionEnv {
 	// but here everything is defined
 	virtual bool checkRightPredicate(const mod::Derivation &d) const = 0;
 	virtual std::shared_ptr<graph::Graph> checkIfNew(std::unique_ptr<lib::Graph::Single> g) const = 0;
+	// with indexKey == getGraphIndexKey(*g)
+	virtual std::shared_ptr<graph::Graph>
+	checkIfNew(std::unique_ptr<lib::Graph::Single> g, std::size_t indexKey) const = 0;
+	// may be called concurrently for different graphs
+	virtual std::size_t getGraphIndexKey(const lib::Graph::Single &g) const = 0;
+	// an isomorphic graph in the graph database, or nullptr
+	virtual std::shared_ptr<graph::Graph> findIsomorphic(std::shared_ptr<graph::Graph> g) const = 0;
+	// Afterwards checkIfNew may be called concurrently, until the graph database is modified.
+	virtual void prepareForConcurrentCheckIfNew() = 0;
 	virtual bool addProduct(std::shared_ptr<graph::Graph> g) = 0;
 	virtual bool
 	isDerivation(const GraphMultiset &gmsSrc, const GraphMultiset &gmsTar, const lib::Rules::Real *r) const = 0;
-	virtual bool
-	suggestDerivation(const GraphMultiset &gmsSrc, const GraphMultiset &gmsTar, const lib::Rules::Real *r) = 0;
+	// the targets of the derivations in the DG from gmsSrc with the rule r, see NonHyper::findDerivationTargets
+	virtual std::vector<GraphMultiset>
+	findDerivationTargets(const GraphMultiset &gmsSrc, const lib::Rules::Real *r) const = 0;
+	// onNew is called if the derivation was not in the DG already,
+	// but possibly only later, e.g., when a concurrent Parallel strategy merges the results of its substrategies.
+	virtual void suggestDerivation(const GraphMultiset &gmsSrc, const GraphMultiset &gmsTar, const lib::Rules::Real *r,
+	                               std::function<void()> onNew) = 0;
+	// whether all predicates are native, and thus may be checked concurrently, see mod::Function::isNative
+	virtual bool hasOnlyNativePredicates() const = 0;
 	virtual void pushLeftPredicate(std::shared_ptr<mod::Function<bool(const mod::Derivation &)> > pred) = 0;
 	virtual void pushRightPredicate(std::shared_ptr<mod::Function<bool(const mod::Derivation &)> > pred) = 0;
 	virtual void popLeftPredicate() = 0;
 	virtual void popRightPredicate() = 0;
+	// the number of threads strategies may use, see lib::resolveNumThreads
+	virtual unsigned int getNumThreads() const = 0;
 public:
 	const LabelSettings labelSettings;
 	Rules::GraphAsRuleCache &graphAsRuleCache;
+	BindCache &bindCache;
 };
 
 struct PrintSettings : IO::Logger {
@@ -85,6 +107,11 @@ struct Strategy {
 	virtual void printInfo(PrintSettings settings) const = 0;
 	virtual const GraphState &getOutput() const;
 	virtual bool isConsumed(const lib::Graph::Single *g) const = 0;
+	// Makes the rule strategies skip the tuples of graphs they have tried before according to the history,
+	// for semi-naive evaluation, or stop skipping with nullptr.
+	// The history must describe earlier executions of this strategy.
+	// Returns false if not supported, e.g., because the substrategies get other inputs than this strategy.
+	virtual bool setBindHistory(const BindHistory *history);
 protected:
 	ExecutionEnv &getExecutionEnv();
 	void printBaseInfo(PrintSettings settings) const;
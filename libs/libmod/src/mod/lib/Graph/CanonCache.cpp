@@ -0,0 +1,339 @@
+#include "CanonCache.hpp"
+
+#include <mod/Config.hpp>
+#include <mod/Error.hpp>
+#include <mod/lib/Graph/Properties/String.hpp>
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+
+namespace mod::lib::Graph::CanonCache {
+namespace {
+
+// File format, all integers in native byte order:
+//   header: "MODCANON", uint32 version
+//   records: uint64 FNV-1a hash of the signature, uint32 number of bytes in the rest of the record,
+//            uint32 length of the signature, the signature,
+//            uint32 n, n int32 for the permutation,
+//            uint32 number of generators, each with n int32,
+//            uint8 whether a SMILES string follows, and if so: uint32 length, the string
+// A truncated last record, e.g., from an interrupted run, is ignored, and the file is then not appended to.
+// When the file is opened only the hashes and sizes are read, the rest of a record is read when it is looked up.
+// Only the records not yet written are kept in memory, the written ones are read back from the file.
+constexpr char magic[] = {'M', 'O', 'D', 'C', 'A', 'N', 'O', 'N'};
+constexpr std::uint32_t version = 2;
+// new records are written in batches of roughly this many bytes, and when the cache is closed
+constexpr std::size_t writeBatchSize = 1 << 16;
+
+// The hash must be the same in all builds, so std::hash can not be used.
+std::uint64_t hashSignature(const std::string &sig) {
+	std::uint64_t h = 14695981039346656037ull;
+	for(const unsigned char c : sig) {
+		h ^= c;
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+// The labelled graph as a string: the vertex labels in vertex order and the sorted list of labelled edges.
+std::string makeSignature(const Single &g) {
+	const auto &graph = g.getGraph();
+	const auto &str = g.getStringState();
+	std::string sig;
+	const auto appendInt = [&sig](std::uint32_t i) {
+		sig.append(reinterpret_cast<const char *>(&i), sizeof(i));
+	};
+	const auto appendString = [&sig, &appendInt](const std::string &s) {
+		appendInt(s.size());
+		sig += s;
+	};
+	appendInt(num_vertices(graph));
+	for(const auto v : asRange(vertices(graph)))
+		appendString(str[v]);
+	std::vector<std::tuple<std::uint32_t, std::uint32_t, InternedString>> es;
+	es.reserve(num_edges(graph));
+	for(const auto e : asRange(edges(graph))) {
+		std::uint32_t src = get(boost::vertex_index_t(), graph, source(e, graph));
+		std::uint32_t tar = get(boost::vertex_index_t(), graph, target(e, graph));
+		if(tar < src) std::swap(src, tar);
+		es.emplace_back(src, tar, str[e]);
+	}
+	std::sort(es.begin(), es.end(), [](const auto &a, const auto &b) {
+		return a < b;
+	});
+	appendInt(es.size());
+	for(const auto &[src, tar, label] : es) {
+		appendInt(src);
+		appendInt(tar);
+		appendString(label);
+	}
+	return sig;
+}
+
+struct Reader {
+	Reader(const char *first, const char *last) : first(first), last(last) {}
+
+	template<typename T>
+	bool read(T &t) {
+		if(last - first < static_cast<std::ptrdiff_t>(sizeof(T))) return false;
+		std::memcpy(&t, first, sizeof(T));
+		first += sizeof(T);
+		return true;
+	}
+
+	bool read(std::string &s) {
+		std::uint32_t size;
+		if(!read(size)) return false;
+		if(static_cast<std::size_t>(last - first) < size) return false;
+		s.assign(first, first + size);
+		first += size;
+		return true;
+	}
+
+	bool read(std::vector<int> &p, std::uint32_t n) {
+		// check the size before allocating, so a corrupt size can not make us allocate a lot
+		if(static_cast<std::size_t>(last - first) / sizeof(std::int32_t) < n) return false;
+		p.resize(n);
+		for(auto &i : p) {
+			std::int32_t v;
+			if(!read(v)) return false;
+			i = v;
+		}
+		return true;
+	}
+public:
+	const char *first;
+	const char *const last;
+};
+
+// Reads the part of a record after the hash and size.
+bool readEntry(Reader &r, std::string &sig, Entry &entry) {
+	std::uint32_t n, numGens;
+	std::uint8_t hasSmiles;
+	if(!r.read(sig) || !r.read(n) || !r.read(entry.perm, n) || !r.read(numGens))
+		return false;
+	// each generator has n entries, which must be in the file
+	if(n == 0 ? numGens != 0 : static_cast<std::size_t>(r.last - r.first) / sizeof(std::int32_t) / n < numGens)
+		return false;
+	entry.generators.resize(numGens);
+	for(auto &gen : entry.generators)
+		if(!r.read(gen, n)) return false;
+	if(!r.read(hasSmiles)) return false;
+	if(hasSmiles) {
+		entry.smiles.emplace();
+		if(!r.read(*entry.smiles)) return false;
+	} else {
+		entry.smiles.reset();
+	}
+	return true;
+}
+
+struct Cache {
+	explicit Cache(std::string file) : file(std::move(file)) {
+		std::size_t size = 0;
+		{
+			std::ifstream ifs(this->file, std::ios::binary | std::ios::ate);
+			if(ifs) size = ifs.tellg();
+		}
+		if(size != 0) {
+			// appending after a truncated entry would make the new entries unreadable
+			if(!openExisting()) return;
+		}
+		out.open(this->file, std::ios::binary | std::ios::app);
+		if(!out) throw InputError("Could not open canonical form cache file '" + this->file + "' for writing.");
+		if(size == 0) {
+			out.write(magic, sizeof(magic));
+			out.write(reinterpret_cast<const char *>(&version), sizeof(version));
+			out.flush();
+			size = sizeof(magic) + sizeof(version);
+		}
+		writtenSize = size;
+	}
+
+	~Cache() {
+		flush();
+	}
+
+	std::optional<Entry> lookup(const std::string &sig) {
+		{ // newest first
+			const auto iter = pendingEntries.find(sig);
+			if(iter != pendingEntries.end()) return iter->second;
+		}
+		const auto iter = index.find(hashSignature(sig));
+		if(iter == index.end()) return {};
+		std::string buffer;
+		for(auto iterRecord = iter->second.rbegin(); iterRecord != iter->second.rend(); ++iterRecord) {
+			const auto[offset, recordSize] = *iterRecord;
+			const char *first;
+			if(offset + recordSize <= mapped.size()) {
+				first = mapped.data() + offset;
+			} else {
+				// appended by this process after the file was mapped
+				if(!in.is_open()) in.open(file, std::ios::binary);
+				buffer.resize(recordSize);
+				in.clear();
+				in.seekg(offset);
+				if(!in.read(buffer.data(), recordSize)) continue;
+				first = buffer.data();
+			}
+			Reader r(first, first + recordSize);
+			std::string sigStored;
+			Entry entry;
+			// a corrupt record is treated as a miss
+			if(!readEntry(r, sigStored, entry)) continue;
+			if(sigStored == sig) return entry;
+		}
+		return {};
+	}
+
+	// Does nothing if the file can not be appended to.
+	void store(std::string sig, Entry entry) {
+		if(!out.is_open()) return;
+		std::string record;
+		const auto writeInt = [&record](std::uint32_t i) {
+			record.append(reinterpret_cast<const char *>(&i), sizeof(i));
+		};
+		const auto writePerm = [&record](const std::vector<int> &p) {
+			for(const std::int32_t i : p)
+				record.append(reinterpret_cast<const char *>(&i), sizeof(i));
+		};
+		writeInt(sig.size());
+		record += sig;
+		writeInt(entry.perm.size());
+		writePerm(entry.perm);
+		writeInt(entry.generators.size());
+		for(const auto &gen : entry.generators)
+			writePerm(gen);
+		const std::uint8_t hasSmiles = entry.smiles.has_value();
+		record.append(reinterpret_cast<const char *>(&hasSmiles), sizeof(hasSmiles));
+		if(entry.smiles) {
+			writeInt(entry.smiles->size());
+			record += *entry.smiles;
+		}
+		const std::uint64_t hash = hashSignature(sig);
+		const std::uint32_t recordSize = record.size();
+		pending.append(reinterpret_cast<const char *>(&hash), sizeof(hash));
+		pending.append(reinterpret_cast<const char *>(&recordSize), sizeof(recordSize));
+		pendingRecords.emplace_back(hash, pending.size(), recordSize);
+		pending += record;
+		pendingEntries[std::move(sig)] = std::move(entry);
+		if(pending.size() >= writeBatchSize) flush();
+	}
+
+	void flush() {
+		if(pending.empty()) return;
+		out.write(pending.data(), pending.size());
+		out.flush();
+		for(const auto &[hash, offset, recordSize] : pendingRecords)
+			index[hash].emplace_back(writtenSize + offset, recordSize);
+		writtenSize += pending.size();
+		pending.clear();
+		pendingRecords.clear();
+		pendingEntries.clear();
+	}
+private:
+	// Returns false if the file ends with a truncated entry.
+	bool openExisting() {
+		try {
+			mapped.open(file);
+		} catch(const BOOST_IOSTREAMS_FAILURE &e) {
+			throw InputError("Could not open canonical form cache file '" + file + "':\n" + e.what());
+		}
+		Reader r(mapped.data(), mapped.data() + mapped.size());
+		char magicRead[sizeof(magic)];
+		std::uint32_t versionRead;
+		if(static_cast<std::size_t>(r.last - r.first) < sizeof(magic))
+			throw InputError("File '" + file + "' is not a canonical form cache file.");
+		std::memcpy(magicRead, r.first, sizeof(magic));
+		r.first += sizeof(magic);
+		if(std::memcmp(magicRead, magic, sizeof(magic)) != 0 || !r.read(versionRead))
+			throw InputError("File '" + file + "' is not a canonical form cache file.");
+		if(versionRead != version)
+			throw InputError("Canonical form cache file '" + file + "' has version " + std::to_string(versionRead)
+			                 + ", but version " + std::to_string(version) + " is required.");
+		while(r.first != r.last) {
+			std::uint64_t hash;
+			std::uint32_t recordSize;
+			if(!r.read(hash) || !r.read(recordSize)
+			   || static_cast<std::size_t>(r.last - r.first) < recordSize) {
+				std::cout << "WARNING: the canonical form cache file '" << file << "' ends with a truncated entry."
+				          << " New entries will not be saved. Delete the file to start a new cache." << std::endl;
+				return false;
+			}
+			index[hash].emplace_back(r.first - mapped.data(), recordSize);
+			r.first += recordSize;
+		}
+		return true;
+	}
+public:
+	const std::string file;
+private:
+	boost::iostreams::mapped_file_source mapped;
+	// hash of the signature -> offsets and sizes of the written records in the file, oldest first
+	std::unordered_map<std::uint64_t, std::vector<std::pair<std::size_t, std::size_t>>> index;
+	std::ofstream out;
+	// for reading the records written after the file was mapped
+	std::ifstream in;
+	std::size_t writtenSize = 0;
+	// records not yet written to out, their hashes, offsets in pending, and sizes, and their entries
+	std::string pending;
+	std::vector<std::tuple<std::uint64_t, std::size_t, std::size_t>> pendingRecords;
+	std::unordered_map<std::string, Entry> pendingEntries;
+};
+
+std::mutex cacheMutex;
+std::unique_ptr<Cache> cache;
+
+// Returns nullptr if the cache is disabled.
+// Requires cacheMutex to be held.
+Cache *getCache() {
+	const auto &file = getConfig().canon.cacheFile.get();
+	if(file.empty()) return nullptr;
+	if(!cache || cache->file != file) {
+		cache.reset(); // close the old file first
+		cache = std::make_unique<Cache>(file);
+	}
+	return cache.get();
+}
+
+} // namespace
+
+std::optional<Entry> lookup(const Single &g) {
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto *c = getCache();
+	if(!c) return {};
+	return c->lookup(makeSignature(g));
+}
+
+void store(const Single &g, const std::vector<int> &perm, const Single::AutGroup &aut,
+           const std::string *smiles) {
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	auto *c = getCache();
+	if(!c) return;
+	Entry entry;
+	entry.perm = perm;
+	for(const auto &p : aut.generators()) {
+		std::vector<int> gen(perm.size());
+		bool isIdentity = true;
+		for(std::size_t i = 0; i != gen.size(); ++i) {
+			gen[i] = perm_group::get(p, i);
+			if(gen[i] != static_cast<int>(i)) isIdentity = false;
+		}
+		if(!isIdentity) entry.generators.push_back(std::move(gen));
+	}
+	if(smiles) entry.smiles = *smiles;
+	c->store(makeSignature(g), std::move(entry));
+}
+
+} // namespace mod::lib::Graph::CanonCache
@@ -0,0 +1,34 @@
+#ifndef MOD_LIB_GRAPH_CANONCACHE_HPP
+#define MOD_LIB_GRAPH_CANONCACHE_HPP
+
+#include <mod/lib/Graph/Single.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+// A persistent cache of canonicalisation results, enabled by setting config.canon.cacheFile to a file path.
+// Entries are keyed by the labelled graph itself, i.e., the vertex order, the vertex labels, and the labelled edges,
+// so a graph loaded again from the same input will find the result from a previous run.
+// The file is memory mapped when first used, and new entries are appended to it.
+// Only the entries not yet appended are kept in memory.
+
+namespace mod::lib::Graph::CanonCache {
+
+struct Entry {
+	std::vector<int> perm;
+	// the non-identity generators of the automorphism group
+	std::vector<std::vector<int>> generators;
+	std::optional<std::string> smiles;
+};
+
+// Returns an empty optional if the cache is disabled or has no entry for g.
+std::optional<Entry> lookup(const Single &g);
+// Does nothing if the cache is disabled, or if the file ends with a truncated entry.
+// A later entry for the same graph supersedes earlier entries.
+void store(const Single &g, const std::vector<int> &perm, const Single::AutGroup &aut,
+           const std::string *smiles);
+
+} // namespace mod::lib::Graph::CanonCache
+
+#endif // MOD_LIB_GRAPH_CANONCACHE_HPP
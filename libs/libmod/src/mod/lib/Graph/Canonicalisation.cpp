@@ -1,7 +1,12 @@
 #include "Canonicalisation.hpp"
 
 #include <mod/lib/Graph/Properties/Molecule.hpp>
+#include <mod/lib/Graph/Properties/Stereo.hpp>
 #include <mod/lib/Graph/Properties/String.hpp>
+#include <mod/lib/Graph/Properties/Term.hpp>
+#include <mod/lib/Stereo/Configuration/Configuration.hpp>
+#include <mod/lib/Stereo/EdgeCategory.hpp>
+#include <mod/lib/Stereo/GeometryGraph.hpp>
 
 #include <graph_canon/aut/implicit_size_2.hpp>
 #include <graph_canon/aut/pruner_basic.hpp>
@@ -23,8 +28,12 @@
 
 #include <jla_boost/graph/PairToRangeAdaptor.hpp>
 
+#include <boost/functional/hash.hpp>
 #include <boost/graph/graph_utility.hpp> // for boost::print_graph
 
+#include <map>
+#include <set>
+#include <tuple>
 #include <vector>
 
 namespace mod::lib::Graph {
@@ -531,6 +540,263 @@ private:
 	const LabelledGraph &lg;
 };
 
+//------------------------------------------------------------------------------
+// Stereo
+//------------------------------------------------------------------------------
+// The canonicalisation with stereo has two steps:
+// 1. The graph is canonicalised as without stereo, but with the vertices also partitioned by the parts
+//    of their configurations which are preserved by any stereo isomorphism, see getStereoVertexKey.
+//    This gives a canonical permutation and the automorphism group of the graph without the embeddings.
+// 2. All canonical permutations are the canonical one composed with an automorphism,
+//    so among them we pick one which gives the smallest StereoForm, i.e., the encoding of the embeddings.
+//    The stereo automorphisms are then the automorphisms that preserve the StereoForm.
+// The StereoForm only depends on the images of a few vertices, the "points", e.g., fixed tetrahedral vertices
+// and their neighbours, so the search is over the orbit of the points, not over the whole automorphism group.
+// Embeddings are compared as by the stereo isomorphism in GraphMorphism/StereoVertexMap.hpp:
+// - a fixed tetrahedral configuration is preserved by even permutations of its embedding,
+// - fixed trigonal planar configurations are compared in pairs, along the edges carrying their plane,
+//   as reflecting both embeddings gives the same geometry,
+// - free configurations are preserved by any permutation.
+
+// geometry, number of lone pairs, radical, fixed
+using StereoVertexKey = std::tuple<Stereo::GeometryGraph::Vertex, int, bool, bool>;
+
+StereoVertexKey getStereoVertexKey(const Stereo::Configuration &c) {
+	return {c.getGeometryVertex(), c.getNumLonePairs(), c.getHasRadical(), c.getFixation().asSimple()};
+}
+
+// The parity of the embedding of v when the neighbours are labelled by 'labelling',
+// with lone pairs and radicals before all neighbours,
+// or -1 if the embedding has several lone pairs or radicals, and thus no orientation.
+int getEmbeddingParity(const GraphType &g, const Vertex v, const Stereo::Configuration &c,
+                       const std::vector<int> &labelling) {
+	std::vector<int> seq;
+	seq.reserve(c.degree());
+	for(const auto &emb : c) {
+		if(emb.type == Stereo::EmbeddingEdge::Type::Edge)
+			seq.push_back(labelling[get(boost::vertex_index_t(), g, target(emb.getEdge(v, g), g))]);
+		else
+			seq.push_back(-1);
+	}
+	int numInversions = 0;
+	for(std::size_t i = 0; i != seq.size(); ++i) {
+		for(std::size_t j = i + 1; j != seq.size(); ++j) {
+			if(seq[i] == seq[j]) return -1;
+			if(seq[i] > seq[j]) ++numInversions;
+		}
+	}
+	return numInversions % 2;
+}
+
+// The stereo information of a graph under a labelling.
+struct StereoForm {
+	// by label, with the parity code of fixed tetrahedral configurations, see getEmbeddingParity
+	std::vector<std::pair<StereoVertexKey, int>> vertices;
+	// sorted, (smaller label, larger label, category, relative parity code of fixed trigonal planar ends)
+	std::vector<std::tuple<int, int, int, int>> edges;
+public:
+	friend bool operator==(const StereoForm &a, const StereoForm &b) {
+		return std::tie(a.vertices, a.edges) == std::tie(b.vertices, b.edges);
+	}
+
+	friend bool operator!=(const StereoForm &a, const StereoForm &b) {
+		return !(a == b);
+	}
+
+	friend bool operator<(const StereoForm &a, const StereoForm &b) {
+		return std::tie(a.vertices, a.edges) < std::tie(b.vertices, b.edges);
+	}
+};
+
+// The vertices and edges of a graph which the StereoForm depends on besides the vertex keys.
+struct StereoFeatures {
+	explicit StereoFeatures(const Single &gWrap) : g(gWrap.getGraph()), pStereo(get_stereo(gWrap.getLabelledGraph())) {
+		const auto &geo = Stereo::getGeometryGraph();
+		const auto &mol = gWrap.getMoleculeState();
+		const auto isFixed = [&](const Vertex v, const Stereo::GeometryGraph::Vertex vGeo) {
+			const auto &c = *pStereo[v];
+			return c.getGeometryVertex() == vGeo && c.getFixation().asSimple();
+		};
+		std::vector<bool> isPoint(num_vertices(g), false);
+		const auto addPoint = [&](const Vertex v) {
+			const auto vId = get(boost::vertex_index_t(), g, v);
+			if(isPoint[vId]) return;
+			isPoint[vId] = true;
+			points.push_back(vId);
+		};
+		const auto addWithNeighbours = [&](const Vertex v) {
+			addPoint(v);
+			for(const auto e : asRange(out_edges(v, g)))
+				addPoint(target(e, g));
+		};
+		for(const auto v : asRange(vertices(g))) {
+			const auto &c = *pStereo[v];
+			if(!c.getFixation().asSimple()) continue;
+			if(c.getGeometryVertex() == geo.tetrahedral) {
+				tetrahedral.push_back(v);
+				addWithNeighbours(v);
+			} else if(c.getGeometryVertex() != geo.trigonalPlanar) {
+				throw LogicError("Can not canonicalise fixed stereo configurations with geometry '"
+				                 + geo.getGraph()[c.getGeometryVertex()].name + "'.");
+			}
+		}
+		for(const auto e : asRange(edges(g))) {
+			const auto cat = pStereo[e];
+			const auto vSrc = source(e, g);
+			const auto vTar = target(e, g);
+			const bool isPlanarPair = Stereo::carriesPlane(cat)
+			                          && isFixed(vSrc, geo.trigonalPlanar) && isFixed(vTar, geo.trigonalPlanar);
+			// the category of other edges is given by the bond type, which the automorphisms preserve
+			if(!isPlanarPair && cat == Stereo::bondTypeToEdgeCategory(mol[e])) continue;
+			specialEdges.emplace_back(e, isPlanarPair);
+			if(isPlanarPair) {
+				addWithNeighbours(vSrc);
+				addWithNeighbours(vTar);
+			} else {
+				addPoint(vSrc);
+				addPoint(vTar);
+			}
+		}
+	}
+
+	// pre: labelling is a permutation of the vertex indices
+	StereoForm getForm(const std::vector<int> &labelling) const {
+		StereoForm res;
+		res.vertices.resize(num_vertices(g));
+		for(const auto v : asRange(vertices(g))) {
+			const auto vId = get(boost::vertex_index_t(), g, v);
+			res.vertices[labelling[vId]] = {getStereoVertexKey(*pStereo[v]), 0};
+		}
+		for(const auto v : tetrahedral) {
+			const auto vId = get(boost::vertex_index_t(), g, v);
+			res.vertices[labelling[vId]].second = 1 + getEmbeddingParity(g, v, *pStereo[v], labelling);
+		}
+		res.edges.reserve(specialEdges.size());
+		for(const auto &[e, isPlanarPair] : specialEdges) {
+			const auto vSrc = source(e, g);
+			const auto vTar = target(e, g);
+			const auto lSrc = labelling[get(boost::vertex_index_t(), g, vSrc)];
+			const auto lTar = labelling[get(boost::vertex_index_t(), g, vTar)];
+			int relative = 0;
+			if(isPlanarPair) {
+				const auto pSrc = getEmbeddingParity(g, vSrc, *pStereo[vSrc], labelling);
+				const auto pTar = getEmbeddingParity(g, vTar, *pStereo[vTar], labelling);
+				if(pSrc != -1 && pTar != -1) relative = 1 + (pSrc ^ pTar);
+			}
+			res.edges.emplace_back(std::min(lSrc, lTar), std::max(lSrc, lTar), static_cast<int>(pStereo[e]), relative);
+		}
+		std::sort(res.edges.begin(), res.edges.end());
+		return res;
+	}
+public:
+	const GraphType &g;
+	const PropStereo &pStereo;
+	std::vector<Vertex> tetrahedral;
+	// the edges with a category not given by the bond type, or between two fixed trigonal planar vertices,
+	// with whether it is the latter
+	std::vector<std::pair<Edge, bool>> specialEdges;
+	std::vector<std::size_t> points; // the vertex indices the form depends on
+};
+
+// The labelling the canonical form of g uses, i.e., the canonical index of each vertex.
+std::vector<int> getCanonLabelling(const Single &g, const Single::CanonForm &form) {
+	const auto &idx = form.get_index_map();
+	std::vector<int> res(num_vertices(g.getGraph()));
+	for(const auto v : asRange(vertices(g.getGraph())))
+		res[get(boost::vertex_index_t(), g.getGraph(), v)] = idx[v];
+	return res;
+}
+
+// Given a canonical permutation and the generators of the automorphism group from step 1,
+// replaces them with the ones with stereo.
+// The search enumerates the orbit of the tuple of stereo points (see StereoFeatures) under the automorphism group,
+// so it takes time and memory proportional to the orbit size times the number of generators.
+// That is small for molecules, but in the worst case it is exponential in the number of stereo points,
+// e.g., 2^k for a graph with k stereo centres that can be swapped independently, such as k symmetric substituents.
+void canonicaliseStereo(const Single &g, std::vector<int> &perm, std::vector<std::vector<int>> &generators) {
+	const StereoFeatures features(g);
+	if(features.points.empty()) return; // every automorphism preserves the stereo
+	const auto n = perm.size();
+	// a after b
+	const auto compose = [n](const std::vector<int> &a, const std::vector<int> &b) {
+		std::vector<int> res(n);
+		for(std::size_t i = 0; i != n; ++i) res[i] = a[b[i]];
+		return res;
+	};
+	const auto inverse = [n](const std::vector<int> &a) {
+		std::vector<int> res(n);
+		for(std::size_t i = 0; i != n; ++i) res[a[i]] = i;
+		return res;
+	};
+	const auto restrictToPoints = [&features](const std::vector<int> &a) {
+		std::vector<int> res;
+		res.reserve(features.points.size());
+		for(const auto p : features.points) res.push_back(a[p]);
+		return res;
+	};
+	const auto isIdentity = [](const std::vector<int> &a) {
+		for(std::size_t i = 0; i != a.size(); ++i)
+			if(a[i] != static_cast<int>(i)) return false;
+		return true;
+	};
+	// An automorphism for each restriction to the points, found by multiplying with the generators.
+	// The automorphisms fixing all points form a subgroup, generated by the Schreier generators.
+	std::vector<std::vector<int>> transversal(1, std::vector<int>(n));
+	for(std::size_t i = 0; i != n; ++i) transversal.front()[i] = i;
+	std::map<std::vector<int>, std::size_t> transversalIndex{{restrictToPoints(transversal.front()), 0}};
+	std::set<std::vector<int>> newGenerators;
+	for(std::size_t i = 0; i != transversal.size(); ++i) {
+		for(const auto &s : generators) {
+			auto a = compose(s, transversal[i]);
+			const auto[iter, isNew] = transversalIndex.emplace(restrictToPoints(a), transversal.size());
+			if(isNew) {
+				transversal.push_back(std::move(a));
+			} else {
+				auto schreier = compose(inverse(transversal[iter->second]), a);
+				if(!isIdentity(schreier)) newGenerators.insert(std::move(schreier));
+			}
+		}
+	}
+	// the canonical permutation composed with the automorphism
+	const auto getLabelling = [&perm, n](const std::vector<int> &aut) {
+		std::vector<int> res(n);
+		for(std::size_t i = 0; i != n; ++i) res[i] = perm[aut[i]];
+		return res;
+	};
+	std::vector<StereoForm> forms;
+	forms.reserve(transversal.size());
+	for(const auto &t : transversal)
+		forms.push_back(features.getForm(getLabelling(t)));
+	const std::size_t best = std::min_element(forms.begin(), forms.end()) - forms.begin();
+	const auto bestInverse = inverse(transversal[best]);
+	for(std::size_t i = 0; i != transversal.size(); ++i)
+		if(i != best && forms[i] == forms[best])
+			newGenerators.insert(compose(bestInverse, transversal[i]));
+	perm = getLabelling(transversal[best]);
+	// Many of the Schreier generators are redundant, so they are sifted with Sims' filter:
+	// each is reduced by the kept generator with the same first moved point and image of it, until it is new,
+	// so at most n(n - 1) / 2 generators are kept, and they generate the same group.
+	std::map<std::pair<int, int>, std::vector<int>> sifted;
+	for(auto a : newGenerators) {
+		for(std::size_t i = 0; i != n; ++i) {
+			if(a[i] == static_cast<int>(i)) continue;
+			const auto[iter, isNew] = sifted.emplace(std::make_pair(static_cast<int>(i), a[i]), a);
+			if(isNew) break;
+			// the result also fixes i
+			a = compose(inverse(iter->second), a);
+		}
+	}
+	generators.clear();
+	for(auto &[key, a] : sifted) generators.push_back(std::move(a));
+}
+
+// with term labels, the labels are compared through the ids of their hash-consed ground terms
+const Single::GroundTermIds &getTermIds(const Single &g) {
+	const auto &ids = g.getGroundTermIds();
+	assert(ids.isGround); // checked by isCanonicalisable
+	return ids;
+}
+
 template<typename EdgeHandler>
 auto getCanonForm(const Single &g, EdgeHandler eHandler, LabelType labelType, bool withStereo) {
 	auto can = graph_canon::canonicalizer<int, EdgeHandler, false, false>(eHandler);
@@ -544,8 +810,24 @@ auto getCanonForm(const Single &g, EdgeHandler eHandler, LabelType labelType, bo
 			, graph_canon::stats_visitor()
 	);
 	const auto &str = get_string(g.getLabelledGraph());
-	const auto vLess = [&str](Vertex a, Vertex b) {
-		return str[a] < str[b];
+	// with stereo, the vertices are also partitioned by the parts of their configurations
+	// which do not depend on the neighbours
+	std::vector<StereoVertexKey> stereoKeys;
+	if(withStereo) {
+		const auto &pStereo = get_stereo(g.getLabelledGraph());
+		stereoKeys.reserve(num_vertices(graph));
+		for(const auto v : asRange(vertices(graph)))
+			stereoKeys.push_back(getStereoVertexKey(*pStereo[v]));
+	}
+	const auto *termIds = labelType == LabelType::Term ? &getTermIds(g).vertices : nullptr;
+	const auto vLess = [labelType, &str, &termIds, &stereoKeys, &idx](Vertex a, Vertex b) {
+		if(labelType == LabelType::String) {
+			if(str[a] != str[b]) return str[a] < str[b];
+		} else {
+			if((*termIds)[idx[a]] != (*termIds)[idx[b]]) return (*termIds)[idx[a]] < (*termIds)[idx[b]];
+		}
+		if(stereoKeys.empty()) return false;
+		return stereoKeys[idx[a]] < stereoKeys[idx[b]];
 	};
 
 	auto res = can(graph, idx, vLess, vis);
@@ -576,19 +858,37 @@ auto getCanonForm(const Single &g, EdgeHandler eHandler, LabelType labelType, bo
 
 } // namespace
 
-std::tuple<std::vector<int>, std::unique_ptr<Single::CanonForm>, std::unique_ptr<Single::AutGroup> >
-getCanonForm(const Single &g, LabelType labelType, bool withStereo) {
-	if(labelType != LabelType::String)
-		throw LogicError("Can only canonicalise with label type string.");
-	if(withStereo)
-		throw LogicError("Can not canonicalise stereo.");
-	const auto &mol = get_molecule(g.getLabelledGraph());
+bool isCanonicalisable(const Single &g, LabelType labelType) {
+	const auto &mol = g.getMoleculeState();
 	const auto es = edges(g.getGraph());
-	const bool isMol = std::all_of(es.first, es.second, [&](const auto &e) {
+	const bool bonds = std::all_of(es.first, es.second, [&](const auto &e) {
 		return mol[e] != BondType::Invalid;
 	});
-	if(isMol) {
-		return getCanonForm(g, edge_handler_bond(g), labelType, withStereo);
+	if(!bonds || labelType == LabelType::String) return bonds;
+	return isValid(get_term(g.getLabelledGraph())) && g.getGroundTermIds().isGround;
+}
+
+std::tuple<std::vector<int>, std::unique_ptr<Single::CanonForm>, std::unique_ptr<Single::AutGroup> >
+getCanonForm(const Single &g, LabelType labelType, bool withStereo) {
+	if(labelType == LabelType::Term && withStereo)
+		throw LogicError("Can not canonicalise with both term labels and stereo.");
+	if(isCanonicalisable(g, labelType)) {
+		auto res = getCanonForm(g, edge_handler_bond(g), labelType, withStereo);
+		if(!withStereo) return res;
+		std::vector<int> perm = std::move(std::get<0>(res));
+		std::vector<std::vector<int>> generators;
+		for(const auto &p : std::get<2>(res)->generators()) {
+			std::vector<int> gen(perm.size());
+			for(std::size_t i = 0; i != gen.size(); ++i)
+				gen[i] = perm_group::get(p, i);
+			generators.push_back(std::move(gen));
+		}
+		canonicaliseStereo(g, perm, generators);
+		return makeCanonForm(g, std::move(perm), generators);
+	} else if(labelType == LabelType::Term && isCanonicalisable(g, LabelType::String)) {
+		std::string msg = "Can not canonicalise term labels with variables.\n";
+		msg += "Graph is '" + g.getName() + "', with graphDFS: " + g.getGraphDFS().first;
+		throw LogicError(std::move(msg));
 	} else {
 		std::string msg = "Can not canonicalise arbitrary edge labels.\n";
 		msg += "Graph is '" + g.getName() + "', with graphDFS: " + g.getGraphDFS().first;
@@ -596,6 +896,23 @@ getCanonForm(const Single &g, LabelType labelType, bool withStereo) {
 	}
 }
 
+std::tuple<std::vector<int>, std::unique_ptr<Single::CanonForm>, std::unique_ptr<Single::AutGroup>>
+makeCanonForm(const Single &g, std::vector<int> perm, const std::vector<std::vector<int>> &generators) {
+	const auto &graph = get_graph(g.getLabelledGraph());
+	const auto idx = get(boost::vertex_index_t(), graph);
+	const auto &str = get_string(g.getLabelledGraph());
+	auto eLess = [&str](Edge lhs, Edge rhs) {
+		MOD_ABORT; // should never be called, as we don't have parallel edges or loops
+		return str[lhs] < str[rhs];
+	};
+	Single::CanonIdxMap ordIdx(perm.begin(), idx);
+	auto form = std::make_unique<Single::CanonForm>(graph, ordIdx, eLess);
+	auto aut = std::make_unique<Single::AutGroup>(perm.size());
+	for(const auto &p : generators)
+		aut->add_generator(p);
+	return std::make_tuple(std::move(perm), std::move(form), std::move(aut));
+}
+
 namespace {
 
 template<typename LGraph, typename Graph, typename Idx>
@@ -668,10 +985,51 @@ PrintVisitor<LGraph, Graph, Idx> makePrintVisitor(const LGraph &lg1,
 
 } // namespace
 
+std::size_t canonicalHash(const Single &g, LabelType labelType, bool withStereo) {
+	const auto &ord = g.getCanonForm(labelType, withStereo);
+	const auto &idx = ord.get_index_map();
+	const auto &graph = g.getGraph();
+	const auto &str = get_string(g.getLabelledGraph());
+	const auto *termIds = labelType == LabelType::Term ? &getTermIds(g) : nullptr;
+	// the ordered graph enumerates vertices and out-edges in canonical order
+	std::size_t res = num_vertices(ord);
+	for(const auto v : asRange(vertices(ord))) {
+		boost::hash_combine(res, idx[v]);
+		if(termIds) boost::hash_combine(res, termIds->vertices[get(boost::vertex_index_t(), graph, v)]);
+		else boost::hash_combine(res, str[v]);
+		for(const auto e : asRange(out_edges(v, ord))) {
+			boost::hash_combine(res, idx[target(e, ord)]);
+			if(termIds) boost::hash_combine(res, termIds->edges[get(boost::edge_index_t(), graph, e)]);
+			else boost::hash_combine(res, str[e]);
+		}
+	}
+	if(withStereo) {
+		const auto form = StereoFeatures(g).getForm(getCanonLabelling(g, ord));
+		for(const auto &[key, parity] : form.vertices) {
+			boost::hash_combine(res, std::get<0>(key));
+			boost::hash_combine(res, std::get<1>(key));
+			boost::hash_combine(res, std::get<2>(key));
+			boost::hash_combine(res, std::get<3>(key));
+			boost::hash_combine(res, parity);
+		}
+		for(const auto &[lSrc, lTar, cat, relative] : form.edges) {
+			boost::hash_combine(res, lSrc);
+			boost::hash_combine(res, lTar);
+			boost::hash_combine(res, cat);
+			boost::hash_combine(res, relative);
+		}
+	}
+	return res;
+}
+
 bool canonicalCompare(const Single &g1, const Single &g2, LabelType labelType, bool withStereo) {
 	const auto &ord1 = g1.getCanonForm(labelType, withStereo);
 	const auto &ord2 = g2.getCanonForm(labelType, withStereo);
-	if(withStereo) throw LogicError("Can not currently compare canonical forms with stereo information.");
+	if(withStereo) {
+		if(StereoFeatures(g1).getForm(getCanonLabelling(g1, ord1))
+		   != StereoFeatures(g2).getForm(getCanonLabelling(g2, ord2)))
+			return false;
+	}
 	const auto &gl1 = g1.getLabelledGraph();
 	const auto &gl2 = g2.getLabelledGraph();
 	const auto visitor = graph_canon::graph_compare_null_visitor();
@@ -685,7 +1043,21 @@ bool canonicalCompare(const Single &g1, const Single &g2, LabelType labelType, b
 															 [&gl1, &gl2](Edge e1, Edge e2) -> bool {
 																 return get_string(gl1)[e1] == get_string(gl2)[e2];
 															 }, visitor);
-	case LabelType::Term: throw LogicError("Can not currently compare canonical forms with term labels.");
+	case LabelType::Term: {
+		const auto &graph1 = g1.getGraph();
+		const auto &graph2 = g2.getGraph();
+		const auto &ids1 = getTermIds(g1);
+		const auto &ids2 = getTermIds(g2);
+		return graph_canon::ordered_graph_equal(ord1, ord2,
+															 [&](Vertex v1, Vertex v2) -> bool {
+																 return ids1.vertices[get(boost::vertex_index_t(), graph1, v1)]
+																        == ids2.vertices[get(boost::vertex_index_t(), graph2, v2)];
+															 },
+															 [&](Edge e1, Edge e2) -> bool {
+																 return ids1.edges[get(boost::edge_index_t(), graph1, e1)]
+																        == ids2.edges[get(boost::edge_index_t(), graph2, e2)];
+															 }, visitor);
+	}
 	}
 	MOD_ABORT;
 }
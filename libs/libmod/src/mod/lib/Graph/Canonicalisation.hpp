@@ -5,9 +5,25 @@
 
 namespace mod::lib::Graph {
 
+// Whether getCanonForm can handle the graph, i.e., whether all edges are valid bonds,
+// and with term labels, whether all terms are parsable and ground.
+bool isCanonicalisable(const Single &g, LabelType labelType);
+
+// With stereo, the canonical form and automorphism group also respect the stereo configurations,
+// including the embeddings of fixed tetrahedral and trigonal planar vertices.
+// With term labels, the labels are ordered by hash-consed ids of their ground terms (see Term/GroundTerm.hpp),
+// so the canonical forms are only comparable within a process. Stereo is not supported with term labels.
 std::tuple<std::vector<int>, std::unique_ptr<Single::CanonForm>, std::unique_ptr<Single::AutGroup>>
 getCanonForm(const Single &g, LabelType labelType, bool withStereo);
 
+// Recreates the result of getCanonForm from a canonical permutation and generators of the automorphism group,
+// e.g., loaded from the CanonCache.
+std::tuple<std::vector<int>, std::unique_ptr<Single::CanonForm>, std::unique_ptr<Single::AutGroup>>
+makeCanonForm(const Single &g, std::vector<int> perm, const std::vector<std::vector<int>> &generators);
+
+// A hash of the canonical form, i.e., equal for graphs where canonicalCompare is true.
+std::size_t canonicalHash(const Single &g, LabelType labelType, bool withStereo);
+
 bool canonicalCompare(const Single &g1, const Single &g2, LabelType labelType, bool withStereo);
 
 } // namespace mod::lib::Graph
@@ -1,8 +1,16 @@
 #include "Collection.hpp"
 
 #include <mod/Error.hpp>
+#include <mod/lib/Algorithm/Parallel.hpp>
+#include <mod/lib/Graph/Canonicalisation.hpp>
+#include <mod/lib/Graph/Properties/Molecule.hpp>
+#include <mod/lib/Graph/Properties/String.hpp>
 #include <mod/lib/Graph/Single.hpp>
 
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <algorithm>
+
 namespace mod::lib::Graph {
 namespace {
 
@@ -11,12 +19,52 @@ inline CollectionStats getStats(const lib::Graph::Single *g) {
 	return {num_vertices(graph), num_edges(graph)};
 }
 
+// Hash of the multiset of vertex colours after a few rounds of Weisfeiler-Leman colour refinement.
+// Labels are only used with string labels, as term labels are only equal up to variable renaming.
+std::size_t getWLHash(const lib::Graph::Single &g, LabelType labelType) {
+	constexpr int numRounds = 3;
+	const auto &graph = g.getGraph();
+	const auto &str = g.getStringState();
+	const bool useLabels = labelType == LabelType::String;
+	const auto idx = get(boost::vertex_index_t(), graph);
+	std::vector<std::size_t> colour(num_vertices(graph)), colourNext(num_vertices(graph));
+	for(const auto v : asRange(vertices(graph))) {
+		auto &c = colour[get(idx, v)];
+		c = out_degree(v, graph);
+		if(useLabels) boost::hash_combine(c, str[v]);
+	}
+	std::vector<std::size_t> neighbours;
+	for(int round = 0; round != numRounds; ++round) {
+		for(const auto v : asRange(vertices(graph))) {
+			neighbours.clear();
+			for(const auto e : asRange(out_edges(v, graph))) {
+				std::size_t n = colour[get(idx, target(e, graph))];
+				if(useLabels) boost::hash_combine(n, str[e]);
+				neighbours.push_back(n);
+			}
+			std::sort(neighbours.begin(), neighbours.end());
+			std::size_t c = colour[get(idx, v)];
+			for(const auto n : neighbours)
+				boost::hash_combine(c, n);
+			colourNext[get(idx, v)] = c;
+		}
+		std::swap(colour, colourNext);
+	}
+	std::sort(colour.begin(), colour.end());
+	std::size_t res = colour.size();
+	for(const auto c : colour)
+		boost::hash_combine(res, c);
+	return res;
+}
+
 
 } // namespace
 
 struct Collection::Store {
-	bool trustInsert(const lib::Graph::Single *g) {
-		return graphs.insert(g).second;
+	bool trustInsert(const lib::Graph::Single *g, std::size_t key) {
+		const bool res = graphs.insert(g).second;
+		if(res) index.emplace(key, g);
+		return res;
 	}
 
 	auto end() const {
@@ -27,10 +75,17 @@ struct Collection::Store {
 		return graphs.find(g);
 	}
 
-	std::shared_ptr<graph::Graph> findIsomorphic(const lib::Graph::Single *g, LabelSettings ls) const {
-		for(const auto &gCand : graphs) {
+	std::shared_ptr<graph::Graph>
+	findIsomorphic(const lib::Graph::Single *g, std::size_t key, LabelSettings ls) const {
+		const auto candidates = index.equal_range(key);
+		for(auto iter = candidates.first; iter != candidates.second; ++iter) {
+			const auto *gCand = iter->second;
 			const bool iso = lib::Graph::Single::isomorphic(*g, *gCand, ls);
-			if(iso) return gCand->getAPIReference();
+			if(iso) {
+				incrementConcurrently(getConfig().graph.numIsomorphismIndexHits());
+				return gCand->getAPIReference();
+			}
+			incrementConcurrently(getConfig().graph.numIsomorphismIndexCollisions());
 			// if iso:
 			//			if(getConfig().dg.calculateDetailsVerbose.get()) {
 			//				std::cout << "Discarding product " << gCand->getName() << ", isomorphic to " << g->getName() << std::endl;
@@ -53,14 +108,41 @@ struct Collection::Store {
 
 private:
 	std::unordered_set<const lib::Graph::Single *> graphs;
+	std::unordered_multimap<std::size_t, const lib::Graph::Single *> index;
 };
 
 Collection::Collection(LabelSettings ls, Config::IsomorphismAlg alg)
 		: ls(ls.type, LabelRelation::Isomorphism,
-			  ls.withStereo, LabelRelation::Isomorphism) {}
+			  ls.withStereo, LabelRelation::Isomorphism), alg(alg) {}
 
 Collection::~Collection() = default;
 
+std::size_t Collection::getIndexKey(const lib::Graph::Single *g) const {
+	// the isomorphism check falls back to name comparison for empty graphs,
+	// and names can be changed after insertion, so they must all share a key
+	if(num_vertices(g->getGraph()) == 0)
+		return 0;
+	// All keys must be invariant under the isomorphism relation of ls, with stereo if enabled,
+	// as the isomorphism algorithm may be changed in the config after construction.
+	switch(alg) {
+	case Config::IsomorphismAlg::SmilesCanonVF2:
+		if(ls.type == LabelType::String && g->getMoleculeState().getIsMolecule()
+		   && !getConfig().graph.useWrongSmilesCanonAlg.get())
+			return std::hash<std::string>()(g->getSmiles());
+		[[fallthrough]];
+	case Config::IsomorphismAlg::Canon:
+		if(ls.type == LabelType::String && isCanonicalisable(*g, ls.type))
+			return canonicalHash(*g, ls.type, ls.withStereo);
+		// ground term labels are compared by equality, and the groundness is invariant under isomorphism
+		if(ls.type == LabelType::Term && !ls.withStereo && isCanonicalisable(*g, ls.type))
+			return canonicalHash(*g, ls.type, ls.withStereo);
+		[[fallthrough]];
+	case Config::IsomorphismAlg::VF2:
+		return getWLHash(*g, ls.type);
+	}
+	MOD_ABORT;
+}
+
 const std::vector<std::shared_ptr<graph::Graph>> &Collection::asList() const {
 	return graphs;
 }
@@ -81,14 +163,18 @@ std::shared_ptr<graph::Graph> Collection::findIsomorphic(std::shared_ptr<graph::
 	if(iterStore == end(graphStore)) return nullptr;
 	const auto iterGraph = iterStore->second->find(gLib);
 	if(iterGraph != iterStore->second->end()) return g;
-	return iterStore->second->findIsomorphic(gLib, ls);
+	return iterStore->second->findIsomorphic(gLib, getIndexKey(gLib), ls);
 }
 
 std::shared_ptr<graph::Graph> Collection::findIsomorphic(lib::Graph::Single *g) const {
+	return findIsomorphic(g, getIndexKey(g));
+}
+
+std::shared_ptr<graph::Graph> Collection::findIsomorphic(lib::Graph::Single *g, std::size_t indexKey) const {
 	const auto stats = getStats(g);
 	const auto iterStore = graphStore.find(stats);
 	if(iterStore == end(graphStore)) return nullptr;
-	return iterStore->second->findIsomorphic(g, ls);
+	return iterStore->second->findIsomorphic(g, indexKey, ls);
 }
 
 bool Collection::trustInsert(std::shared_ptr<graph::Graph> g) {
@@ -97,11 +183,11 @@ bool Collection::trustInsert(std::shared_ptr<graph::Graph> g) {
 	auto iterStore = graphStore.find(stats);
 	if(iterStore == end(graphStore)) {
 		iterStore = graphStore.emplace(stats, std::make_unique<Store>()).first;
-		iterStore->second->trustInsert(gLib);
+		iterStore->second->trustInsert(gLib, getIndexKey(gLib));
 		graphs.push_back(g);
 		return true;
 	} else {
-		const bool res = iterStore->second->trustInsert(gLib);
+		const bool res = iterStore->second->trustInsert(gLib, getIndexKey(gLib));
 		if(res) graphs.push_back(g);
 		return res;
 	}
@@ -114,4 +200,24 @@ std::pair<std::shared_ptr<graph::Graph>, bool> Collection::tryInsert(std::shared
 	return {g, true};
 }
 
+void Collection::prepareForConcurrentLookup() {
+	const auto isoAlg = getConfig().graph.isomorphismAlg.get();
+	if(numPreparedForLookup != 0 && isoAlg != preparedAlg)
+		numPreparedForLookup = 0;
+	preparedAlg = isoAlg;
+	for(; numPreparedForLookup != graphs.size(); ++numPreparedForLookup)
+		prepareForConcurrentLookup(graphs[numPreparedForLookup]->getGraph(), ls);
+}
+
+void Collection::prepareForConcurrentLookup(const lib::Graph::Single &g, LabelSettings ls) {
+	const auto isoAlg = getConfig().graph.isomorphismAlg.get();
+	// mirror what Single::isomorphic needs
+	get_vertex_order(g.getLabelledGraph());
+	if(isoAlg == Config::IsomorphismAlg::VF2) return;
+	if(isoAlg == Config::IsomorphismAlg::SmilesCanonVF2 && g.getMoleculeState().getIsMolecule())
+		g.getSmiles();
+	if((ls.type == LabelType::String || !ls.withStereo) && isCanonicalisable(g, ls.type))
+		g.getCanonForm(ls.type, ls.withStereo);
+}
+
 } // namespace mod::lib::Graph
\ No newline at end of file
@@ -45,6 +45,13 @@ struct Collection {
 	// By isomorphism, but g may not necessarily be wrapped yet.
 	// Returns nullptr if non found.
 	std::shared_ptr<graph::Graph> findIsomorphic(lib::Graph::Single *g) const;
+	// As above, but with indexKey == getIndexKey(g) computed in advance.
+	std::shared_ptr<graph::Graph> findIsomorphic(lib::Graph::Single *g, std::size_t indexKey) const;
+	// An isomorphism invariant used for indexing the graphs within each size bucket,
+	// so that only graphs with equal keys must be checked for isomorphism.
+	// It may compute and cache the SMILES string or canonical form of g, but it does not access the stored graphs,
+	// so it may be called concurrently for different graphs, as long as the collection is not modified.
+	std::size_t getIndexKey(const lib::Graph::Single *g) const;
 public:
 	// Insert without checking for isomorphism.
 	// Still checks for pointer equality.
@@ -56,12 +63,23 @@ public:
 	// If inserted, return g, otherwise return an isomorphic graph.
 	// Note: if the same graph object is already present, the return value is <g, false>.
 	std::pair<std::shared_ptr<graph::Graph>, bool> tryInsert(std::shared_ptr<graph::Graph> g);
+	// Computes the data of the stored graphs that the isomorphism checks may otherwise compute lazily,
+	// with the current isomorphism algorithm in the config.
+	// Afterwards the lookup functions may be called concurrently, until the collection is modified.
+	void prepareForConcurrentLookup();
+	// As above, but for a single graph, e.g., one which is not yet in a collection,
+	// but which other threads may compare with in Single::isomorphic.
+	static void prepareForConcurrentLookup(const lib::Graph::Single &g, LabelSettings ls);
 private:
 	struct Store;
 	const LabelSettings ls;
+	const Config::IsomorphismAlg alg;
 	std::unordered_map<CollectionStats, std::unique_ptr<Store>> graphStore;
 	// owning part
 	std::vector<std::shared_ptr<graph::Graph>> graphs;
+	// graphs[0, numPreparedForLookup) have been prepared with preparedAlg
+	std::size_t numPreparedForLookup = 0;
+	Config::IsomorphismAlg preparedAlg;
 };
 
 } // namespace mod::lib::Graph
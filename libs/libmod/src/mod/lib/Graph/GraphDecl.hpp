@@ -1,6 +1,7 @@
 #ifndef MOD_LIB_GRAPH_GRAPHDECL_HPP
 #define MOD_LIB_GRAPH_GRAPHDECL_HPP
 
+#include <jla_boost/graph/CSRGraph.hpp>
 #include <jla_boost/graph/EdgeIndexedAdjacencyList.hpp>
 
 namespace mod::lib::Graph {
@@ -8,6 +9,8 @@ namespace mod::lib::Graph {
 using GraphType = jla_boost::EdgeIndexedAdjacencyList<boost::undirectedS>;
 using Vertex = boost::graph_traits<GraphType>::vertex_descriptor;
 using Edge = boost::graph_traits<GraphType>::edge_descriptor;
+// The frozen form of a GraphType, with the same vertex and edge indices.
+using CSRGraphType = jla_boost::CSRGraph;
 
 } // namespace mod::lib::Graph
 
@@ -119,7 +119,7 @@ Result<std::vector<Data>> gml(lib::IO::Warnings &warnings, std::string_view src)
 		auto &g = *datas[comp].g;
 		const auto v = add_vertex(g);
 		assert(vGML.label);
-		datas[comp].pString->addVertex(v, *vGML.label);
+		datas[comp].pString->addVertex(v, InternedString(*vGML.label));
 		datas[comp].externalToInternalIds.emplace(vGML.id, get(boost::vertex_index_t(), g, v));
 		extIDFromVertex[comp].emplace(v, vGML.id);
 	}
@@ -142,7 +142,7 @@ Result<std::vector<Data>> gml(lib::IO::Warnings &warnings, std::string_view src)
 			               + " and target " + std::to_string(eGML.target) + ".");
 		const auto e = add_edge(vSrc, vTar, g);
 		assert(eGML.label);
-		datas[comp].pString->addEdge(e.first, *eGML.label);
+		datas[comp].pString->addEdge(e.first, InternedString(*eGML.label));
 	}
 
 	bool doStereo = false;
@@ -389,7 +389,7 @@ public:
 	ConvertRes operator()(LabelVertex &vDFS) {
 		const int component = components[vDFS.connectedComponentID];
 		const GVertex v = add_vertex(*gPtrs[component]);
-		pStringPtrs[component]->addVertex(v, vDFS.label);
+		pStringPtrs[component]->addVertex(v, InternedString(vDFS.label));
 		if(vDFS.ringClosure) {
 			const auto componentRing = components[vDFS.ringClosure->connectedComponentID];
 			const auto vRing = vertex(vDFS.ringClosure->gVertexId, *gPtrs[componentRing]);
@@ -411,7 +411,7 @@ private:
 		assert(!edge(vSrc, vTar, *gPtrs[srcComponent]).second);
 		std::pair<GEdge, bool> e = add_edge(vSrc, vTar, *gPtrs[srcComponent]);
 		assert(e.second);
-		pStringPtrs[srcComponent]->addEdge(e.first, label);
+		pStringPtrs[srcComponent]->addEdge(e.first, InternedString(label));
 	}
 private:
 	std::vector<std::unique_ptr<lib::Graph::GraphType>> &gPtrs;
@@ -456,9 +456,9 @@ struct ImplicitHydrogenAdder {
 		const auto hydrogenAdder = [](lib::Graph::GraphType &g, lib::Graph::PropString &pString,
 		                              lib::Graph::Vertex p) {
 			const GVertex v = add_vertex(g);
-			pString.addVertex(v, "H");
+			pString.addVertex(v, InternedString("H"));
 			const GEdge e = add_edge(v, p, g).first;
-			pString.addEdge(e, "-");
+			pString.addEdge(e, InternedString("-"));
 		};
 		lib::Chem::addImplicitHydrogens(g, pString, gVertex, atomId, hydrogenAdder);
 	}
@@ -0,0 +1,52 @@
+#ifndef MOD_LIB_GRAPH_LABELLED_CSR_GRAPH_HPP
+#define MOD_LIB_GRAPH_LABELLED_CSR_GRAPH_HPP
+
+#include <mod/lib/Graph/LabelledGraph.hpp>
+#include <mod/lib/Graph/Properties/String.hpp>
+
+namespace mod::lib::Graph {
+
+// A view of a LabelledGraph through its graph in compressed sparse row form,
+// with only the string labels. Use it for morphisms with LabelType::String and without stereo.
+// The vertices and edges have the same indices as in the LabelledGraph.
+struct LabelledCSRGraph {
+	using GraphType = CSRGraphType;
+	using PropTermType = void;
+	using PropStereoType = void;
+public:
+	struct PropStringType {
+		using Handler = IdentityPropertyHandler;
+	public:
+		friend const InternedString &get(const PropStringType &p, boost::graph_traits<GraphType>::vertex_descriptor v) {
+			// the vertex descriptors of GraphType are also the indices
+			return p.p[v];
+		}
+
+		friend const InternedString &get(const PropStringType &p, boost::graph_traits<GraphType>::edge_descriptor e) {
+			return p.p.getByEdgeIndex(e.id);
+		}
+	public:
+		const PropString &p;
+	};
+public:
+	explicit LabelledCSRGraph(const LabelledGraph &lg) : lg(lg) {}
+
+	friend const GraphType &get_graph(const LabelledCSRGraph &g) {
+		return get_csr_graph(g.lg);
+	}
+
+	friend PropStringType get_string(const LabelledCSRGraph &g) {
+		return PropStringType{get_string(g.lg)};
+	}
+
+	friend const std::vector<boost::graph_traits<GraphType>::vertex_descriptor> &
+	get_vertex_order(const LabelledCSRGraph &g) {
+		return get_vertex_order(g.lg);
+	}
+private:
+	const LabelledGraph &lg;
+};
+
+} // namespace mod::lib::Graph
+
+#endif // MOD_LIB_GRAPH_LABELLED_CSR_GRAPH_HPP
@@ -51,14 +51,15 @@ const LabelledGraph::PropStringType &get_string(const LabelledGraph &g) {
 }
 
 LabelledGraph::PropTermType &get_term(LabelledGraph &g) {
-	assert(g.pString || g.pTerm);
-	if(!g.pTerm) g.pTerm.reset(new LabelledGraph::PropTermType(get_graph(g), get_string(g), lib::Term::getStrings()));
-	return *g.pTerm;
+	const auto &gConst = g;
+	return const_cast<LabelledGraph::PropTermType &>(get_term(gConst));
 }
 
 const LabelledGraph::PropTermType &get_term(const LabelledGraph &g) {
 	assert(g.pString || g.pTerm);
-	if(!g.pTerm) g.pTerm.reset(new LabelledGraph::PropTermType(get_graph(g), get_string(g), lib::Term::getStrings()));
+	std::call_once(g.termFlag, [&g]() {
+		g.pTerm.reset(new LabelledGraph::PropTermType(get_graph(g), get_string(g), lib::Term::getStrings()));
+	});
 	return *g.pTerm;
 }
 
@@ -82,19 +83,25 @@ const LabelledGraph::PropStereoType &get_stereo(const LabelledGraph &g) {
 }
 
 const LabelledGraph::PropMoleculeType &get_molecule(const LabelledGraph &g) {
-	// this makes some GCC versions generate better code than having the unlikely branch in the if
-	if(g.pMolecule)
-		return *g.pMolecule;
-	g.pMolecule.reset(new LabelledGraph::PropMoleculeType(get_graph(g), get_string(g)));
+	std::call_once(g.moleculeFlag, [&g]() {
+		g.pMolecule.reset(new LabelledGraph::PropMoleculeType(get_graph(g), get_string(g)));
+	});
 	return *g.pMolecule;
 }
 
 const std::vector<typename boost::graph_traits<GraphType>::vertex_descriptor> &
 get_vertex_order(const LabelledGraph &g) {
-	if(g.vertex_order.empty()) {
+	std::call_once(g.vertexOrderFlag, [&g]() {
 		g.vertex_order = get_vertex_order(mod::lib::GraphMorphism::DefaultFinderArgsProvider(), get_graph(g));
-	}
+	});
 	return g.vertex_order;
 }
 
+const CSRGraphType &get_csr_graph(const LabelledGraph &g) {
+	std::call_once(g.csrFlag, [&g]() {
+		g.csr = std::make_unique<CSRGraphType>(*g.g);
+	});
+	return *g.csr;
+}
+
 } // namespace mod::lib::Graph
\ No newline at end of file
@@ -3,6 +3,8 @@
 
 #include <mod/lib/Graph/GraphDecl.hpp>
 
+#include <mutex>
+
 namespace mod::lib::Graph {
 struct PropMolecule;
 struct PropStereo;
@@ -26,6 +28,7 @@ public: // LabelledGraphConcept
 	friend const GraphType &get_graph(const LabelledGraph &g);
 	friend PropStringType &get_string(LabelledGraph &g);
 	friend const PropStringType &get_string(const LabelledGraph &g);
+	// The term labels, the molecule view, and the vertex order are created on the first call, which is thread-safe.
 	friend PropTermType &get_term(LabelledGraph &g);
 	friend const PropTermType &get_term(const LabelledGraph &g);
 	friend bool has_stereo(const LabelledGraph &g);
@@ -34,14 +37,22 @@ public: // LabelledGraphConcept
 public:
 	friend const std::vector<typename boost::graph_traits<GraphType>::vertex_descriptor> &
 	get_vertex_order(const LabelledGraph &g);
+	// The graph in compressed sparse row form, for faster traversal.
+	// It is created on the first call, which is thread-safe, so the graph must not be modified afterwards.
+	friend const CSRGraphType &get_csr_graph(const LabelledGraph &g);
 private: // intrinsic data
 	std::unique_ptr<GraphType> g;
 	mutable std::unique_ptr<PropStringType> pString;
+	mutable std::once_flag termFlag;
 	mutable std::unique_ptr<PropTermType> pTerm;
 	mutable std::unique_ptr<PropStereo> pStereo;
 private: // views
+	mutable std::once_flag moleculeFlag;
 	mutable std::unique_ptr<PropMoleculeType> pMolecule;
 private: // optimisation
+	mutable std::once_flag csrFlag;
+	mutable std::unique_ptr<CSRGraphType> csr;
+	mutable std::once_flag vertexOrderFlag;
 	mutable std::vector<typename boost::graph_traits<GraphType>::vertex_descriptor> vertex_order;
 };
 
@@ -38,6 +38,8 @@ PropMolecule::PropMolecule(const GraphType &g, const PropString &pString) : Base
 	}
 
 	verify(&g);
+	// computed eagerly, so concurrent calls of getExactMass do not race
+	if(isMolecule) exactMass = computeExactMass();
 }
 
 bool PropMolecule::getIsMolecule() const {
@@ -66,14 +68,16 @@ const lib::Chem::OBMolHandle &PropMolecule::getOBMol() const {
 
 double PropMolecule::getExactMass() const {
 	if(!getIsMolecule()) MOD_ABORT;
-	if(!exactMass) {
-		const auto vs = vertices(*g);
-		exactMass = std::accumulate(vs.first, vs.second, 0.0, [&](double val, const auto v) {
-			const auto &ad = (*this)[v];
-			return val + lib::Chem::exactMass(ad.getAtomId(), ad.getIsotope()) - lib::Chem::electronMass * ad.getCharge();
-		});
-	}
-	return *exactMass;
+	if(exactMass) return *exactMass;
+	return computeExactMass();
+}
+
+double PropMolecule::computeExactMass() const {
+	const auto vs = vertices(*g);
+	return std::accumulate(vs.first, vs.second, 0.0, [&](double val, const auto v) {
+		const auto &ad = (*this)[v];
+		return val + lib::Chem::exactMass(ad.getAtomId(), ad.getIsotope()) - lib::Chem::electronMass * ad.getCharge();
+	});
 }
 
 double PropMolecule::getEnergy() const {
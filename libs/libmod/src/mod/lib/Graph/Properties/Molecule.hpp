@@ -23,9 +23,11 @@ public:
 	double getExactMass() const;
 	double getEnergy() const;
 	void cacheEnergy(double value) const;
+private:
+	double computeExactMass() const;
 private:
 	bool isMolecule;
-	mutable std::optional<double> exactMass;
+	std::optional<double> exactMass;
 #ifdef MOD_HAVE_OPENBABEL
 	mutable lib::Chem::OBMolHandle obMol;
 #endif
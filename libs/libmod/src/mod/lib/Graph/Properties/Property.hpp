@@ -27,6 +27,8 @@ public:
 	void addEdge(Edge e, const EdgeType &label);
 	const VertexType &operator[](Vertex v) const;
 	const EdgeType &operator[](Edge e) const;
+	// for graph views with the same edge indices, e.g., CSRGraphType
+	const EdgeType &getByEdgeIndex(std::size_t eId) const;
 	Derived &getDerived();
 	const Derived &getDerived() const;
 protected:
@@ -91,6 +93,12 @@ const EdgeType &Prop<Derived, VertexType, EdgeType>::operator[](Edge e) const {
 	return edgeState[get(boost::edge_index_t(), *g, e)];
 }
 
+template<typename Derived, typename VertexType, typename EdgeType>
+const EdgeType &Prop<Derived, VertexType, EdgeType>::getByEdgeIndex(std::size_t eId) const {
+	assert(eId < edgeState.size());
+	return edgeState[eId];
+}
+
 template<typename Derived, typename VertexType, typename EdgeType>
 Derived &Prop<Derived, VertexType, EdgeType>::getDerived() {
 	return static_cast<Derived &> (*this);
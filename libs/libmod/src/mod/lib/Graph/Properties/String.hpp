@@ -2,11 +2,13 @@
 #define MOD_LIB_GRAPH_PROP_LABEL_HPP
 
 #include <mod/lib/Graph/Properties/Property.hpp>
+#include <mod/lib/LabelInterner.hpp>
 
 namespace mod::lib::Graph {
 
-struct PropString : Prop<PropString, std::string, std::string> {
-	using Base = Prop<PropString, std::string, std::string>;
+// The labels are stored as ids in the global LabelInterner.
+struct PropString : Prop<PropString, InternedString, InternedString> {
+	using Base = Prop<PropString, InternedString, InternedString>;
 public:
 	explicit PropString(const GraphType &g) : Base(g) {
 		Base::verify(&g);
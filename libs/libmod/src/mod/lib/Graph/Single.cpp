@@ -1,15 +1,19 @@
 #include "Single.hpp"
 
+#include <mod/Error.hpp>
 #include <mod/Misc.hpp>
 #include <mod/VertexMap.hpp>
 #include <mod/graph/Graph.hpp>
 #include <mod/graph/GraphInterface.hpp>
+#include <mod/lib/Algorithm/Parallel.hpp>
 #include <mod/lib/Chem/MoleculeUtil.hpp>
 #include <mod/lib/Chem/Smiles.hpp>
+#include <mod/lib/Graph/CanonCache.hpp>
 #include <mod/lib/Graph/Canonicalisation.hpp>
 #include <mod/lib/Graph/IO/DepictionData.hpp>
 #include <mod/lib/Graph/IO/Read.hpp>
 #include <mod/lib/Graph/IO/Write.hpp>
+#include <mod/lib/Graph/LabelledCSRGraph.hpp>
 #include <mod/lib/Graph/Properties/Molecule.hpp>
 #include <mod/lib/Graph/Properties/Stereo.hpp>
 #include <mod/lib/Graph/Properties/String.hpp>
@@ -19,6 +23,7 @@
 #include <mod/lib/IO/IO.hpp>
 #include <mod/lib/LabelledGraph.hpp>
 #include <mod/lib/Random.hpp>
+#include <mod/lib/Term/GroundTerm.hpp>
 #include <mod/lib/Term/WAM.hpp>
 
 #include <jla_boost/graph/morphism/callbacks/Limit.hpp>
@@ -30,13 +35,30 @@
 #include <boost/graph/graph_traits.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <algorithm>
+#include <atomic>
+
 namespace mod::lib::Graph {
 BOOST_CONCEPT_ASSERT((LabelledGraphConcept<LabelledGraph>));
 
 namespace {
-std::size_t nextGraphNum = 0;
+// graphs may be created concurrently, e.g., in DGs built from different Python threads
+std::atomic<std::size_t> nextGraphNum(0);
+// set by Single::IdRange
+thread_local std::size_t *threadNextGraphNum = nullptr;
+thread_local std::size_t threadGraphNumEnd = 0;
+
+
+std::size_t takeIds(std::size_t n) {
+	if(!threadNextGraphNum) return nextGraphNum.fetch_add(n);
+	const auto res = *threadNextGraphNum;
+	*threadNextGraphNum += n;
+	if(*threadNextGraphNum > threadGraphNumEnd)
+		throw FatalError("Too many graphs created in a range of graph ids.");
+	return res;
+}
 
-const std::string getGraphName(unsigned int id) {
+const std::string getGraphName(std::size_t id) {
 	return "g_{" + boost::lexical_cast<std::string>(id) + "}";
 }
 
@@ -82,8 +104,12 @@ bool sanityCheck(const GraphType &g, const PropString &pString, std::ostream &s)
 } // namespace
 
 Single::Single(std::unique_ptr<GraphType> g, std::unique_ptr<PropString> pString, std::unique_ptr<PropStereo> pStereo)
+		: Single(std::move(g), std::move(pString), std::move(pStereo), takeIds(1)) {}
+
+Single::Single(std::unique_ptr<GraphType> g, std::unique_ptr<PropString> pString, std::unique_ptr<PropStereo> pStereo,
+               std::size_t id)
 		: g(std::move(g), std::move(pString), std::move(pStereo)),
-		  id(nextGraphNum++), name(getGraphName(id)) {
+		  id(id), name(getGraphName(id)) {
 	if(!sanityCheck(getGraph(), getStringState(), std::cout)) {
 		std::cout << "Graph::sanityCheck\tfailed in graph '" << getName() << "'" << std::endl;
 		MOD_ABORT;
@@ -92,6 +118,31 @@ Single::Single(std::unique_ptr<GraphType> g, std::unique_ptr<PropString> pString
 
 Single::~Single() {}
 
+std::size_t Single::reserveIds(std::size_t n) {
+	return takeIds(n);
+}
+
+Single::IdRange::IdRange(std::size_t first)
+		: first(first), next(first), prevNext(threadNextGraphNum), prevEnd(threadGraphNumEnd) {
+	threadNextGraphNum = &next;
+	threadGraphNumEnd = first + Size;
+}
+
+Single::IdRange::~IdRange() {
+	threadNextGraphNum = prevNext;
+	threadGraphNumEnd = prevEnd;
+}
+
+std::size_t Single::IdRange::getNumTaken() const {
+	return next - first;
+}
+
+void Single::renumber(std::size_t id) {
+	assert(name == getGraphName(this->id));
+	this->id = id;
+	name = getGraphName(id);
+}
+
 const LabelledGraph &Single::getLabelledGraph() const {
 	return g;
 }
@@ -120,25 +171,31 @@ void Single::setName(std::string name) {
 }
 
 const std::pair<const std::string &, bool> Single::getGraphDFS() const {
-	if(!dfs) std::tie(dfs, dfsHasNonSmilesRingClosure) = Write::dfs(getLabelledGraph(), false);
+	std::call_once(dfsFlag, [this]() {
+		std::tie(dfs, dfsHasNonSmilesRingClosure) = Write::dfs(getLabelledGraph(), false);
+	});
 	return std::pair<const std::string &, bool>(*dfs, dfsHasNonSmilesRingClosure);
 }
 
 const std::string &Single::getGraphDFSWithIds() const {
-	if(!dfsWithIds) dfsWithIds = Write::dfs(getLabelledGraph(), true).first;
+	std::call_once(dfsWithIdsFlag, [this]() {
+		dfsWithIds = Write::dfs(getLabelledGraph(), true).first;
+	});
 	return *dfsWithIds;
 }
 
 const std::string &Single::getSmiles() const {
 	if(getMoleculeState().getIsMolecule()) {
-		if(!smiles) {
+		std::call_once(smilesFlag, [this]() {
 			if(getConfig().graph.useWrongSmilesCanonAlg.get()) {
 				smiles = Chem::getSmiles(getGraph(), getMoleculeState(), nullptr, false);
 			} else {
 				getCanonForm(LabelType::String, false); // TODO: make the withStereo a parameter
-				smiles = Chem::getSmiles(getGraph(), getMoleculeState(), &canon_perm_string, false);
+				// the canonicalisation usually gives us the SMILES string as well
+				if(!smiles)
+					smiles = Chem::getSmiles(getGraph(), getMoleculeState(), &canon_perm_string, false);
 			}
-		}
+		});
 		return *smiles;
 	} else {
 		std::string text;
@@ -151,14 +208,14 @@ const std::string &Single::getSmiles() const {
 
 const std::string &Single::getSmilesWithIds() const {
 	if(getMoleculeState().getIsMolecule()) {
-		if(!smilesWithIds) {
+		std::call_once(smilesWithIdsFlag, [this]() {
 			if(getConfig().graph.useWrongSmilesCanonAlg.get()) {
 				smilesWithIds = Chem::getSmiles(getGraph(), getMoleculeState(), nullptr, true);
 			} else {
 				getCanonForm(LabelType::String, false); // TODO: make the withStereo a parameter
 				smilesWithIds = Chem::getSmiles(getGraph(), getMoleculeState(), &canon_perm_string, true);
 			}
-		}
+		});
 		return *smilesWithIds;
 	} else {
 		std::string text;
@@ -190,12 +247,16 @@ unsigned int Single::getEdgeLabelCount(const std::string &label) const {
 }
 
 Write::DepictionData &Single::getDepictionData() {
-	if(!depictionData) depictionData.reset(new Write::DepictionData(getLabelledGraph()));
+	std::call_once(depictionDataFlag, [this]() {
+		depictionData.reset(new Write::DepictionData(getLabelledGraph()));
+	});
 	return *depictionData;
 }
 
 const Write::DepictionData &Single::getDepictionData() const {
-	if(!depictionData) depictionData.reset(new Write::DepictionData(getLabelledGraph()));
+	std::call_once(depictionDataFlag, [this]() {
+		depictionData.reset(new Write::DepictionData(getLabelledGraph()));
+	});
 	return *depictionData;
 }
 
@@ -215,16 +276,49 @@ const PropMolecule &Single::getMoleculeState() const {
 }
 
 const Single::CanonForm &Single::getCanonForm(LabelType labelType, bool withStereo) const {
-	if(labelType != LabelType::String)
-		throw LogicError("Can only canonicalise with label type string.");
-	// TODO: when Terms are supported, remember to check if the state is valid, else throw TermParsingError
-	if(withStereo)
-		throw LogicError("Can not canonicalise stereo.");
-	if(!canon_form_string) {
-		assert(!aut_group_string);
-		std::tie(canon_perm_string, canon_form_string, aut_group_string) = lib::Graph::getCanonForm(*this, labelType,
-		                                                                                            withStereo);
+	if(labelType == LabelType::Term) {
+		const auto &term = get_term(getLabelledGraph());
+		if(!isValid(term)) {
+			std::string msg = "Parsing failed for graph '" + getName() + "'. " + term.getParsingError();
+			throw TermParsingError(std::move(msg));
+		}
+		// the ground-term ids are not persistent, so the persistent cache is not used
+		std::call_once(canonFlagTerm, [this, labelType, withStereo]() {
+			assert(!aut_group_term);
+			std::tie(canon_perm_term, canon_form_term, aut_group_term) = lib::Graph::getCanonForm(*this, labelType,
+			                                                                                      withStereo);
+		});
+		assert(aut_group_term);
+		return *canon_form_term;
 	}
+	if(withStereo) {
+		// the persistent cache is keyed without the stereo information, so it is not used
+		std::call_once(canonFlagStereo, [this, labelType, withStereo]() {
+			assert(!aut_group_stereo);
+			std::tie(canon_perm_stereo, canon_form_stereo, aut_group_stereo) = lib::Graph::getCanonForm(*this, labelType,
+			                                                                                            withStereo);
+		});
+		assert(aut_group_stereo);
+		return *canon_form_stereo;
+	}
+	std::call_once(canonFlagString, [this, labelType, withStereo]() {
+		assert(!aut_group_string);
+		if(auto cached = CanonCache::lookup(*this)) {
+			std::tie(canon_perm_string, canon_form_string, aut_group_string) = lib::Graph::makeCanonForm(
+					*this, std::move(cached->perm), cached->generators);
+			if(cached->smiles && !smiles && !getConfig().graph.useWrongSmilesCanonAlg.get())
+				smiles = std::move(*cached->smiles);
+		} else {
+			std::tie(canon_perm_string, canon_form_string, aut_group_string) = lib::Graph::getCanonForm(*this, labelType,
+			                                                                                            withStereo);
+			// the SMILES string is stored in the same entry, so it is made now for molecules
+			const bool canonSmiles = !getConfig().graph.useWrongSmilesCanonAlg.get();
+			if(canonSmiles && !smiles && getMoleculeState().getIsMolecule())
+				smiles = Chem::getSmiles(getGraph(), getMoleculeState(), &canon_perm_string, false);
+			CanonCache::store(*this, canon_perm_string, *aut_group_string,
+			                  canonSmiles && smiles ? &*smiles : nullptr);
+		}
+	});
 	assert(canon_form_string);
 	assert(aut_group_string);
 	return *canon_form_string;
@@ -232,10 +326,41 @@ const Single::CanonForm &Single::getCanonForm(LabelType labelType, bool withSter
 
 const Single::AutGroup &Single::getAutGroup(LabelType labelType, bool withStereo) const {
 	getCanonForm(labelType, withStereo);
+	if(labelType == LabelType::Term) return *aut_group_term;
+	if(withStereo) return *aut_group_stereo;
 	assert(aut_group_string);
 	return *aut_group_string;
 }
 
+const Single::GroundTermIds &Single::getGroundTermIds() const {
+	std::call_once(groundTermIdsFlag, [this]() {
+		const auto &graph = getGraph();
+		const auto &term = get_term(getLabelledGraph());
+		assert(isValid(term));
+		auto ids = std::make_unique<GroundTermIds>();
+		ids->vertices.resize(num_vertices(graph));
+		ids->edges.resize(num_edges(graph));
+		const auto setId = [&term](std::size_t &id, const auto x) {
+			const auto res = lib::Term::getGroundTermId(getMachine(term), {lib::Term::AddressType::Heap, term[x]});
+			if(res) id = *res;
+			return res.has_value();
+		};
+		const auto vs = vertices(graph);
+		const auto es = edges(graph);
+		ids->isGround = std::all_of(vs.first, vs.second, [&](const Vertex v) {
+			return setId(ids->vertices[get(boost::vertex_index_t(), graph, v)], v);
+		}) && std::all_of(es.first, es.second, [&](const Edge e) {
+			return setId(ids->edges[get(boost::edge_index_t(), graph, e)], e);
+		});
+		if(!ids->isGround) {
+			ids->vertices.clear();
+			ids->edges.clear();
+		}
+		groundTermIds = std::move(ids);
+	});
+	return *groundTermIds;
+}
+
 //------------------------------------------------------------------------------
 // Static
 //------------------------------------------------------------------------------
@@ -261,22 +386,38 @@ std::size_t morphismMax(const Single &gDomain,
                         LabelSettings labelSettings,
                         Finder finder) {
 	auto mr = GM::makeLimit(maxNumMatches);
-	morphism(gDomain, gCodomain, labelSettings, finder, std::ref(mr));
+	if(labelSettings.type == LabelType::String && !labelSettings.withStereo) {
+		// the vertex maps are not exposed, so we can use the faster graph form
+		lib::GraphMorphism::morphismStringLabels(LabelledCSRGraph(gDomain.getLabelledGraph()),
+		                                         LabelledCSRGraph(gCodomain.getLabelledGraph()),
+		                                         finder, std::ref(mr));
+	} else {
+		morphism(gDomain, gCodomain, labelSettings, finder, std::ref(mr));
+	}
 	return mr.getNumHits();
 }
 
 std::size_t isomorphismSmilesOrCanonOrVF2(const Single &gDom, const Single &gCodom, LabelSettings labelSettings) {
 	const auto &ggDom = gDom.getLabelledGraph();
 	const auto &ggCodom = gCodom.getLabelledGraph();
-	// first try if we can compare canonical SMILES strings
-	if(get_molecule(ggDom).getIsMolecule() && get_molecule(ggCodom).getIsMolecule() &&
+	// first try if we can compare canonical SMILES strings, which do not have stereo information
+	if(!labelSettings.withStereo && get_molecule(ggDom).getIsMolecule() && get_molecule(ggCodom).getIsMolecule() &&
 	   !getConfig().graph.useWrongSmilesCanonAlg.get())
 		return gDom.getSmiles() == gCodom.getSmiles() ? 1 : 0;
 
 	// otherwise maybe we can still do canonical form comparison
-	if(labelSettings.type == LabelType::String && !labelSettings.withStereo) {
+	// (with stereo, only for graphs where it can not fail)
+	const bool canCompareStereo = labelSettings.stereoRelation == LabelRelation::Isomorphism
+	                              && isCanonicalisable(gDom, LabelType::String)
+	                              && isCanonicalisable(gCodom, LabelType::String);
+	if(labelSettings.type == LabelType::String && (!labelSettings.withStereo || canCompareStereo)) {
 		return canonicalCompare(gDom, gCodom, labelSettings.type, labelSettings.withStereo) ? 1 : 0;
 	}
+	// and with term labels, when all terms are ground
+	if(labelSettings.type == LabelType::Term && !labelSettings.withStereo
+	   && labelSettings.relation == LabelRelation::Isomorphism
+	   && isCanonicalisable(gDom, LabelType::Term) && isCanonicalisable(gCodom, LabelType::Term))
+		return canonicalCompare(gDom, gCodom, labelSettings.type, labelSettings.withStereo) ? 1 : 0;
 
 	// otherwise, we have no choice but to use VF2
 	return Single::isomorphismVF2(gDom, gCodom, 1, labelSettings);
@@ -290,7 +431,7 @@ std::size_t Single::isomorphismVF2(const Single &gDom, const Single &gCodom, std
 }
 
 bool Single::isomorphic(const Single &gDom, const Single &gCodom, LabelSettings labelSettings) {
-	++getConfig().graph.numIsomorphismCalls();
+	incrementConcurrently(getConfig().graph.numIsomorphismCalls());
 	const auto nDom = num_vertices(gDom.getGraph());
 	const auto nCodom = num_vertices(gCodom.getGraph());
 	if(nDom != nCodom) return false; // early bail-out
@@ -309,6 +450,11 @@ bool Single::isomorphic(const Single &gDom, const Single &gCodom, LabelSettings
 			throw LogicError("Can only do isomorphism via canonicalisation with the isomorphism relation.");
 		if(labelSettings.withStereo && labelSettings.stereoRelation != LabelRelation::Isomorphism)
 			throw LogicError("Can only do isomorphism via canonicalisation with the isomorphism stereo relation.");
+		// terms with variables are only equal up to renaming, which the canonical form does not capture,
+		// so they are handled by VF2
+		if(labelSettings.type == LabelType::Term && !labelSettings.withStereo
+		   && !(isCanonicalisable(gDom, LabelType::Term) && isCanonicalisable(gCodom, LabelType::Term)))
+			return isomorphismVF2(gDom, gCodom, 1, labelSettings);
 		return canonicalCompare(gDom, gCodom, labelSettings.type, labelSettings.withStereo);
 	}
 	MOD_ABORT;
@@ -316,7 +462,7 @@ bool Single::isomorphic(const Single &gDom, const Single &gCodom, LabelSettings
 
 std::size_t
 Single::isomorphism(const Single &gDom, const Single &gCodom, std::size_t maxNumMatches, LabelSettings labelSettings) {
-	++getConfig().graph.numIsomorphismCalls();
+	incrementConcurrently(getConfig().graph.numIsomorphismCalls());
 	if(maxNumMatches == 1)
 		return isomorphic(gDom, gCodom, labelSettings) ? 1 : 0;
 	// this hax with name comparing is basically to make abstract derivation graphs
@@ -396,7 +542,7 @@ bool Single::canonicalCompare(const Single &g1, const Single &g2, LabelType labe
 	return lib::Graph::canonicalCompare(g1, g2, labelType, withStereo);
 }
 
-Single makePermutation(const Single &g) {
+std::unique_ptr<Single> makePermutation(const Single &g) {
 	if(has_stereo(g.getLabelledGraph()))
 		throw mod::FatalError("Can not (yet) permute graphs with stereo information.");
 	std::unique_ptr<PropString> pString;
@@ -412,7 +558,8 @@ Single makePermutation(const Single &g) {
 		                                     pString->addEdge(eNew, g.getStringState()[eOld]);
 	                                     }
 	);
-	Single gPerm(std::move(gBoost), std::move(pString), nullptr);
+	auto gPermPtr = std::make_unique<Single>(std::move(gBoost), std::move(pString), nullptr);
+	const Single &gPerm = *gPermPtr;
 	if(getConfig().graph.checkIsoInPermutation.get()) {
 		const bool iso = 1 == Single::isomorphismVF2(g, gPerm, 1,
 		                                             {LabelType::String, LabelRelation::Isomorphism, false,
@@ -431,7 +578,7 @@ Single makePermutation(const Single &g) {
 			MOD_ABORT;
 		}
 	}
-	return gPerm;
+	return gPermPtr;
 }
 
 } // namespace mod::lib::Graph
\ No newline at end of file
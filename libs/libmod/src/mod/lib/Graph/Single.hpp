@@ -13,6 +13,7 @@
 #include <perm_group/permutation/built_in.hpp>
 
 #include <iosfwd>
+#include <mutex>
 #include <optional>
 #include <string>
 
@@ -35,8 +36,37 @@ public:
 	// requires g != nullptr, pString != nullptr
 	// pStereo may be null
 	Single(std::unique_ptr<GraphType> g, std::unique_ptr<PropString> pString, std::unique_ptr<PropStereo> pStereo);
+	// As above, but with an id obtained from reserveIds.
+	// The ids are otherwise taken from a global counter, so this is the constructor to use
+	// when graphs are created concurrently.
+	Single(std::unique_ptr<GraphType> g, std::unique_ptr<PropString> pString, std::unique_ptr<PropStereo> pStereo,
+	       std::size_t id);
+	// Reserves the ids [res, res + n) for use with the constructor above.
+	// With n = 0 it is the first id not yet taken.
+	// Outside IdRanges it may be called concurrently, but the ids then depend on the scheduling.
+	static std::size_t reserveIds(std::size_t n);
+	// While an IdRange is alive, the graphs created by the thread that made it get their ids from it,
+	// instead of from the global counter.
+	// Graphs created concurrently by different threads can later be given the ids they would have had
+	// if they were created serially, see renumber.
+	struct IdRange {
+		static constexpr std::size_t Size = std::size_t(1) << 32;
+	public:
+		explicit IdRange(std::size_t first);
+		IdRange(const IdRange &) = delete;
+		IdRange &operator=(const IdRange &) = delete;
+		~IdRange();
+		std::size_t getNumTaken() const;
+	private:
+		const std::size_t first;
+		std::size_t next;
+		std::size_t *prevNext;
+		std::size_t prevEnd;
+	};
+	// Changes the id, and the name to the default name for the new id.
+	// It must only be used for graphs which are not yet in a graph database and have the default name.
+	void renumber(std::size_t id);
 public:
-	Single(Single &&) = default;
 	~Single();
 	const LabelledGraph &getLabelledGraph() const;
 	std::size_t getId() const;
@@ -59,9 +89,16 @@ public: // deprecated interface
 public:
 	const CanonForm &getCanonForm(LabelType labelType, bool withStereo) const;
 	const AutGroup &getAutGroup(LabelType labelType, bool withStereo) const;
+	// The hash-consed ids of the ground terms of the labels (see Term/GroundTerm.hpp),
+	// indexed by the vertex and edge indices. They are computed once, and require the term labels to be parsable.
+	struct GroundTermIds {
+		bool isGround; // otherwise a label has a variable, and the ids are empty
+		std::vector<std::size_t> vertices, edges;
+	};
+	const GroundTermIds &getGroundTermIds() const;
 private:
 	LabelledGraph g;
-	const std::size_t id;
+	std::size_t id;
 	std::weak_ptr<graph::Graph> apiReference;
 	std::string name;
 	mutable std::optional<std::string> dfs, dfsWithIds;
@@ -71,7 +108,18 @@ private:
 	mutable std::vector<int> canon_perm_string;
 	mutable std::unique_ptr<const CanonForm> canon_form_string;
 	mutable std::unique_ptr<const AutGroup> aut_group_string;
+	mutable std::vector<int> canon_perm_stereo;
+	mutable std::unique_ptr<const CanonForm> canon_form_stereo;
+	mutable std::unique_ptr<const AutGroup> aut_group_stereo;
+	mutable std::vector<int> canon_perm_term;
+	mutable std::unique_ptr<const CanonForm> canon_form_term;
+	mutable std::unique_ptr<const AutGroup> aut_group_term;
+	mutable std::unique_ptr<const GroundTermIds> groundTermIds;
 	mutable std::unique_ptr<Write::DepictionData> depictionData;
+	// the data above is computed lazily, at most once, so the getters may be called concurrently
+	mutable std::once_flag dfsFlag, dfsWithIdsFlag, smilesFlag, smilesWithIdsFlag;
+	mutable std::once_flag canonFlagString, canonFlagStereo, canonFlagTerm;
+	mutable std::once_flag groundTermIdsFlag, depictionDataFlag;
 public:
 	static std::size_t
 	isomorphismVF2(const Single &gDom, const Single &gCodom, std::size_t maxNumMatches, LabelSettings labelSettings);
@@ -96,7 +144,7 @@ public:
 	};
 };
 
-Single makePermutation(const Single &g);
+std::unique_ptr<Single> makePermutation(const Single &g);
 
 namespace detail {
 
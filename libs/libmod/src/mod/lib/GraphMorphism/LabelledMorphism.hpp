@@ -80,16 +80,26 @@ namespace GM = jla_boost::GraphMorphism;
 
 //------------------------------------------------------------------------------
 
-template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper>
+template<typename Finder, typename = void>
+struct SupportsPairListener : std::false_type {
+};
+
+template<typename Finder>
+struct SupportsPairListener<Finder, std::enable_if_t<Finder::supportsPairListener>> : std::true_type {
+};
+
+// The listener is optional, and only given to the finder if present.
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper,
+		typename ...PairListener>
 bool morphismFinallyDoIt(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Finder finder, MR mr,
-                         PredWrapper predWrapper, MRWrapper mrWrapper) {
+                         PredWrapper predWrapper, MRWrapper mrWrapper, PairListener &...listener) {
 	auto predOuter = predWrapper(gDomain, gCodomain, jla_boost::AlwaysTrue());
 	auto pred = [&predOuter, &gDomain, &gCodomain](const auto &l, const auto &r) {
 		return predOuter(l, r, gDomain, gCodomain);
 	};
 	auto mrWrapped = mrWrapper(gDomain, gCodomain, mr);
 	return finder(get_graph(gDomain), get_graph(gCodomain), mrWrapped, pred, pred,
-	              makeArgsProvider(gDomain), makeArgsProvider(gCodomain));
+	              makeArgsProvider(gDomain), makeArgsProvider(gCodomain), listener...);
 }
 
 template<typename LabGraphDom, typename LabGraphCodom, typename VertexDom, typename VertexCodom, typename PredWrapper>
@@ -112,6 +122,13 @@ bool matchFinallyDoIt(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain
 template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename TermFilter>
 bool morphismCreateTermRelation(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Finder finder,
                                 MR mr, PredWrapper predWrapper, MRWrapper mrWrapper, TermFilter termFilter) {
+	if constexpr(SupportsPairListener<Finder>::value) {
+		if(getConfig().common.incrementalTermUnification.get()) {
+			TermUnifier<LabGraphDom, LabGraphCodom> unifier(gDomain, gCodomain);
+			auto mrFinal = makeToTermVertexMapIncremental(unifier, GM::makeFilter(termFilter, mr));
+			return morphismFinallyDoIt(gDomain, gCodomain, finder, mrFinal, predWrapper, mrWrapper, unifier);
+		}
+	}
 	auto mrFinal = makeToTermVertexMap(gDomain, gCodomain, GM::makeFilter(termFilter, mr));
 	return morphismFinallyDoIt(gDomain, gCodomain, finder, mrFinal, predWrapper, mrWrapper);
 }
@@ -365,6 +382,15 @@ bool morphismSelectByLabelSettings(const LabGraphDom &gDomain, const LabGraphCod
 	}
 }
 
+// For labelled graphs with only string labels, e.g., Graph::LabelledCSRGraph,
+// as morphismSelectByLabelSettings with LabelType::String and without stereo.
+template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder>
+bool morphismStringLabels(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Finder finder, MR mr) {
+	return detail::morphismFinallyDoIt(gDomain, gCodomain, finder, mr,
+	                                   detail::StringLabelPredWrapper<IdentityWrapper>(IdentityWrapper()),
+	                                   IdentityWrapper());
+}
+
 template<typename LabGraphDom, typename LabGraphCodom, typename VertexDom, typename VertexCodom,
 		typename PredWrapper = IdentityWrapper>
 bool predicateSelectByLabelSeetings(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain,
@@ -17,6 +17,7 @@
 #include <mod/lib/Term/IO/Write.hpp>
 
 #include <iostream>
+#include <type_traits>
 
 namespace mod::lib::GraphMorphism {
 
@@ -220,6 +221,109 @@ auto makeToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom, N
 	return ToTermVertexMap<LabGraphDom, LabGraphCodom, Next>(gDom, gCodom, next);
 }
 
+// TermUnifier, incremental unification during the morphism search
+//------------------------------------------------------------------------------
+
+// A pair listener for finders supporting it (see jla_boost::GraphMorphism::NullPairListener).
+// When a vertex pair is added to the partial morphism, the terms of the two vertices are unified,
+// together with the terms of the edges to vertices already in the morphism.
+// The unification is undone when the pair is removed again, using the trail of the machine.
+// A pair is rejected as soon as its terms do not unify with the rest of the morphism,
+// instead of only after a complete morphism has been found as with ToTermVertexMap.
+template<typename LabGraphDom, typename LabGraphCodom>
+struct TermUnifier {
+	TermUnifier(const LabGraphDom &lgDom, const LabGraphCodom &lgCodom)
+			: lgDom(lgDom), lgCodom(lgCodom), machine(getMachine(get_term(lgCodom))), mgu(machine.getHeap().size()) {
+		if(!isValid(get_term(lgDom))) MOD_ABORT;
+		if(!isValid(get_term(lgCodom))) MOD_ABORT;
+		machine.setTemp(getMachine(get_term(lgDom)));
+		machine.startTrail();
+	}
+
+	TermUnifier(const TermUnifier &) = delete;
+	TermUnifier &operator=(const TermUnifier &) = delete;
+
+	template<typename VertexDom, typename VertexCodom, typename VertexMap>
+	bool push(const VertexDom &vDom, const VertexCodom &vCodom, const VertexMap &m) {
+		const auto &gDom = get_graph(lgDom);
+		const auto &gCodom = get_graph(lgCodom);
+		using GraphCodom = std::decay_t<decltype(gCodom)>;
+		marks.push_back(machine.getTrailMark(mgu));
+		bool ok = unify(vDom, vCodom);
+		for(const auto eDom: asRange(out_edges(vDom, gDom))) {
+			if(!ok) break;
+			const auto vCodomAdj = get(m, gDom, gCodom, target(eDom, gDom));
+			if(vCodomAdj == boost::graph_traits<GraphCodom>::null_vertex()) continue;
+			const auto peCodom = edge(vCodom, vCodomAdj, gCodom);
+			if(!peCodom.second) continue; // no edge in the other side
+			ok = unify(eDom, peCodom.first);
+		}
+		if(!ok) {
+			machine.undoTrail(marks.back(), mgu);
+			marks.pop_back();
+		}
+		return ok;
+	}
+
+	template<typename VertexDom, typename VertexCodom>
+	void pop(const VertexDom &, const VertexCodom &) {
+		assert(!marks.empty());
+		machine.undoTrail(marks.back(), mgu);
+		marks.pop_back();
+	}
+
+	// The unification of the current morphism, without the trail.
+	TermData getData() const {
+		TermData data{machine, mgu};
+		data.machine.stopTrail();
+		return data;
+	}
+private:
+	template<typename VEDom, typename VECodom>
+	bool unify(const VEDom &veDom, const VECodom &veCodom) {
+		using Handler = typename LabGraphDom::PropTermType::Handler;
+		return Handler::reduce(
+				std::logical_and<>(),
+				Handler::fmap2(get(get_term(lgDom), veDom), get(get_term(lgCodom), veCodom), lgDom, lgCodom,
+				               TermAssociationHandlerUnifyIncremental(), machine, mgu));
+	}
+
+	struct TermAssociationHandlerUnifyIncremental {
+		template<typename OuterGraphDom, typename OuterGraphCodom>
+		bool operator()(std::size_t l, std::size_t r, const OuterGraphDom &gDom, const OuterGraphCodom &gCodom,
+		                Term::Wam &res, Term::MGU &mgu) const {
+			res.unifyHeapTemp(r, l, mgu);
+			return mgu.status == Term::MGU::Status::Exists;
+		}
+	};
+private:
+	const LabGraphDom &lgDom;
+	const LabGraphCodom &lgCodom;
+	Term::Wam machine;
+	Term::MGU mgu;
+	std::vector<Term::Wam::TrailMark> marks;
+};
+
+// The morphism callback to use with a TermUnifier, adding the unification data to each morphism.
+template<typename Unifier, typename Next>
+struct ToTermVertexMapIncremental {
+	ToTermVertexMapIncremental(const Unifier &unifier, Next next) : unifier(unifier), next(next) {}
+
+	template<typename VertexMap, typename GraphDom, typename GraphCodom>
+	bool operator()(VertexMap &&m, const GraphDom &gDom, const GraphCodom &gCodom) const {
+		BOOST_CONCEPT_ASSERT((GM::VertexMapConcept<VertexMap>));
+		return next(GM::addProp(std::forward<VertexMap>(m), TermDataT(), unifier.getData()), gDom, gCodom);
+	}
+private:
+	const Unifier &unifier;
+	Next next;
+};
+
+template<typename Unifier, typename Next>
+auto makeToTermVertexMapIncremental(const Unifier &unifier, Next next) {
+	return ToTermVertexMapIncremental<Unifier, Next>(unifier, next);
+}
+
 // Filters for isRenaming and isSpecialisation
 //------------------------------------------------------------------------------
 
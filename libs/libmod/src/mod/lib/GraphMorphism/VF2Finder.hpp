@@ -19,6 +19,8 @@ void assertSizes(const Graph &g) {
 } // namespace detail
 
 struct VF2Isomorphism {
+	// see jla_boost::GraphMorphism::NullPairListener
+	static constexpr bool supportsPairListener = true;
 
 	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate,
 	typename ArgsProviderDomain, typename ArgsProviderCodomain>
@@ -30,6 +32,16 @@ struct VF2Isomorphism {
 				vOrderDomain, edgePred, vertexPred);
 	}
 
+	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate,
+	typename ArgsProviderDomain, typename ArgsProviderCodomain, typename PairListener>
+	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred, VertexPredicate vertexPred,
+			ArgsProviderDomain argsDomain, ArgsProviderCodomain argsCodomain, PairListener &listener) {
+		auto &&vOrderDomain = get_vertex_order(argsDomain, gDomain);
+		return jla_boost::GraphMorphism::vf2_graph_iso(gDomain, gCodomain, mr,
+				get(boost::vertex_index_t(), gDomain), get(boost::vertex_index_t(), gCodomain),
+				vOrderDomain, edgePred, vertexPred, listener);
+	}
+
 	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate>
 	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred, VertexPredicate vertexPred) {
 		return (*this)(gDomain, gCodomain, mr, edgePred, vertexPred, DefaultFinderArgsProvider(), DefaultFinderArgsProvider());
@@ -37,6 +49,8 @@ struct VF2Isomorphism {
 };
 
 struct VF2Monomorphism {
+	// see jla_boost::GraphMorphism::NullPairListener
+	static constexpr bool supportsPairListener = true;
 
 	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate,
 	typename ArgsProviderDomain, typename ArgsProviderCodomain>
@@ -48,6 +62,16 @@ struct VF2Monomorphism {
 				vOrderDomain, edgePred, vertexPred);
 	}
 
+	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate,
+	typename ArgsProviderDomain, typename ArgsProviderCodomain, typename PairListener>
+	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred, VertexPredicate vertexPred,
+			ArgsProviderDomain argsDomain, ArgsProviderCodomain argsCodomain, PairListener &listener) {
+		auto &&vOrderDomain = get_vertex_order(argsDomain, gDomain);
+		return jla_boost::GraphMorphism::vf2_subgraph_mono(gDomain, gCodomain, mr,
+				get(boost::vertex_index_t(), gDomain), get(boost::vertex_index_t(), gCodomain),
+				vOrderDomain, edgePred, vertexPred, listener);
+	}
+
 	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate>
 	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred, VertexPredicate vertexPred) {
 		return (*this)(gDomain, gCodomain, mr, edgePred, vertexPred, DefaultFinderArgsProvider(), DefaultFinderArgsProvider());
@@ -0,0 +1,23 @@
+#include "LabelInterner.hpp"
+
+#include <cassert>
+#include <iostream>
+
+namespace mod::lib {
+
+LabelInterner::LabelInterner() {
+	[[maybe_unused]] const auto emptyId = intern("");
+	assert(emptyId == 0);
+}
+
+LabelInterner &getLabelInterner() {
+	// never destroyed, so labels can be used by other static objects during their destruction
+	static LabelInterner *interner = new LabelInterner();
+	return *interner;
+}
+
+std::ostream &operator<<(std::ostream &s, InternedString str) {
+	return s << str.str();
+}
+
+} // namespace mod::lib
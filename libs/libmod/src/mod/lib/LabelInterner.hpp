@@ -0,0 +1,153 @@
+#ifndef MOD_LIB_LABELINTERNER_HPP
+#define MOD_LIB_LABELINTERNER_HPP
+
+#include <mod/lib/StringStore.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mod::lib {
+
+// The global store of the string labels of graphs and rules, where each distinct string is stored once
+// and identified by a 32-bit id. The id 0 is the empty string.
+// It is thread-safe in the same way as StringStore.
+struct LabelInterner {
+	using Id = std::uint32_t;
+public:
+	LabelInterner();
+	LabelInterner(const LabelInterner &) = delete;
+	LabelInterner &operator=(const LabelInterner &) = delete;
+
+	Id intern(std::string_view s) {
+		return strings.getIndex(s);
+	}
+
+	// Returns an empty optional if the string has not been interned, without interning it.
+	std::optional<Id> find(std::string_view s) const {
+		const auto res = strings.find(s);
+		if(!res) return {};
+		return static_cast<Id>(*res);
+	}
+
+	const std::string &getString(Id id) const {
+		return strings.getString(id);
+	}
+
+	std::size_t size() const {
+		return strings.size();
+	}
+private:
+	StringStore strings;
+};
+
+LabelInterner &getLabelInterner();
+
+// A string label as an id in the global LabelInterner.
+// Equality is decided by the ids, while ordering is by the strings, so sorting does not depend on
+// the order the labels were created in.
+// The interner never shrinks, so the constructors from strings are explicit,
+// and comparisons with plain strings do not intern them.
+struct InternedString {
+	InternedString() = default; // the empty string
+	explicit InternedString(std::string_view s) : id(getLabelInterner().intern(s)) {}
+	explicit InternedString(const std::string &s) : InternedString(std::string_view(s)) {}
+	explicit InternedString(const char *s) : InternedString(std::string_view(s)) {}
+
+	// Returns an empty optional if s has not been interned, without interning it.
+	static std::optional<InternedString> find(std::string_view s) {
+		const auto id = getLabelInterner().find(s);
+		if(!id) return {};
+		InternedString res;
+		res.id = *id;
+		return res;
+	}
+
+	LabelInterner::Id getId() const {
+		return id;
+	}
+
+	const std::string &str() const {
+		return getLabelInterner().getString(id);
+	}
+
+	operator const std::string &() const {
+		return str();
+	}
+
+	friend bool operator==(InternedString a, InternedString b) {
+		return a.id == b.id;
+	}
+
+	friend bool operator!=(InternedString a, InternedString b) {
+		return a.id != b.id;
+	}
+
+	friend bool operator==(InternedString a, std::string_view b) {
+		const auto bInterned = find(b);
+		return bInterned && a == *bInterned;
+	}
+
+	friend bool operator!=(InternedString a, std::string_view b) {
+		return !(a == b);
+	}
+
+	friend bool operator==(std::string_view a, InternedString b) {
+		return b == a;
+	}
+
+	friend bool operator!=(std::string_view a, InternedString b) {
+		return !(b == a);
+	}
+
+	friend bool operator==(InternedString a, const std::string &b) {
+		return a == std::string_view(b);
+	}
+
+	friend bool operator!=(InternedString a, const std::string &b) {
+		return !(a == std::string_view(b));
+	}
+
+	friend bool operator==(const std::string &a, InternedString b) {
+		return b == std::string_view(a);
+	}
+
+	friend bool operator!=(const std::string &a, InternedString b) {
+		return !(b == std::string_view(a));
+	}
+
+	friend bool operator==(InternedString a, const char *b) {
+		return a == std::string_view(b);
+	}
+
+	friend bool operator!=(InternedString a, const char *b) {
+		return !(a == std::string_view(b));
+	}
+
+	friend bool operator<(InternedString a, InternedString b) {
+		return a.id != b.id && a.str() < b.str();
+	}
+
+	friend std::ostream &operator<<(std::ostream &s, InternedString str);
+
+	// a hash of the id, so it is only stable within a process
+	friend std::size_t hash_value(InternedString s) {
+		return std::hash<LabelInterner::Id>()(s.id);
+	}
+private:
+	LabelInterner::Id id = 0;
+};
+
+} // namespace mod::lib
+
+template<>
+struct std::hash<mod::lib::InternedString> {
+	std::size_t operator()(mod::lib::InternedString s) const {
+		return hash_value(s);
+	}
+};
+
+#endif // MOD_LIB_LABELINTERNER_HPP
@@ -0,0 +1,41 @@
+#include "ComposeRuleReal.hpp"
+
+#include <mod/lib/Rules/Real.hpp>
+#include <mod/lib/Rules/Properties/Molecule.hpp>
+#include <mod/lib/Rules/Properties/Stereo.hpp>
+#include <mod/lib/Rules/Properties/String.hpp>
+#include <mod/lib/Rules/Properties/Term.hpp>
+
+#include <mutex>
+
+namespace mod::lib::RC {
+
+void prepareForConcurrentComposition(const lib::Rules::Real &r, const LabelSettings labelSettings) {
+	// the same rule may be prepared from several threads, e.g., when DGs are built from different Python threads
+	static std::mutex mtx;
+	std::scoped_lock lock(mtx);
+	const auto &rDPO = r.getDPORule();
+	get_string(rDPO);
+	if(labelSettings.type == LabelType::Term)
+		get_term(rDPO);
+	if(labelSettings.withStereo) {
+		get_molecule(rDPO);
+		get_stereo(rDPO);
+	}
+	const auto prepareSide = [](const auto &side) {
+		for(std::size_t i = 0; i != get_num_connected_components(side); ++i) {
+			get_vertex_order_component(i, side);
+			get_component_fingerprint(i, side);
+		}
+	};
+	prepareSide(get_labelled_left(rDPO));
+	prepareSide(get_labelled_right(rDPO));
+}
+
+bool canComposeConcurrently(const int verbosity, const LabelSettings labelSettings) {
+	return labelSettings.type == LabelType::String
+	       && verbosity == 0
+	       && !getConfig().rc.printMatches.get();
+}
+
+} // namespace mod::lib::RC
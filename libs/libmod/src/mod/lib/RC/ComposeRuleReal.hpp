@@ -28,6 +28,15 @@ MOD_RC_COMPOSE_BY_MATCH_MAKER(Sub)
 MOD_RC_COMPOSE_BY_MATCH_MAKER(Super)
 #undef MOD_RC_COMPOSE_BY_MATCH_MAKER
 
+// Forces the lazily computed data of a rule that is read during composition and isomorphism checks,
+// such that the rule afterwards can be used in several concurrent compositions.
+// It may itself be called concurrently, also for the same rule.
+void prepareForConcurrentComposition(const lib::Rules::Real &r, LabelSettings labelSettings);
+// Whether compositions with the given match maker verbosity and label settings may run concurrently.
+// Term labels go through the global string store, which is not synchronised,
+// and neither is the output of the composition when it is verbose or printing matches.
+bool canComposeConcurrently(int verbosity, LabelSettings labelSettings);
+
 #define MOD_RC_COMPOSE_BY_MATCH_MAKER_IMPL(MM)                                                                         \
 	void composeRuleRealByMatchMaker(const lib::Rules::Real &rFirst, const lib::Rules::Real &rSecond,                   \
 			const MM &mm, std::function<bool(std::unique_ptr<lib::Rules::Real>) > rr, LabelSettings labelSettings) {      \
@@ -4,6 +4,7 @@
 #include <mod/graph/Graph.hpp>
 #include <mod/rule/CompositionExpr.hpp>
 #include <mod/rule/Rule.hpp>
+#include <mod/lib/Algorithm/Parallel.hpp>
 #include <mod/lib/RC/ComposeRuleReal.hpp>
 #include <mod/lib/RC/IO/Write.hpp>
 #include <mod/lib/RC/MatchMaker/Common.hpp>
@@ -57,30 +58,69 @@ struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<ru
 	// Binary
 	//----------------------------------------------------------------------
 
+	// With config.common.numThreads != 1 the compositions of all pairs are computed concurrently
+	// (if canComposeConcurrently allows it), while the results are handled in the same order as serially.
 	template<typename Composer>
 	std::vector<std::shared_ptr<rule::Rule>> composeTemplate(
-			const rule::RCExp::ComposeBase &compose, Composer composer) {
+			const rule::RCExp::ComposeBase &compose, const int mmVerbosity, Composer composer) {
 		auto firstResult = compose.getFirst().applyVisitor(*this);
 		auto secondResult = compose.getSecond().applyVisitor(*this);
 		std::vector<std::shared_ptr<rule::Rule> > result;
-		for(auto rFirst : firstResult) {
-			for(auto rSecond : secondResult) {
-				std::vector<lib::Rules::Real *> resultVec;
-				auto reporter = [&resultVec](std::unique_ptr<lib::Rules::Real> r) {
-					resultVec.push_back(r.release());
-					return true;
-				};
-				composer(rFirst->getRule(), rSecond->getRule(), reporter);
-				for(auto *r : resultVec) {
-					if(compose.getDiscardNonchemical() && !r->isChemical()) {
-						delete r;
-						continue;
-					}
-					auto rWrapped = evaluator.checkIfNew(r);
-					bool isNew = evaluator.addRule(rWrapped);
-					if(isNew) evaluator.giveProductStatus(rWrapped);
-					evaluator.suggestComposition(&rFirst->getRule(), &rSecond->getRule(), &rWrapped->getRule());
-					result.push_back(rWrapped);
+		const auto handleResults = [&](const std::shared_ptr<rule::Rule> &rFirst,
+		                               const std::shared_ptr<rule::Rule> &rSecond,
+		                               std::vector<std::unique_ptr<lib::Rules::Real>> &resultVec) {
+			for(auto &r : resultVec) {
+				if(compose.getDiscardNonchemical() && !r->isChemical())
+					continue;
+				auto rWrapped = evaluator.checkIfNew(r.release());
+				bool isNew = evaluator.addRule(rWrapped);
+				if(isNew) evaluator.giveProductStatus(rWrapped);
+				evaluator.suggestComposition(&rFirst->getRule(), &rSecond->getRule(), &rWrapped->getRule());
+				result.push_back(rWrapped);
+			}
+		};
+		const auto numThreads = getConfig().common.numThreads.get();
+		if(resolveNumThreads(numThreads) == 1 || !canComposeConcurrently(mmVerbosity, evaluator.labelSettings)) {
+			for(auto rFirst : firstResult) {
+				for(auto rSecond : secondResult) {
+					std::vector<std::unique_ptr<lib::Rules::Real>> resultVec;
+					auto reporter = [&resultVec](std::unique_ptr<lib::Rules::Real> r) {
+						resultVec.push_back(std::move(r));
+						return true;
+					};
+					composer(rFirst->getRule(), rSecond->getRule(), reporter);
+					handleResults(rFirst, rSecond, resultVec);
+				}
+			}
+		} else {
+			for(const auto &r : firstResult)
+				prepareForConcurrentComposition(r->getRule(), evaluator.labelSettings);
+			for(const auto &r : secondResult)
+				prepareForConcurrentComposition(r->getRule(), evaluator.labelSettings);
+			// task i is the pair (i / |secondResult|, i % |secondResult|), i.e., the serial order
+			// The tasks are run in batches, and the results of each batch are deduplicated before the next is started,
+			// so only the compositions of a single batch are buffered at a time.
+			const std::size_t numTasks = firstResult.size() * secondResult.size();
+			const std::size_t batchSize = 64 * std::size_t(resolveNumThreads(numThreads));
+			std::vector<std::vector<std::unique_ptr<lib::Rules::Real>>> resultVecs(std::min(numTasks, batchSize));
+			for(std::size_t batchBegin = 0; batchBegin < numTasks; batchBegin += batchSize) {
+				const std::size_t batchEnd = std::min(numTasks, batchBegin + batchSize);
+				parallelFor(numThreads, batchEnd - batchBegin, [&](const std::size_t i) {
+					const std::size_t task = batchBegin + i;
+					const auto &rFirst = firstResult[task / secondResult.size()];
+					const auto &rSecond = secondResult[task % secondResult.size()];
+					auto &resultVec = resultVecs[i];
+					auto reporter = [&resultVec](std::unique_ptr<lib::Rules::Real> r) {
+						resultVec.push_back(std::move(r));
+						return true;
+					};
+					composer(rFirst->getRule(), rSecond->getRule(), reporter);
+				});
+				for(std::size_t task = batchBegin; task != batchEnd; ++task) {
+					auto &resultVec = resultVecs[task - batchBegin];
+					handleResults(firstResult[task / secondResult.size()], secondResult[task % secondResult.size()],
+					              resultVec);
+					resultVec.clear();
 				}
 			}
 		}
@@ -93,7 +133,7 @@ struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<ru
 			RC::Common mm(matchMakerVerbosity(), logger, common.getMaxmimum(), common.getConnected());
 			lib::RC::composeRuleRealByMatchMaker(rFirst, rSecond, mm, reporter, evaluator.labelSettings);
 		};
-		auto res = composeTemplate(common, composer);
+		auto res = composeTemplate(common, matchMakerVerbosity(), composer);
 		if(common.getIncludeEmpty()) {
 			auto resEmpty = (*this)(rule::RCExp::ComposeParallel(
 					common.getFirst(), common.getSecond(), common.getDiscardNonchemical()));
@@ -108,7 +148,7 @@ struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<ru
 			lib::RC::composeRuleRealByMatchMaker(rFirst, rSecond, lib::RC::Parallel(verbosity, logger),
 			                                     reporter, evaluator.labelSettings);
 		};
-		return composeTemplate(common, composer);
+		return composeTemplate(common, verbosity, composer);
 	}
 
 	std::vector<std::shared_ptr<rule::Rule>> operator()(const rule::RCExp::ComposeSub &sub) {
@@ -117,7 +157,7 @@ struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<ru
 			RC::Sub mm(matchMakerVerbosity(), logger, sub.getAllowPartial());
 			lib::RC::composeRuleRealByMatchMaker(rFirst, rSecond, mm, reporter, evaluator.labelSettings);
 		};
-		return composeTemplate(sub, composer);
+		return composeTemplate(sub, matchMakerVerbosity(), composer);
 	}
 
 	std::vector<std::shared_ptr<rule::Rule>> operator()(const rule::RCExp::ComposeSuper &super) {
@@ -126,7 +166,7 @@ struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<ru
 			RC::Super mm(matchMakerVerbosity(), logger, super.getAllowPartial(), super.getEnforceConstraints());
 			lib::RC::composeRuleRealByMatchMaker(rFirst, rSecond, mm, reporter, evaluator.labelSettings);
 		};
-		return composeTemplate(super, composer);
+		return composeTemplate(super, matchMakerVerbosity(), composer);
 	}
 
 	int matchMakerVerbosity() const {
@@ -151,6 +191,8 @@ Evaluator::Evaluator(std::unordered_set<std::shared_ptr<rule::Rule>> database, L
 			}
 		}
 	}
+	for(const auto &r : this->database)
+		addToIndex(r);
 }
 
 const std::unordered_set<std::shared_ptr<rule::Rule> > &Evaluator::getRuleDatabase() const {
@@ -235,7 +277,9 @@ const Evaluator::GraphType &Evaluator::getGraph() const {
 }
 
 bool Evaluator::addRule(std::shared_ptr<rule::Rule> r) {
-	return database.insert(r).second;
+	const bool isNew = database.insert(r).second;
+	if(isNew) addToIndex(r);
+	return isNew;
 }
 
 void Evaluator::giveProductStatus(std::shared_ptr<rule::Rule> r) {
@@ -243,16 +287,26 @@ void Evaluator::giveProductStatus(std::shared_ptr<rule::Rule> r) {
 }
 
 std::shared_ptr<rule::Rule> Evaluator::checkIfNew(lib::Rules::Real *rCand) const {
-	for(auto rOther : database) {
-		if(lib::Rules::makeIsomorphismPredicate(labelSettings.type, labelSettings.withStereo)
-				(&rOther->getRule(), rCand)) {
+	const auto iso = lib::Rules::makeIsomorphismPredicate(labelSettings.type, labelSettings.withStereo);
+	const auto candidates = databaseIndex.equal_range(lib::Rules::Real::fingerprint(*rCand, labelSettings.type));
+	for(auto iter = candidates.first; iter != candidates.second; ++iter) {
+		const auto &rOther = iter->second;
+		if(iso(&rOther->getRule(), rCand)) {
+			++getConfig().rc.numIsomorphismIndexHits();
 			delete rCand;
 			return rOther;
 		}
+		++getConfig().rc.numIsomorphismIndexCollisions();
 	}
 	return rule::Rule::makeRule(std::unique_ptr<lib::Rules::Real>(rCand));
 }
 
+void Evaluator::addToIndex(std::shared_ptr<rule::Rule> r) {
+	// the rule may also be used concurrently from other threads, e.g., by other evaluators
+	prepareForConcurrentComposition(r->getRule(), labelSettings);
+	databaseIndex.emplace(lib::Rules::Real::fingerprint(r->getRule(), labelSettings.type), r);
+}
+
 void Evaluator::suggestComposition(const lib::Rules::Real *rFirst,
                                    const lib::Rules::Real *rSecond,
                                    const lib::Rules::Real *rResult) {
@@ -55,6 +55,8 @@ public: // evaluation interface
 	void suggestComposition(const lib::Rules::Real *rFirst,
 	                        const lib::Rules::Real *rSecond,
 	                        const lib::Rules::Real *rResult);
+private:
+	void addToIndex(std::shared_ptr<rule::Rule> r);
 private: // graph interface
 	Vertex getVertexFromRule(const lib::Rules::Real *r);
 	Vertex getVertexFromArgs(const lib::Rules::Real *rFirst, const lib::Rules::Real *rSecond);
@@ -63,6 +65,8 @@ public:
 	Rules::GraphAsRuleCache graphAsRuleCache;
 private:
 	std::unordered_set<std::shared_ptr<rule::Rule>> database, products;
+	// Real::fingerprint -> rules in the database, so checkIfNew only checks isomorphism on collisions
+	std::unordered_multimap<std::size_t, std::shared_ptr<rule::Rule>> databaseIndex;
 private:
 	GraphType rcg;
 	std::unordered_map<const lib::Rules::Real *, Vertex> ruleToVertex;
@@ -140,9 +140,9 @@ void test(const lib::Rules::Real &rFirst, const lib::Rules::Real &rSecond, const
 			const CoreVertex vCommon = add_vertex(gComon);
 			vSecondToCommon[v] = vCommon;
 			gComon[vCommon].membership = lib::Rules::Membership::K;
-			const std::string &label = rSecond.getGraph()[v].membership == lib::Rules::Membership::L
-			                           ? get_string(rSecond.getDPORule()).getLeft()[v]
-			                           : get_string(rSecond.getDPORule()).getRight()[v];
+			const InternedString label = rSecond.getGraph()[v].membership == lib::Rules::Membership::L
+			                             ? get_string(rSecond.getDPORule()).getLeft()[v]
+			                             : get_string(rSecond.getDPORule()).getRight()[v];
 			pStringCommon.add(vCommon, label, label);
 		}
 	}
@@ -159,9 +159,9 @@ void test(const lib::Rules::Real &rFirst, const lib::Rules::Real &rSecond, const
 		auto pEdge = edge(vSrc, vTar, gComon);
 		if(pEdge.second) continue;
 		pEdge = add_edge(vSrc, vTar, {lib::Rules::Membership::K}, gComon);
-		const std::string &label = rSecond.getGraph()[e].membership == lib::Rules::Membership::L
-		                           ? get_string(rSecond.getDPORule()).getLeft()[e]
-		                           : get_string(rSecond.getDPORule()).getRight()[e];
+		const InternedString label = rSecond.getGraph()[e].membership == lib::Rules::Membership::L
+		                             ? get_string(rSecond.getDPORule()).getLeft()[e]
+		                             : get_string(rSecond.getDPORule()).getRight()[e];
 		pStringCommon.add(pEdge.first, label, label);
 	}
 	lib::Rules::Real rCommon(std::move(dpoCommon), rFirst.getLabelType());
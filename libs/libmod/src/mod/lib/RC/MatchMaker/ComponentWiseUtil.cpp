@@ -0,0 +1,11 @@
+#include "ComponentWiseUtil.hpp"
+
+#include <mod/lib/Algorithm/Parallel.hpp>
+
+namespace mod::lib::RC {
+
+void countComponentPairSkipped() {
+	incrementConcurrently(getConfig().rc.numComponentPairsSkipped());
+}
+
+} // namespace mod::lib::RC
@@ -81,6 +81,9 @@ WrappedComponentGraph<Rule> makeWrappedComponentGraph(const typename Rule::Compo
 	return WrappedComponentGraph<Rule>(g, i, r);
 }
 
+// Increments config.rc.numComponentPairsSkipped, and may be called concurrently.
+void countComponentPairSkipped();
+
 template<typename RuleSideDom, typename RuleSideCodom>
 struct RuleRuleComponentMonomorphism {
 	using Morphism = GM::VectorVertexMap<typename RuleSideDom::GraphType, typename RuleSideCodom::GraphType>;
@@ -94,6 +97,14 @@ public:
 			  verbose(verbose), logger(logger), haxMorphismLimit(getConfig().rc.componentWiseMorphismLimit.get()) {}
 
 	std::vector<Morphism> operator()(const std::size_t idDom, const std::size_t idCodom) const {
+		if(!maybeMonomorphic(get_component_fingerprint(idDom, rsDom), get_component_fingerprint(idCodom, rsCodom),
+		                     labelSettings.type == LabelType::String)) {
+			countComponentPairSkipped();
+			if(verbose)
+				logger.indent() << "RuleRuleComponentMonomorphism(" << idDom << ", " << idCodom
+				                << "): skipped by fingerprint" << std::endl;
+			return {};
+		}
 		const auto doIt = [this, idDom, idCodom](auto mrStore) {
 			const auto &gDom = get_component_graph(idDom, rsDom);
 			const auto &gCodom = get_component_graph(idCodom, rsCodom);
@@ -72,8 +72,20 @@ private:
 		auto mm = makeMultiDimSelector<AllowPartial>(
 				get_num_connected_components(lgDomPatterns),
 				get_num_connected_components(lgCodomHosts), mp);
+		for(const auto &position : mm) {
+			auto maybeMap = matchFromPosition(rFirst, rSecond, position);
+			if(!maybeMap) {
+				if(verbosity >= V_MorphismGen)
+					std::cout << "Super: matchFromPosition returned none." << std::endl;
+				continue;
+			}
+			auto map = *std::move(maybeMap);
+			bool continue_ = handleMapByLabelSettings(rFirst, rSecond, std::move(map), mr, labelSettings,
+			                                          verbosity, logger);
+			if(!continue_) break;
+		}
 		if(verbosity >= V_MorphismGen) {
-			logger.indent() << "Super: " << "Match matrix, "
+			logger.indent() << "Super: " << "Match matrix (. = not computed), "
 			                << mm.morphisms.size() << " x " << mm.morphisms.front().size() << std::endl;
 			++logger.indentLevel;
 			for(int i = 0; i != mm.morphisms.size(); ++i) {
@@ -82,24 +94,14 @@ private:
 					logger.s << "x:";
 				else logger.s << " :";
 				const auto &m = mm.morphisms[i];
-				for(int j = 0; j != m.size(); ++j)
-					logger.s << " " << std::setw(2) << m[j].size();
+				for(int j = 0; j != m.size(); ++j) {
+					if(m[j]) logger.s << " " << std::setw(2) << m[j]->size();
+					else logger.s << "  .";
+				}
 				logger.s << std::endl;
 			}
 			--logger.indentLevel;
 		}
-		for(const auto &position : mm) {
-			auto maybeMap = matchFromPosition(rFirst, rSecond, position);
-			if(!maybeMap) {
-				if(verbosity >= V_MorphismGen)
-					std::cout << "Super: matchFromPosition returned none." << std::endl;
-				continue;
-			}
-			auto map = *std::move(maybeMap);
-			bool continue_ = handleMapByLabelSettings(rFirst, rSecond, std::move(map), mr, labelSettings,
-			                                          verbosity, logger);
-			if(!continue_) break;
-		}
 	}
 public:
 	template<typename Position>
@@ -145,10 +145,10 @@ private:
 		assert(m == result.rDPO->getCombinedGraph()[vResult].membership);
 		switch(m) {
 		case Membership::L:
-			pString.add(vResult, pFrom.getLeft()[vFrom], "");
+			pString.add(vResult, pFrom.getLeft()[vFrom], InternedString());
 			break;
 		case Membership::R:
-			pString.add(vResult, "", pFrom.getRight()[vFrom]);
+			pString.add(vResult, InternedString(), pFrom.getRight()[vFrom]);
 			break;
 		case Membership::K:
 			pString.add(vResult, pFrom.getLeft()[vFrom], pFrom.getRight()[vFrom]);
@@ -164,10 +164,10 @@ private:
 		auto m = result.rDPO->getCombinedGraph()[eResult].membership;
 		switch(m) {
 		case Membership::L:
-			pString.add(eResult, pFrom.getLeft()[eFrom], "");
+			pString.add(eResult, pFrom.getLeft()[eFrom], InternedString());
 			break;
 		case Membership::R:
-			pString.add(eResult, "", pFrom.getRight()[eFrom]);
+			pString.add(eResult, InternedString(), pFrom.getRight()[eFrom]);
 			break;
 		case Membership::K:
 			pString.add(eResult, pFrom.getLeft()[eFrom], pFrom.getRight()[eFrom]);
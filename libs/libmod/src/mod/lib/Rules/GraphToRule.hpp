@@ -26,10 +26,10 @@ std::unique_ptr<Real> graphToRule(const LGraph &lg, Membership membership, const
 		const auto &label = pStringGraph[v];
 		switch(membership) {
 		case Membership::L:
-			pString.add(vCore, label, "");
+			pString.add(vCore, label, InternedString());
 			break;
 		case Membership::R:
-			pString.add(vCore, "", label);
+			pString.add(vCore, InternedString(), label);
 			break;
 		case Membership::K:
 			pString.add(vCore, label, label);
@@ -45,10 +45,10 @@ std::unique_ptr<Real> graphToRule(const LGraph &lg, Membership membership, const
 		const auto &label = pStringGraph[e];
 		switch(membership) {
 		case Membership::L:
-			pString.add(eCore, label, "");
+			pString.add(eCore, label, InternedString());
 			break;
 		case Membership::R:
-			pString.add(eCore, "", label);
+			pString.add(eCore, InternedString(), label);
 			break;
 		case Membership::K:
 			pString.add(eCore, label, label);
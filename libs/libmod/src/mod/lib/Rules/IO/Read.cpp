@@ -288,17 +288,17 @@ Result<Data> gml(lib::IO::Warnings &warnings, std::string_view input) {
 
 		if(vData.inContext) {
 			const auto vK = addVertexK(rDPO);
-			pString.addK(vK, *vData.string.left, *vData.string.right);
+			pString.addK(vK, InternedString(*vData.string.left), InternedString(*vData.string.right));
 			vData.cgVertex = get(rDPO.getKtoCG(), getK(rDPO), rDPO.getCombinedGraph(), vK);
 		} else if(vData.inLeft) {
 			assert(!vData.inRight);
 			const auto vL = addVertexL(rDPO);
-			pString.addL(vL, *vData.string.left);
+			pString.addL(vL, InternedString(*vData.string.left));
 			vData.cgVertex = get(rDPO.getLtoCG(), getL(rDPO), rDPO.getCombinedGraph(), vL);
 		} else {
 			assert(vData.inRight);
 			const auto vR = addVertexR(rDPO);
-			pString.addR(vR, *vData.string.right);
+			pString.addR(vR, InternedString(*vData.string.right));
 			vData.cgVertex = get(rDPO.getRtoCG(), getR(rDPO), rDPO.getCombinedGraph(), vR);
 		}
 		vIdFromCG[vData.cgVertex] = id;
@@ -367,21 +367,21 @@ Result<Data> gml(lib::IO::Warnings &warnings, std::string_view input) {
 
 		if(eData.inContext) {
 			const auto eK = addEdgeK(rDPO, vcSrc, vcTar);
-			pString.addK(eK, *eData.string.left, *eData.string.right);
+			pString.addK(eK, InternedString(*eData.string.left), InternedString(*eData.string.right));
 			eData.cgEdge = get(rDPO.getKtoCG(), getK(rDPO), rDPO.getCombinedGraph(), eK);
 		} else if(eData.inLeft) {
 			assert(!eData.inRight);
 			const auto vLSrc = get_inverse(rDPO.getLtoCG(), getL(rDPO), rDPO.getCombinedGraph(), vcSrc);
 			const auto vLTar = get_inverse(rDPO.getLtoCG(), getL(rDPO), rDPO.getCombinedGraph(), vcTar);
 			const auto eL = addEdgeL(rDPO, vLSrc, vLTar);
-			pString.addL(eL, *eData.string.left);
+			pString.addL(eL, InternedString(*eData.string.left));
 			eData.cgEdge = get(rDPO.getLtoCG(), getL(rDPO), rDPO.getCombinedGraph(), eL);
 		} else {
 			assert(eData.inRight);
 			const auto vRSrc = get_inverse(rDPO.getRtoCG(), getR(rDPO), rDPO.getCombinedGraph(), vcSrc);
 			const auto vRTar = get_inverse(rDPO.getRtoCG(), getR(rDPO), rDPO.getCombinedGraph(), vcTar);
 			const auto eR = addEdgeR(rDPO, vRSrc, vRTar);
-			pString.addR(eR, *eData.string.right);
+			pString.addR(eR, InternedString(*eData.string.right));
 			eData.cgEdge = get(rDPO.getRtoCG(), getR(rDPO), rDPO.getCombinedGraph(), eR);
 		}
 	} // for each edge
@@ -681,7 +681,7 @@ struct ConvertLeft {
 
 	ConvertRes operator()(LabelVertex &vDFS) {
 		const auto vL = addVertexL(rDPO);
-		pString.addL(vL, vDFS.label);
+		pString.addL(vL, InternedString(vDFS.label));
 		const auto v = get(rDPO.getLtoCG(), getL(rDPO), rDPO.getCombinedGraph(), vL);
 
 #ifdef MOD_RULEDFS_DEBUG
@@ -704,7 +704,7 @@ struct ConvertLeft {
 		}
 		if(rightLabel) {
 			const auto vR = promoteVertexL(rDPO, vL);
-			pString.promoteL(vL, vR, *rightLabel);
+			pString.promoteL(vL, vR, InternedString(*rightLabel));
 		}
 		if(vDFS.ringClosure) {
 			const auto vRing = vertex(vDFS.ringClosure->gVertexId, rDPO.getCombinedGraph());
@@ -782,7 +782,7 @@ struct ConvertRight {
 			v = get(rDPO.getRtoCG(), getR(rDPO), rDPO.getCombinedGraph(), vR);
 			const auto vId = get(boost::vertex_index_t(), rDPO.getCombinedGraph(), v);
 			vDFS.gVertexId = vId;
-			pString.addR(vR, vDFS.label);
+			pString.addR(vR, InternedString(vDFS.label));
 #ifdef MOD_RULEDFS_DEBUG
 			std::cout << "RuleDFS: ConvertRight, add_vertex(";
 			pString.print(std::cout, v);
@@ -812,7 +812,7 @@ private:
 		const auto iterLeft = leftEdges.find({vSrc, vTar});
 		if(iterLeft != leftEdges.end()) {
 			const auto eK = addEdgeK(rDPO, vSrc, vTar);
-			pString.addK(eK, iterLeft->second, label);
+			pString.addK(eK, InternedString(iterLeft->second), InternedString(label));
 			leftEdges.erase(iterLeft);
 #ifdef MOD_RULEDFS_DEBUG
 			std::cout << "RuleDFS: ConvertRight, addEdgeK(";
@@ -823,7 +823,7 @@ private:
 			const auto vRSrc = get_inverse(rDPO.getRtoCG(), getR(rDPO), rDPO.getCombinedGraph(), vSrc);
 			const auto vRTar = get_inverse(rDPO.getRtoCG(), getR(rDPO), rDPO.getCombinedGraph(), vTar);
 			const auto eR = addEdgeR(rDPO, vRSrc, vRTar);
-			pString.addR(eR, label);
+			pString.addR(eR, InternedString(label));
 #ifdef MOD_RULEDFS_DEBUG
 			std::cout << "RuleDFS: ConvertRight, addEdgeR(";
 			pString.print(std::cout, get(rDPO.getRtoCG(), getR(rDPO), rDPO.getCombinedGraph(), eR));
@@ -940,7 +940,7 @@ Result<Data> dfs(lib::IO::Warnings &warnings, std::string_view input) {
 		const auto vL1 = get_inverse(rDPO->getLtoCG(), getL(*rDPO), rDPO->getCombinedGraph(), ep.first);
 		const auto vL2 = get_inverse(rDPO->getLtoCG(), getL(*rDPO), rDPO->getCombinedGraph(), ep.second);
 		const auto eL = addEdgeL(*rDPO, vL1, vL2);
-		pString->addL(eL, label);
+		pString->addL(eL, InternedString(label));
 #ifdef MOD_RULEDFS_DEBUG
 		std::cout << "RuleDFS: remaining leftEdges, add_edge(";
 		pString->print(std::cout, get(rDPO->getLtoCG(), getL(*rDPO), rDPO->getCombinedGraph(), eL));
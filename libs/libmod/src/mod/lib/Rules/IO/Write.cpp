@@ -212,8 +212,8 @@ std::string dotCombined(const Real &r) {
 				label = pString.getLeft()[get_inverse(rDPO.getLtoCG(), getL(rDPO), gCombined, eCG)];
 				break;
 			case Membership::K:
-				label = pString.getLeft()[get_inverse(rDPO.getLtoCG(), getL(rDPO), gCombined, eCG)] + " | " +
-				        pString.getRight()[get_inverse(rDPO.getRtoCG(), getR(rDPO), gCombined, eCG)];
+				label = pString.getLeft()[get_inverse(rDPO.getLtoCG(), getL(rDPO), gCombined, eCG)].str() + " | " +
+				        pString.getRight()[get_inverse(rDPO.getRtoCG(), getR(rDPO), gCombined, eCG)].str();
 				break;
 			case Membership::R:
 				label = pString.getRight()[get_inverse(rDPO.getRtoCG(), getR(rDPO), gCombined, eCG)];
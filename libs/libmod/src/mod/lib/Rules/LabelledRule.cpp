@@ -7,6 +7,9 @@
 
 #include <boost/graph/connected_components.hpp>
 
+#include <algorithm>
+#include <functional>
+
 #include <iostream>
 
 namespace mod::lib::Rules {
@@ -332,4 +335,62 @@ get_vertex_order_component(std::size_t i, const LabelledRule::Side &g) {
 	return vertex_orders[i];
 }
 
-} // namespace mod::lib::Rules
\ No newline at end of file
+const LabelledRule::ComponentFingerprint &get_component_fingerprint(std::size_t i, const LabelledRule::Side &g) {
+	assert(i < get_num_connected_components(g));
+	auto &fingerprints = g.data.fingerprints;
+	// same hax as for the vertex orders
+	if(fingerprints.empty()) fingerprints.resize(get_num_connected_components(g));
+	auto &fp = fingerprints[i];
+	// a component has at least one vertex, so an empty fingerprint has not been computed yet
+	if(fp.numVertices != 0) return fp;
+
+	const auto count = [](std::vector<std::size_t> &hashes) {
+		std::sort(hashes.begin(), hashes.end());
+		std::vector<std::pair<std::size_t, std::size_t>> res;
+		for(const auto h : hashes) {
+			if(res.empty() || res.back().first != h) res.emplace_back(h, 1);
+			else ++res.back().second;
+		}
+		return res;
+	};
+	const auto &cg = get_component_graph(i, g);
+	const auto pString = get_string(g);
+	const std::hash<InternedString> hasher;
+	std::vector<std::size_t> vHashes, eHashes;
+	for(const auto v : asRange(vertices(cg))) {
+		vHashes.push_back(hasher(pString[v]));
+		fp.degrees.push_back(out_degree(v, cg));
+	}
+	for(const auto e : asRange(edges(cg)))
+		eHashes.push_back(hasher(pString[e]));
+	std::sort(fp.degrees.begin(), fp.degrees.end(), std::greater<>());
+	fp.numEdges = eHashes.size();
+	fp.vertexLabels = count(vHashes);
+	fp.edgeLabels = count(eHashes);
+	fp.numVertices = vHashes.size();
+	return fp;
+}
+
+bool maybeMonomorphic(const LabelledRule::ComponentFingerprint &pattern,
+                      const LabelledRule::ComponentFingerprint &host,
+                      bool compareLabels) {
+	if(pattern.numVertices > host.numVertices) return false;
+	if(pattern.numEdges > host.numEdges) return false;
+	// the i'th largest degree of the pattern must be at most the i'th largest degree of the host
+	for(std::size_t i = 0; i != pattern.degrees.size(); ++i)
+		if(pattern.degrees[i] > host.degrees[i]) return false;
+	if(!compareLabels) return true;
+	// each label must occur at least as often in the host, hash collisions only make the check weaker
+	const auto dominates = [](const auto &pattern, const auto &host) {
+		auto iter = host.begin();
+		for(const auto &[h, count] : pattern) {
+			while(iter != host.end() && iter->first < h) ++iter;
+			if(iter == host.end() || iter->first != h || iter->second < count) return false;
+		}
+		return true;
+	};
+	return dominates(pattern.vertexLabels, host.vertexLabels)
+	       && dominates(pattern.edgeLabels, host.edgeLabels);
+}
+
+} // namespace mod::lib::Rules
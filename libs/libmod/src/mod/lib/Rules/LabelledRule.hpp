@@ -34,6 +34,20 @@ public: // Other
 	using MatchConstraint = GraphMorphism::Constraints::Constraint<SideGraphType>;
 public:
 	struct SideData;
+	// Isomorphism invariants of a connected component of a side, using the string labels.
+	// They are used to rule out monomorphisms between components before running a matcher.
+	struct ComponentFingerprint {
+		std::size_t numVertices = 0, numEdges = 0;
+		// sorted pairs of (label hash, count)
+		std::vector<std::pair<std::size_t, std::size_t>> vertexLabels, edgeLabels;
+		// sorted in non-increasing order
+		std::vector<std::size_t> degrees;
+	public:
+		// Returns false only if there can not be a monomorphism from the pattern component to the host component.
+		// Labels are only compared when compareLabels is true, i.e., when labels must be matched by equality.
+		friend bool maybeMonomorphic(const ComponentFingerprint &pattern, const ComponentFingerprint &host,
+		                             bool compareLabels);
+	};
 public:
 	struct Side {
 		using GraphType = SideGraphType;
@@ -71,6 +85,7 @@ public:
 	public:
 		friend const std::vector<boost::graph_traits<GraphType>::vertex_descriptor> &
 		get_vertex_order_component(std::size_t i, const Side &g);
+		friend const ComponentFingerprint &get_component_fingerprint(std::size_t i, const Side &g);
 	public:
 		const LabelledRule &r;
 		const GraphType &g;
@@ -127,6 +142,7 @@ public:
 		std::vector<std::size_t> component;
 		std::vector<std::unique_ptr<MatchConstraint>> matchConstraints;
 		mutable std::vector<std::vector<Vertex>> vertex_orders;
+		mutable std::vector<ComponentFingerprint> fingerprints;
 	} leftData, rightData;
 };
 
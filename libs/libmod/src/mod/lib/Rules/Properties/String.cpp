@@ -31,14 +31,14 @@ PropString::PropString(const RuleType &rule,
 		auto vId = get(boost::vertex_index_t(), rule.getCombinedGraph(), v);
 		switch(rule.getCombinedGraph()[v].membership) {
 		case Membership::L:
-			vPropL[vId] = termToString(term.getLeft()[v]);
+			vPropL[vId] = InternedString(termToString(term.getLeft()[v]));
 			break;
 		case Membership::R:
-			vPropR[vId] = termToString(term.getRight()[v]);
+			vPropR[vId] = InternedString(termToString(term.getRight()[v]));
 			break;
 		case Membership::K:
-			vPropL[vId] = termToString(term.getLeft()[v]);
-			vPropR[vId] = termToString(term.getRight()[v]);
+			vPropL[vId] = InternedString(termToString(term.getLeft()[v]));
+			vPropR[vId] = InternedString(termToString(term.getRight()[v]));
 			break;
 		}
 	}
@@ -48,14 +48,14 @@ PropString::PropString(const RuleType &rule,
 		auto eId = get(boost::edge_index_t(), rule.getCombinedGraph(), e);
 		switch(rule.getCombinedGraph()[e].membership) {
 		case Membership::L:
-			ePropL[eId] = termToString(term.getLeft()[e]);
+			ePropL[eId] = InternedString(termToString(term.getLeft()[e]));
 			break;
 		case Membership::R:
-			ePropR[eId] = termToString(term.getRight()[e]);
+			ePropR[eId] = InternedString(termToString(term.getRight()[e]));
 			break;
 		case Membership::K:
-			ePropL[eId] = termToString(term.getLeft()[e]);
-			ePropR[eId] = termToString(term.getRight()[e]);
+			ePropL[eId] = InternedString(termToString(term.getLeft()[e]));
+			ePropR[eId] = InternedString(termToString(term.getRight()[e]));
 			break;
 		}
 	}
@@ -2,6 +2,7 @@
 #define MOD_LIB_RULES_PROP_STRING_HPP
 
 #include <mod/lib/GraphMorphism/Constraints/Constraint.hpp>
+#include <mod/lib/LabelInterner.hpp>
 #include <mod/lib/Rules/GraphDecl.hpp>
 #include <mod/lib/Rules/Properties/Property.hpp>
 
@@ -11,7 +12,8 @@ struct StringStore;
 namespace mod::lib::Rules {
 struct PropTerm;
 
-struct PropString : PropBase<PropString, std::string, std::string> {
+// The labels are stored as ids in the global LabelInterner.
+struct PropString : PropBase<PropString, InternedString, InternedString> {
 	using ConstraintPtr = std::unique_ptr<GraphMorphism::Constraints::Constraint<lib::DPO::CombinedRule::SideGraphType>>;
 public:
 	explicit PropString(const RuleType &rule);
@@ -18,8 +18,11 @@
 
 #include <jla_boost/graph/morphism/callbacks/Limit.hpp>
 
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <atomic>
+
 namespace mod::lib::Rules {
 BOOST_CONCEPT_ASSERT((LabelledGraphConcept<LabelledRule>));
 BOOST_CONCEPT_ASSERT((LabelledGraphConcept<LabelledRule::Side>));
@@ -77,7 +80,8 @@ bool Real::sanityChecks(const lib::DPO::CombinedRule::CombinedGraphType &gCombin
 }
 
 namespace {
-std::size_t nextRuleNum = 0;
+// atomic, as rules may be created concurrently during rule application
+std::atomic<std::size_t> nextRuleNum(0);
 } // namespace
 
 Real::Real(LabelledRule &&rule, std::optional<LabelType> labelType)
@@ -191,6 +195,45 @@ std::size_t Real::monomorphism(const Real &rDom,
 	return morphism(rDom, rCodom, maxNumMatches, labelSettings, lib::GraphMorphism::VF2Monomorphism());
 }
 
+std::size_t Real::fingerprint(const Real &r, LabelType labelType) {
+	const auto &rDPO = r.getDPORule();
+	const auto &gCombined = rDPO.getRule().getCombinedGraph();
+	const auto *pString = labelType == LabelType::String ? &get_string(rDPO) : nullptr;
+	const auto labelHash = [pString](const Membership m, const auto &labels) {
+		std::size_t h = static_cast<std::size_t>(m);
+		if(pString) {
+			if(labels.first) boost::hash_combine(h, *labels.first);
+			if(labels.second) boost::hash_combine(h, *labels.second);
+		}
+		return h;
+	};
+	std::vector<std::size_t> vHashes(num_vertices(gCombined)), eHashes;
+	eHashes.reserve(num_edges(gCombined));
+	for(const auto v : asRange(vertices(gCombined))) {
+		vHashes[get(boost::vertex_index_t(), gCombined, v)] = pString
+		                                                       ? labelHash(gCombined[v].membership, (*pString)[v])
+		                                                       : static_cast<std::size_t>(gCombined[v].membership);
+	}
+	for(const auto e : asRange(edges(gCombined))) {
+		std::size_t h = pString
+		                ? labelHash(gCombined[e].membership, (*pString)[e])
+		                : static_cast<std::size_t>(gCombined[e].membership);
+		auto hSrc = vHashes[get(boost::vertex_index_t(), gCombined, source(e, gCombined))];
+		auto hTar = vHashes[get(boost::vertex_index_t(), gCombined, target(e, gCombined))];
+		if(hTar < hSrc) std::swap(hSrc, hTar);
+		boost::hash_combine(h, hSrc);
+		boost::hash_combine(h, hTar);
+		eHashes.push_back(h);
+	}
+	std::sort(begin(vHashes), end(vHashes));
+	std::sort(begin(eHashes), end(eHashes));
+	std::size_t res = vHashes.size();
+	for(const auto h : vHashes) boost::hash_combine(res, h);
+	boost::hash_combine(res, eHashes.size());
+	for(const auto h : eHashes) boost::hash_combine(res, h);
+	return res;
+}
+
 bool Real::isomorphicLeftRight(const Real &rDom, const Real &rCodom, LabelSettings labelSettings) {
 	auto mrLeft = jla_boost::GraphMorphism::makeLimit(1);
 	lib::GraphMorphism::morphismSelectByLabelSettings(
@@ -56,6 +56,10 @@ public:
 	static bool isomorphicLeftRight(const Real &rDom,
 	                                const Real &rCodom,
 	                                LabelSettings labelSettings);
+	// A hash of the multisets of vertex and edge labels of L, K, and R, with edges keyed by the labels
+	// of their endpoints, such that isomorphic rules have the same fingerprint.
+	// Term labels are only equal up to variable renaming, so for those only the memberships are used.
+	static std::size_t fingerprint(const Real &r, LabelType labelType);
 private:
 	const std::size_t id;
 	std::weak_ptr<rule::Rule> apiReference;
@@ -1,39 +1,66 @@
 #include "StringStore.hpp"
 
+#include <mod/Error.hpp>
+
 #include <cassert>
-#include <iostream>
+#include <limits>
+#include <mutex>
 
 namespace mod::lib {
 
-bool StringStore::hasString(const std::string &s) const {
-	return index.find(s) != end(index);
+StringStore::StringStore() : numStrings(0) {
+	for(auto &c : chunks) c.store(nullptr, std::memory_order_relaxed);
+}
+
+StringStore::~StringStore() {
+	for(auto &c : chunks) delete[] c.load(std::memory_order_relaxed);
+}
+
+bool StringStore::hasString(std::string_view s) const {
+	auto &stripe = stripes[std::hash<std::string_view>()(s) % NumStripes];
+	std::shared_lock<std::shared_mutex> lock(stripe.mtx);
+	return stripe.index.find(s) != stripe.index.end();
+}
+
+std::optional<std::size_t> StringStore::find(std::string_view s) const {
+	auto &stripe = stripes[std::hash<std::string_view>()(s) % NumStripes];
+	std::shared_lock<std::shared_mutex> lock(stripe.mtx);
+	const auto iter = stripe.index.find(s);
+	if(iter == stripe.index.end()) return {};
+	return iter->second;
 }
 
-std::size_t StringStore::getIndex(const std::string &s) const {
-	struct DoPrint {
-		DoPrint(const StringStore &store, const std::string &s) : store(store), s(s) {}
-
-		~DoPrint() {
-			std::cout << "StringStore getIndex(" << s << ")" << std::endl;
-			std::cout << "================================================" << std::endl;
-			for(const auto &p : store.index) {
-				assert(p.second < store.strings.size());
-				assert(store.strings[p.second] == p.first);
-				std::cout << "\t" << p.second << " -> " << p.first << std::endl;
-			}
-		}
-	private:
-		const StringStore &store;
-		const std::string &s;
-	} /*doPrint(*this, s)*/;
-	auto pIter = index.emplace(s, strings.size());
-	if(pIter.second) strings.push_back(s);
-	return pIter.first->second;
+std::size_t StringStore::getIndex(std::string_view s) const {
+	auto &stripe = stripes[std::hash<std::string_view>()(s) % NumStripes];
+	{
+		std::shared_lock<std::shared_mutex> lock(stripe.mtx);
+		const auto iter = stripe.index.find(s);
+		if(iter != stripe.index.end()) return iter->second;
+	}
+	std::unique_lock<std::shared_mutex> lock(stripe.mtx);
+	// it may have been added between the two locks
+	const auto iter = stripe.index.find(s);
+	if(iter != stripe.index.end()) return iter->second;
+	const auto index = numStrings.fetch_add(1, std::memory_order_acq_rel);
+	if(index > std::numeric_limits<std::uint32_t>::max())
+		throw FatalError("Too many strings in the string store.");
+	auto &slot = getSlot(index);
+	slot = s;
+	stripe.index.emplace(slot, index);
+	return index;
 }
 
-const std::string &StringStore::getString(std::size_t index) const {
-	assert(index < strings.size());
-	return strings[index];
+std::string &StringStore::getSlot(std::size_t index) const {
+	const auto [chunk, offset] = locate(index);
+	std::string *data = chunks[chunk].load(std::memory_order_acquire);
+	if(!data) {
+		// insertions in other stripes may need the same chunk
+		auto *fresh = new std::string[std::size_t(1) << (chunk + FirstChunkBits)];
+		if(chunks[chunk].compare_exchange_strong(data, fresh, std::memory_order_acq_rel)) data = fresh;
+		else delete[] fresh;
+	}
+	assert(data);
+	return data[offset];
 }
 
-} // namespace mod::lib
\ No newline at end of file
+} // namespace mod::lib
@@ -1,26 +1,67 @@
 #ifndef MOD_LIB_STRINGSTORE_HPP
 #define MOD_LIB_STRINGSTORE_HPP
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <unordered_map>
 
 namespace mod::lib {
 
+// An append-only set of strings, each identified by a stable index, assigned in the order the strings are added.
+// All functions are thread-safe:
+// - getString does not lock, and the returned references stay valid for the lifetime of the store.
+// - The strings are distributed over a number of stripes by their hash, each with its own index and lock,
+//   so lookups of existing strings only take a shared lock of a single stripe,
+//   and insertions only block lookups and insertions in the same stripe.
 struct StringStore {
-	StringStore() = default;
+	StringStore();
 	StringStore(const StringStore&) = delete;
 	StringStore(StringStore&&) = delete;
 	StringStore &operator=(const StringStore&) = delete;
 	StringStore &operator=(StringStore&&) = delete;
-	bool hasString(const std::string &s) const;
-	std::size_t getIndex(const std::string &s) const;
-	const std::string &getString(std::size_t index) const;
+	~StringStore();
+	bool hasString(std::string_view s) const;
+	// Returns an empty optional if the string is not in the store, without adding it.
+	std::optional<std::size_t> find(std::string_view s) const;
+	// Adds the string if it is not already in the store.
+	std::size_t getIndex(std::string_view s) const;
+
+	const std::string &getString(std::size_t index) const {
+		const auto [chunk, offset] = locate(index);
+		return chunks[chunk].load(std::memory_order_acquire)[offset];
+	}
+
+	std::size_t size() const {
+		return numStrings.load(std::memory_order_acquire);
+	}
+private:
+	// Chunk k has room for 2^(k + FirstChunkBits) strings, so strings never move.
+	static constexpr unsigned int FirstChunkBits = 8;
+	static constexpr unsigned int NumChunks = 32 - FirstChunkBits + 1;
+	static constexpr std::size_t NumStripes = 64;
+
+	static std::pair<unsigned int, std::size_t> locate(std::size_t index) {
+		const std::uint64_t x = std::uint64_t(index) + (std::uint64_t(1) << FirstChunkBits);
+		const unsigned int msb = 63 - __builtin_clzll(x);
+		return {msb - FirstChunkBits, x - (std::uint64_t(1) << msb)};
+	}
+
+	std::string &getSlot(std::size_t index) const;
 private:
-	mutable std::vector<std::string> strings;
-	mutable std::map<std::string, std::size_t> index;
+	struct Stripe {
+		std::shared_mutex mtx;
+		std::unordered_map<std::string_view, std::size_t> index; // views of the stored strings
+	};
+	mutable std::array<Stripe, NumStripes> stripes;
+	mutable std::array<std::atomic<std::string *>, NumChunks> chunks;
+	mutable std::atomic<std::size_t> numStrings;
 };
 
 } // namespace mod::lib
 
-#endif // MOD_LIB_STRINGSTORE_HPP
\ No newline at end of file
+#endif // MOD_LIB_STRINGSTORE_HPP
@@ -0,0 +1,37 @@
+#include "GroundTerm.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mod::lib::Term {
+namespace {
+
+// a structure is keyed by its name followed by the ids of its arguments
+using Key = std::vector<std::size_t>;
+
+std::mutex tableMutex;
+std::unordered_map<Key, std::size_t, boost::hash<Key>> table;
+
+} // namespace
+
+std::optional<std::size_t> getGroundTermId(const Wam &machine, Address addr) {
+	addr = machine.deref(addr);
+	const Cell &cell = machine.getCell(addr);
+	if(cell.tag == Cell::Tag::REF) return {};
+	assert(cell.tag == Cell::Tag::Structure);
+	Key key;
+	key.reserve(1 + cell.Structure.arity);
+	key.push_back(cell.Structure.name);
+	for(int i = 1; i <= cell.Structure.arity; ++i) {
+		const auto arg = getGroundTermId(machine, addr + i);
+		if(!arg) return {};
+		key.push_back(*arg);
+	}
+	std::scoped_lock lock(tableMutex);
+	return table.emplace(std::move(key), table.size()).first->second;
+}
+
+} // namespace mod::lib::Term
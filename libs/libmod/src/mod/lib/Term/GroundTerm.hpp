@@ -0,0 +1,19 @@
+#ifndef MOD_LIB_TERM_GROUNDTERM_HPP
+#define MOD_LIB_TERM_GROUNDTERM_HPP
+
+#include <mod/lib/Term/WAM.hpp>
+
+#include <optional>
+
+namespace mod::lib::Term {
+
+// Hash consing of ground terms: two ground terms get the same id if and only if they are equal,
+// also when they are stored in different machines.
+// The ids are given in the order the terms are first seen, so they are only stable within a process.
+// The table is shared, and may be used concurrently.
+// Returns an empty optional if the term has a variable.
+std::optional<std::size_t> getGroundTermId(const Wam &machine, Address addr);
+
+} // namespace mod::lib::Term
+
+#endif // MOD_LIB_TERM_GROUNDTERM_HPP
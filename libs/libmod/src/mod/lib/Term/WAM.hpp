@@ -107,6 +107,11 @@ public:
 };
 
 struct Wam {
+	// A position in the trail, for undoing all changes made after it.
+	struct TrailMark {
+		std::size_t heapSize, trailSize, numBindings;
+	};
+public:
 	void verify() const;
 
 	Address putStructurePtr(std::size_t addr) {
@@ -270,6 +275,36 @@ struct Wam {
 		swap(heap, temp);
 	}
 
+	// While trailing, unification records the previous value of every cell it modifies,
+	// so the changes can be undone with undoTrail, e.g., when backtracking in a search.
+	void startTrail() {
+		trailing = true;
+	}
+
+	void stopTrail() {
+		trailing = false;
+		trail.clear();
+	}
+
+	TrailMark getTrailMark(const MGU &mgu) const {
+		return {heap.size(), trail.size(), mgu.bindings.size()};
+	}
+
+	// Undoes all unifications done since the mark was taken, including the bindings recorded in the MGU.
+	void undoTrail(TrailMark mark, MGU &mgu) {
+		assert(trailing);
+		assert(trail.size() >= mark.trailSize);
+		while(trail.size() != mark.trailSize) {
+			getCell(trail.back().first) = trail.back().second;
+			trail.pop_back();
+		}
+		assert(heap.size() >= mark.heapSize);
+		heap.resize(mark.heapSize);
+		assert(mgu.bindings.size() >= mark.numBindings);
+		mgu.bindings.resize(mark.numBindings);
+		mgu.status = MGU::Status::Exists;
+	}
+
 	void revert(const MGU &mgu) {
 		for(const Address &a : mgu.bindings) {
 			Cell &c = getCell(a);
@@ -280,9 +315,17 @@ struct Wam {
 		assert(heap.size() >= mgu.preHeapSize);
 		heap.resize(mgu.preHeapSize);
 	}
+private:
+	Cell &modifyCell(Address addr) {
+		Cell &cell = getCell(addr);
+		if(trailing) trail.emplace_back(addr, cell);
+		return cell;
+	}
 private:
 	std::vector<Cell> heap;
 	std::vector<Cell> temp;
+	bool trailing = false;
+	std::vector<std::pair<Address, Cell>> trail;
 };
 
 //------------------------------------------------------------------------------
@@ -346,12 +389,12 @@ inline void Wam::unifyHeapHeap(std::size_t lhs, std::size_t rhs, MGU &mgu) {
 			if(rightCell.tag == Cell::Tag::REF && rightCell.REF.addr < leftCell.REF.addr) {
 				// right = left
 				assert(heap[rhs].REF.addr.type == AddressType::Heap);
-				heap[rhs].REF.addr.addr = lhs;
+				modifyCell({AddressType::Heap, rhs}).REF.addr.addr = lhs;
 				mgu.bindings.push_back(Address{AddressType::Heap, rhs});
 			} else {
 				// left = right
 				assert(heap[lhs].REF.addr.type == AddressType::Heap);
-				heap[lhs].REF.addr.addr = rhs;
+				modifyCell({AddressType::Heap, lhs}).REF.addr.addr = rhs;
 				mgu.bindings.push_back(Address{AddressType::Heap, lhs});
 			}
 		} else {
@@ -387,7 +430,9 @@ inline void Wam::verify() const {
 }
 
 inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &mgu) {
+#ifndef NDEBUG
 	verify();
+#endif
 	// deref(rhsIndex) will point to heap
 	// This destroys temp.
 	// This method acts as the outer-most loop that creates get_structure, unify_variable and unify_value instructions
@@ -406,7 +451,7 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 			Cell rhsCell = getCell(rhsAddr);
 			if(rhsCell.tag == Cell::Tag::REF) {
 				assert(rhsCell.REF.addr == rhsAddr);
-				getCell(rhsAddr).REF.addr = lhsAddr;
+				modifyCell(rhsAddr).REF.addr = lhsAddr;
 				mgu.bindings.push_back(rhsAddr);
 			} else if(rhsCell.tag == Cell::Tag::Structure) {
 				Cell lhsCell = getCell(lhsAddr);
@@ -414,11 +459,10 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 					assert(lhsCell.REF.addr == lhsAddr);
 					// copy the structure to the heap, and bind lhs to it
 					Address rhsAddrNew = putStructure(rhsCell.Structure.name, rhsCell.Structure.arity);
-					getCell(lhsAddr).REF.addr = rhsAddrNew;
+					modifyCell(lhsAddr).REF.addr = rhsAddrNew;
 					mgu.bindings.push_back(lhsAddr);
 					// overwrite rhs
-					getCell(rhsAddr).tag = Cell::Tag::STR;
-					getCell(rhsAddr).STR.addr = rhsAddrNew;
+					modifyCell(rhsAddr) = Cell::makeSTR(rhsAddrNew);
 					// copy arguments
 					for(int i = 1; i <= rhsCell.Structure.arity; i++) {
 						Address rhsSubAddr = rhsAddr + i;
@@ -432,8 +476,8 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 						case Cell::Tag::Structure:
 							assert(rhsSubCell.Structure.arity == 0);
 							// overwrite rhs and append structure
-							getCell(rhsSubAddr).tag = Cell::Tag::STR;
-							getCell(rhsSubAddr).STR.addr = putStructure(rhsSubCell.Structure.name, rhsSubCell.Structure.arity);
+							const auto addrNew = putStructure(rhsSubCell.Structure.name, rhsSubCell.Structure.arity);
+							modifyCell(rhsSubAddr) = Cell::makeSTR(addrNew);
 							break;
 						}
 					}
@@ -443,8 +487,7 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 						for(std::size_t i = lhsCell.Structure.arity; i > 0; i--)
 							stack.emplace(lhsAddr + i, rhsAddr + i);
 						// overwrite rhs to point to heap
-						getCell(rhsAddr).tag = Cell::Tag::STR;
-						getCell(rhsAddr).STR.addr = lhsAddr;
+						modifyCell(rhsAddr) = Cell::makeSTR(lhsAddr);
 					} else {
 						mgu.status = MGU::Status::Fail;
 						mgu.errorLeft = lhsAddr;
@@ -457,7 +500,9 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 				MOD_ABORT;
 		}
 	}
+#ifndef NDEBUG
 	verify();
+#endif
 }
 
 } // namespace mod::lib::Term
@@ -19,16 +19,16 @@ std::unique_ptr<lib::Rules::PropString> makePropStringCore(const lib::Rules::Lab
 
 void add(lib::Rules::PropString &pString, lib::DPO::CombinedRule::CombinedVertex v,
          const std::string &valueLeft, const std::string &valueRight) {
-	pString.add(v, valueLeft, valueRight);
+	pString.add(v, lib::InternedString(valueLeft), lib::InternedString(valueRight));
 }
 
 void add(lib::Rules::PropString &pString, lib::DPO::CombinedRule::CombinedEdge e,
          const std::string &valueLeft, const std::string &valueRight) {
-	pString.add(e, valueLeft, valueRight);
+	pString.add(e, lib::InternedString(valueLeft), lib::InternedString(valueRight));
 }
 
 void setRight(lib::Rules::PropString &pString, lib::DPO::CombinedRule::CombinedEdge e, const std::string &value) {
-	pString.setRight(e, value);
+	pString.setRight(e, lib::InternedString(value));
 }
 
 lib::Rules::PropMolecule
@@ -260,6 +260,11 @@ def _DG_load(
 		prefixFilename(f), graphPolicy, verbosity)
 DG.load = _DG_load  # type: ignore
 
+_DG_convertDump_orig = DG.convertDump
+def _DG_convertDump(fileIn: str, fileOut: str) -> None:
+	_DG_convertDump_orig(prefixFilename(fileIn), fileOut)
+DG.convertDump = _DG_convertDump  # type: ignore
+
 _DG__init__old = DG.__init__
 def _DG__init__(self: DG, *,
 		labelSettings: LabelSettings=_lsString,
@@ -380,6 +385,10 @@ class DGBuilder:
 			_wrap(libpymod._VecRule, ruleDatabase),
 			prefixFilename(f), verbosity)
 
+	def startJournal(self, f: str) -> None:
+		assert self._builder
+		return self._builder.startJournal(f)
+
 _DG_build_orig = DG.build
 DG.build = lambda self: DGBuilder(self)  # type: ignore
 
@@ -504,7 +513,9 @@ def _DGStrat_makeParallel(l: Iterable[DGStrat]) -> DGStrat:
 DGStrat.makeParallel = _DGStrat_makeParallel  # type: ignore
 
 _DGStrat_makeFilter_orig = DGStrat.makeFilter
-def _DGStrat_makeFilter(alsoUniverse: bool, filterFunc: Callable[[Graph, DGStrat.GraphState, bool], bool]) -> DGStrat:
+def _DGStrat_makeFilter(alsoUniverse: bool, filterFunc: Union[Callable[[Graph, DGStrat.GraphState, bool], bool], GraphPredicate]) -> DGStrat:
+	if isinstance(filterFunc, GraphPredicate):
+		return _DGStrat_makeFilter_orig(alsoUniverse, filterFunc)
 	return _DGStrat_makeFilter_orig(alsoUniverse, _funcWrap(libpymod._Func_BoolGraphDGStratGraphStateBool, filterFunc))
 DGStrat.makeFilter = _DGStrat_makeFilter  # type: ignore
 
@@ -514,12 +525,16 @@ def _DGStrat_makeExecute(func: Callable[[DGStrat.GraphState], None]) -> DGStrat:
 DGStrat.makeExecute = _DGStrat_makeExecute  # type: ignore
 
 _DGStrat_makeLeftPredicate_orig = DGStrat.makeLeftPredicate
-def _DGStrat_makeLeftPredicate(pred: Callable[[Derivation], bool], strat: DGStrat) -> DGStrat:
+def _DGStrat_makeLeftPredicate(pred: Union[Callable[[Derivation], bool], DGDerivationPredicate], strat: DGStrat) -> DGStrat:
+	if isinstance(pred, DGDerivationPredicate):
+		return _DGStrat_makeLeftPredicate_orig(pred, strat)
 	return _DGStrat_makeLeftPredicate_orig(_funcWrap(libpymod._Func_BoolDerivation, pred), strat)
 DGStrat.makeLeftPredicate = _DGStrat_makeLeftPredicate  # type: ignore
 
 _DGStrat_makeRightPredicate_orig = DGStrat.makeRightPredicate
-def _DGStrat_makeRightPredicate(pred: Callable[[Derivation], bool], strat: DGStrat) -> DGStrat:
+def _DGStrat_makeRightPredicate(pred: Union[Callable[[Derivation], bool], DGDerivationPredicate], strat: DGStrat) -> DGStrat:
+	if isinstance(pred, DGDerivationPredicate):
+		return _DGStrat_makeRightPredicate_orig(pred, strat)
 	return _DGStrat_makeRightPredicate_orig(_funcWrap(libpymod._Func_BoolDerivation, pred), strat)
 DGStrat.makeRightPredicate = _DGStrat_makeRightPredicate  # type: ignore
 
@@ -577,7 +592,7 @@ def addSubset(g: _DGStratAddStaticGraphType , *gs: _DGStratAddStaticGraphType,
 #----------------------------------------------------------
 
 class _DGStrat_DerivationPredicateProxyPredicateHolder:
-	def __init__(self, isLeft: bool, predicate: Callable[[Derivation], bool]) -> None:
+	def __init__(self, isLeft: bool, predicate: Union[Callable[[Derivation], bool], DGDerivationPredicate]) -> None:
 		self.isLeft = isLeft
 		self.predicate = predicate
 	def __call__(self, strat: DGStrat) -> DGStrat:
@@ -589,7 +604,7 @@ class _DGStrat_DerivationPredicateProxyPredicateHolder:
 class _DGStrat_DerivationPredicateProxy:
 	def __init__(self, isLeft: bool):
 		self.isLeft = isLeft
-	def __getitem__(self, predicate: Callable[[Derivation], bool]) -> _DGStrat_DerivationPredicateProxyPredicateHolder:
+	def __getitem__(self, predicate: Union[Callable[[Derivation], bool], DGDerivationPredicate]) -> _DGStrat_DerivationPredicateProxyPredicateHolder:
 		return _DGStrat_DerivationPredicateProxyPredicateHolder(self.isLeft, predicate)
 
 leftPredicate = _DGStrat_DerivationPredicateProxy(True)
@@ -606,7 +621,7 @@ execute = lambda func: DGStrat.makeExecute(func)
 class _DGStrat_FilterProxy:
 	def __init__(self, alsoUniverse: bool) -> None:
 		self.alsoUniverse = alsoUniverse
-	def __call__(self, filterFunc: Callable[[Graph, DGStrat.GraphState, bool], bool]) -> DGStrat:
+	def __call__(self, filterFunc: Union[Callable[[Graph, DGStrat.GraphState, bool], bool], GraphPredicate]) -> DGStrat:
 		return DGStrat.makeFilter(self.alsoUniverse, filterFunc)
 
 filterUniverse = _DGStrat_FilterProxy(True)
@@ -703,6 +718,11 @@ _Graph_enumerateMonomorphisms = Graph.enumerateMonomorphisms  # type: ignore
 Graph.enumerateMonomorphisms = lambda self, codomain, *, callback, labelSettings=_lsString: _Graph_enumerateMonomorphisms(  # type: ignore
 	self, codomain, _funcWrap(libpymod._Func_BoolVertexMapGraphGraph, callback), labelSettings)  # type: ignore
 
+_GraphPredicate_isomorphicTo = GraphPredicate.isomorphicTo
+GraphPredicate.isomorphicTo = staticmethod(lambda g, labelSettings=_lsString: _GraphPredicate_isomorphicTo(g, labelSettings))  # type: ignore
+_GraphPredicate_hasSubgraph = GraphPredicate.hasSubgraph
+GraphPredicate.hasSubgraph = staticmethod(lambda pattern, labelSettings=_lsString: _GraphPredicate_hasSubgraph(pattern, labelSettings))  # type: ignore
+
 _Graph_getGMLString = Graph.getGMLString
 Graph.getGMLString = lambda self, withCoords=False: _Graph_getGMLString(self, withCoords)  # type: ignore
 _Graph_printGML = Graph.printGML
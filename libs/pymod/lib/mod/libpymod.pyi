@@ -213,6 +213,25 @@ class DGPrinter:
 	def setImageOverwrite(self, f: Union[Callable[[DGVertex, int], str], str]) -> None: ...
 
 
+class DGDerivationPredicate:
+	def __call__(self, d: Derivation) -> bool: ...
+	def usesRight(self) -> bool: ...
+	def __and__(self, other: DGDerivationPredicate) -> DGDerivationPredicate: ...
+	def __or__(self, other: DGDerivationPredicate) -> DGDerivationPredicate: ...
+	def __invert__(self) -> DGDerivationPredicate: ...
+
+	@staticmethod
+	def constant(value: bool) -> DGDerivationPredicate: ...
+	@staticmethod
+	def allLeft(p: GraphPredicate) -> DGDerivationPredicate: ...
+	@staticmethod
+	def anyLeft(p: GraphPredicate) -> DGDerivationPredicate: ...
+	@staticmethod
+	def allRight(p: GraphPredicate) -> DGDerivationPredicate: ...
+	@staticmethod
+	def anyRight(p: GraphPredicate) -> DGDerivationPredicate: ...
+
+
 class DGPrintData:
 	def __init__(self, dg: DG) -> None: ...
 
@@ -232,15 +251,15 @@ class DGStrat:
 	@staticmethod
 	def makeParallel(strats: List[DGStrat]) -> DGStrat: ...
 	@staticmethod
-	def makeFilter(alsoUniverse: bool, p: Callable[[Graph, GraphState, bool], bool]) -> DGStrat: ...
+	def makeFilter(alsoUniverse: bool, p: Union[Callable[[Graph, GraphState, bool], bool], GraphPredicate]) -> DGStrat: ...
 	@staticmethod
 	def makeExecute(func: Callable[[GraphState], None]) -> DGStrat: ...
 	@staticmethod
 	def makeRule(rule: Rule) -> DGStrat: ...
 	@staticmethod
-	def makeLeftPredicate(p: Callable[[Derivation], bool], strat: DGStrat) -> DGStrat: ...
+	def makeLeftPredicate(p: Union[Callable[[Derivation], bool], DGDerivationPredicate], strat: DGStrat) -> DGStrat: ...
 	@staticmethod
-	def makeRightPredicate(p: Callable[[Derivation], bool], strat: DGStrat) -> DGStrat: ...
+	def makeRightPredicate(p: Union[Callable[[Derivation], bool], DGDerivationPredicate], strat: DGStrat) -> DGStrat: ...
 	@staticmethod
 	def makeRevive(strat: DGStrat) -> DGStrat: ...
 	@staticmethod
@@ -316,6 +335,55 @@ class GraphAutGroup: ...
 class GraphPrinter: ...
 
 
+_QuantityLike = Union[GraphQuantity, float]
+
+class GraphQuantity:
+	def __init__(self, value: float) -> None: ...
+	def __call__(self, g: Graph) -> float: ...
+	def __add__(self, other: _QuantityLike) -> GraphQuantity: ...
+	def __radd__(self, other: float) -> GraphQuantity: ...
+	def __sub__(self, other: _QuantityLike) -> GraphQuantity: ...
+	def __rsub__(self, other: float) -> GraphQuantity: ...
+	def __mul__(self, other: _QuantityLike) -> GraphQuantity: ...
+	def __rmul__(self, other: float) -> GraphQuantity: ...
+	def __lt__(self, other: _QuantityLike) -> GraphPredicate: ...
+	def __le__(self, other: _QuantityLike) -> GraphPredicate: ...
+	def __gt__(self, other: _QuantityLike) -> GraphPredicate: ...
+	def __ge__(self, other: _QuantityLike) -> GraphPredicate: ...
+	def __eq__(self, other: _QuantityLike) -> GraphPredicate: ...  # type: ignore
+	def __ne__(self, other: _QuantityLike) -> GraphPredicate: ...  # type: ignore
+
+	@staticmethod
+	def numVertices() -> GraphQuantity: ...
+	@staticmethod
+	def numEdges() -> GraphQuantity: ...
+	@staticmethod
+	def vertexLabelCount(label: str) -> GraphQuantity: ...
+	@staticmethod
+	def edgeLabelCount(label: str) -> GraphQuantity: ...
+	@staticmethod
+	def exactMass() -> GraphQuantity: ...
+	@staticmethod
+	def charge() -> GraphQuantity: ...
+	@staticmethod
+	def numRings() -> GraphQuantity: ...
+
+class GraphPredicate:
+	def __call__(self, g: Graph) -> bool: ...
+	def __and__(self, other: GraphPredicate) -> GraphPredicate: ...
+	def __or__(self, other: GraphPredicate) -> GraphPredicate: ...
+	def __invert__(self) -> GraphPredicate: ...
+
+	@staticmethod
+	def constant(value: bool) -> GraphPredicate: ...
+	@staticmethod
+	def isMolecule() -> GraphPredicate: ...
+	@staticmethod
+	def isomorphicTo(g: Graph, labelSettings: LabelSettings = ...) -> GraphPredicate: ...
+	@staticmethod
+	def hasSubgraph(pattern: Graph, labelSettings: LabelSettings = ...) -> GraphPredicate: ...
+
+
 def graphGMLString(s: str) -> Graph: ...
 def graphGML(f: str) -> Graph: ...
 def graphDFS(s: str) -> Graph: ...
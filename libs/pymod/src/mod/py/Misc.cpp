@@ -78,6 +78,11 @@ void Misc_doExport() {
 	// rst:		:returns: the version of MØD.
 	// rst:		:rtype: str
 	py::def("version", &mod::version);
+	// rst: .. function:: isDebugBuild()
+	// rst:
+	// rst:		:returns: whether libMØD was compiled without ``NDEBUG``, i.e., with assertions enabled.
+	// rst:		:rtype: bool
+	py::def("isDebugBuild", &mod::isDebugBuild);
 
 	// rst: .. function:: rngReseed(seed)
 	// rst:
@@ -12,8 +12,8 @@
 
 #define MOD_NAMESPACED_FILES()                                                   \
    ((graph, (Printer))) /* this must be before DGGraphInterface due to default arg */ \
-   ((dg, (Builder) (DG) (GraphInterface) (Printer) (Strategy)))                  \
-   ((graph, (Graph) (Union)))                                                    \
+   ((dg, (Builder) (DG) (DerivationPredicate) (GraphInterface) (Printer) (Strategy))) \
+   ((graph, (Graph) (Predicate) (Union)))                                        \
    ((graph, (Automorphism) (GraphInterface))) /* nested classes of Graph, so must be after */ \
    ((rule, (CompositionMatch) (Composition) (Rule) (GraphInterface)))            \
    ((post, (Post)))
@@ -11,17 +11,30 @@ namespace {
 std::shared_ptr<ExecuteResult>
 Builder_execute(std::shared_ptr<Builder> b, std::shared_ptr<Strategy> strategy, int verbosity,
                 bool ignoreRuleLabelTypes) {
+	// Python functions in the strategy acquire the GIL again when called
+	mod::Py::AllowThreads allow;
 	return std::make_shared<ExecuteResult>(b->execute(strategy, verbosity, ignoreRuleLabelTypes));
 }
 
+std::vector<DG::HyperEdge> Builder_apply(std::shared_ptr<Builder> b,
+                                         const std::vector<std::shared_ptr<graph::Graph> > &graphs,
+                                         std::shared_ptr<rule::Rule> r, bool onlyProper,
+                                         int verbosity, IsomorphismPolicy graphPolicy) {
+	mod::Py::AllowThreads allow;
+	return b->apply(graphs, r, onlyProper, verbosity, graphPolicy);
+}
+
+void Builder_load(std::shared_ptr<Builder> b, const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
+                  const std::string &file, int verbosity) {
+	mod::Py::AllowThreads allow;
+	b->load(ruleDatabase, file, verbosity);
+}
+
 } // namespace
 
 void Builder_doExport() {
 	using AddDerivation = DG::HyperEdge (Builder::*)(const Derivations &, IsomorphismPolicy);
 	using AddHyperEdge = DG::HyperEdge (Builder::*)(const DG::HyperEdge &, IsomorphismPolicy);
-	using Apply = std::vector<DG::HyperEdge> (Builder::*)(const std::vector<std::shared_ptr<graph::Graph> > &,
-	                                                      std::shared_ptr<rule::Rule>, bool,
-	                                                      int, IsomorphismPolicy);
 	// rst: .. class:: DGBuilder
 	// rst:
 	// rst:		An RAII-style object obtained from :meth:`DG.build`.
@@ -131,7 +144,7 @@ void Builder_doExport() {
 					// rst:			:raises: :class:`LogicError` if ``graphPolicy == IsomorphismPolicy.Check`` and a given graph object
 					// rst:				is different but isomorphic to another given graph object or to a graph object already
 					// rst:				in the internal graph database in the associated derivation graph.
-			.def("apply", static_cast<Apply>(&Builder::apply))
+			.def("apply", &Builder_apply)
 					// rst:		.. method:: addAbstract(description)
 					// rst:
 					// rst:			Add vertices and hyperedges based on the given abstract description.
@@ -164,7 +177,27 @@ void Builder_doExport() {
 					// rst:			:raises: :class:`LogicError` if there is a ``None`` in ``ruleDatabase``.
 					// rst:			:raises: :class:`LogicError` if the label settings of the dump does not match those of this DG.
 					// rst: 			:raises: :class:`InputError` if the file can not be opened or its content is bad.
-			.def("load", &Builder::load);
+			.def("load", &Builder_load)
+					// rst:		.. method:: startJournal(f)
+					// rst:
+					// rst:			Start writing a journal of the derivation graph to the given file.
+					// rst:			The current vertices and hyperedges are written first,
+					// rst:			and then each vertex and hyperedge is appended when it is added,
+					// rst:			e.g., during :meth:`execute`.
+					// rst:			The records are handed to the operating system at least once per second,
+					// rst:			and the file is synced to the disk every ``config.dg.journalSyncInterval`` seconds.
+					// rst:			The journal is closed when the builder is closed.
+					// rst:
+					// rst:			A journal can be loaded like a dump, with :meth:`DG.load` or :meth:`load`,
+					// rst:			e.g., to recover a derivation graph from a calculation that was terminated.
+					// rst:			An incomplete record at the end of the journal is ignored.
+					// rst:			The graph names recorded are those the graphs have when they become vertices.
+					// rst:
+					// rst:			:param str f: the name of the file to write the journal to.
+					// rst:				It is used literally, like the filename given to :meth:`DG.dump`.
+					// rst:			:raises: :class:`LogicError` if the file can not be opened.
+					// rst:			:raises: :class:`LogicError` if the derivation graph has stereo label settings.
+			.def("startJournal", &Builder::startJournal);
 
 	// rst: .. class:: DGExecuteResult
 	// rst:
@@ -22,14 +22,17 @@ std::shared_ptr<Builder> DG_build(std::shared_ptr<DG> dg_) {
 	return std::make_shared<Builder>(dg_->build());
 }
 
+std::shared_ptr<DG> DG_load(const std::vector<std::shared_ptr<graph::Graph>> &graphDatabase,
+                            const std::vector<std::shared_ptr<rule::Rule>> &ruleDatabase,
+                            const std::string &file,
+                            IsomorphismPolicy graphPolicy, int verbosity) {
+	mod::Py::AllowThreads allow;
+	return DG::load(graphDatabase, ruleDatabase, file, graphPolicy, verbosity);
+}
+
 } // namespace
 
 void DG_doExport() {
-	using Load = std::shared_ptr<DG> (*)(const std::vector<std::shared_ptr<graph::Graph>> &,
-	                                     const std::vector<std::shared_ptr<rule::Rule>> &,
-	                                     const std::string &,
-	                                     IsomorphismPolicy, int);
-
 	// rst: .. class:: DG
 	// rst:
 	// rst:		The derivation graph class. A derivation graph is a directed multi-hypergraph
@@ -204,6 +207,27 @@ void DG_doExport() {
 					// rst:			:raises: :class:`LogicError` if the target file can not be opened.
 			.def("dump", static_cast<std::string (DG::*)() const>(&DG::dump))
 			.def("dump", static_cast<std::string (DG::*)(const std::string &) const>(&DG::dump))
+					// rst:		.. method:: dumpBinary()
+					// rst:		            dumpBinary(filename)
+					// rst:
+					// rst:			Exports the derivation graph to a file in a binary format with the same content as :meth:`dump`.
+					// rst:			The format is faster to write and to load, and it needs less memory when loading.
+					// rst:			Loading still constructs every vertex graph, as they are checked against the graph database.
+					// rst:			Both :meth:`load` and :meth:`DGBuilder.load` detect the format automatically.
+					// rst:			Use :meth:`convertDump` to convert between the two formats.
+					// rst:
+					// rst:			:param str filename: the name of the file to save the dump to.
+					// rst:				If non is given an auto-generated name in the ``out/`` folder is used.
+					// rst:				If an empty string is given, it is treated as if non is given.
+					// rst:
+					// rst:				.. note:: The filename is being used literally, i.e., it is not being
+					// rst:					prefixed according to the current script location as input filenames are.
+					// rst:			:returns: the filename of the exported derivation graph.
+					// rst:			:rtype: str
+					// rst:			:raises: :class:`LogicError` if the DG is not :attr:`locked`.
+					// rst:			:raises: :class:`LogicError` if the target file can not be opened.
+			.def("dumpBinary", static_cast<std::string (DG::*)() const>(&DG::dumpBinary))
+			.def("dumpBinary", static_cast<std::string (DG::*)(const std::string &) const>(&DG::dumpBinary))
 					// rst:		.. method:: listStats()
 					// rst:
 					// rst:			Lists various statistics for the derivation graph.
@@ -241,8 +265,23 @@ void DG_doExport() {
 					// rst:			:raises: the same exceptions :func:`__init__` raises related to ``graphDatabase`` and ``graphPolicy``.
 					// rst:			:raises: :class:`LogicError` if there is a ``None`` in ``ruleDatabase``.
 					// rst:			:raises: :class:`InputError` if the file can not be opened or its content is bad.
-			.def("load", static_cast<Load>(&DG::load))
-			.staticmethod("load");
+			.def("load", &DG_load)
+			.staticmethod("load")
+					// rst:		.. staticmethod:: convertDump(fileIn, fileOut)
+					// rst:
+					// rst:			Convert a dump made by :meth:`dump` to the format of :meth:`dumpBinary`, or vice versa.
+					// rst:			The direction is determined by the format of the input file.
+					// rst:			Dumps in the formats of version 0.10 and earlier can not be converted,
+					// rst:			but must be loaded with :meth:`load` and dumped again.
+					// rst:
+					// rst:			:param fileIn: the DG dump file to convert.
+					// rst:			:type fileIn: str or CWDPath
+					// rst:			:param str fileOut: the name of the file to save the converted dump to.
+					// rst:				It is used literally, like the filename given to :meth:`dump`.
+					// rst:			:raises: :class:`InputError` if the input file can not be opened or its content is bad.
+					// rst:			:raises: :class:`LogicError` if the output file can not be opened.
+			.def("convertDump", &DG::convertDump)
+			.staticmethod("convertDump");
 
 	// rst: .. method:: diffDGs(dg1, dg2)
 	// rst:
@@ -0,0 +1,80 @@
+#include <mod/py/Common.hpp>
+
+#include <mod/Derivation.hpp>
+#include <mod/Error.hpp>
+#include <mod/dg/DerivationPredicate.hpp>
+
+namespace mod::dg::Py {
+namespace {
+
+DerivationPredicate and_(const DerivationPredicate &a, const DerivationPredicate &b) {
+	return a && b;
+}
+
+DerivationPredicate or_(const DerivationPredicate &a, const DerivationPredicate &b) {
+	return a || b;
+}
+
+DerivationPredicate not_(const DerivationPredicate &a) {
+	return !a;
+}
+
+bool noBool(const DerivationPredicate &) {
+	throw LogicError("Can not convert a derivation predicate to bool. "
+	                 "Use '&', '|', and '~' instead of 'and', 'or', and 'not'.");
+}
+
+} // namespace
+
+void DerivationPredicate_doExport() {
+	// rst: .. class:: DGDerivationPredicate
+	// rst:
+	// rst:		A natively evaluated predicate on :class:`Derivation`\ s,
+	// rst:		which can be given to :data:`leftPredicate` and :data:`rightPredicate` instead of a Python function,
+	// rst:		e.g., ``rightPredicate[DGDerivationPredicate.allRight(GraphQuantity.vertexLabelCount("C") <= 6)](strat)``.
+	// rst:		Recall that in a left predicate only the left side and the rule of the derivation are valid,
+	// rst:		so the right side is empty. For example, :meth:`allRight` would therefore be true for every derivation,
+	// rst:		and predicates using :meth:`allRight` or :meth:`anyRight` are rejected as left predicates.
+	// rst:		Predicates can be combined with ``&``, ``|``, and ``~``,
+	// rst:		and the binary operators short-circuit when the predicate is evaluated.
+	// rst:
+	py::class_<DerivationPredicate>("DGDerivationPredicate", py::no_init)
+			// rst:		.. method:: __call__(d)
+			// rst:
+			// rst:			:param Derivation d: the derivation to evaluate the predicate for.
+			// rst:			:returns: whether ``d`` satisfies the predicate.
+			// rst:			:rtype: bool
+			.def("__call__", &DerivationPredicate::operator())
+					// rst:		.. method:: usesRight()
+					// rst:
+					// rst:			:returns: whether the predicate is composed using :meth:`allRight` or :meth:`anyRight`,
+					// rst:				i.e., whether it depends on the right side of the derivation.
+					// rst:			:rtype: bool
+			.def("usesRight", &DerivationPredicate::usesRight)
+			.def("__bool__", &noBool)
+			.def(str(py::self))
+			.def("__and__", &and_)
+			.def("__or__", &or_)
+			.def("__invert__", &not_)
+					// rst:		.. staticmethod:: constant(value)
+					// rst:
+					// rst:			:param bool value: the constant value.
+					// rst:			:returns: a predicate which is ``value`` for every derivation.
+					// rst:			:rtype: DGDerivationPredicate
+			.def("constant", &DerivationPredicate::constant).staticmethod("constant")
+					// rst:		.. staticmethod:: allLeft(p)
+					// rst:		                  anyLeft(p)
+					// rst:		                  allRight(p)
+					// rst:		                  anyRight(p)
+					// rst:
+					// rst:			:param GraphPredicate p: the predicate to evaluate for the graphs.
+					// rst:			:returns: a predicate which is true for derivations where respectively all or some of the graphs
+					// rst:				on the given side satisfy ``p``.
+					// rst:			:rtype: DGDerivationPredicate
+			.def("allLeft", &DerivationPredicate::allLeft).staticmethod("allLeft")
+			.def("anyLeft", &DerivationPredicate::anyLeft).staticmethod("anyLeft")
+			.def("allRight", &DerivationPredicate::allRight).staticmethod("allRight")
+			.def("anyRight", &DerivationPredicate::anyRight).staticmethod("anyRight");
+}
+
+} // namespace mod::dg::Py
@@ -1,7 +1,9 @@
 #include <mod/py/Common.hpp>
 
 #include <mod/dg/DG.hpp>
+#include <mod/dg/DerivationPredicate.hpp>
 #include <mod/dg/Strategies.hpp>
+#include <mod/graph/Predicate.hpp>
 
 // rst: This section describes two interfaces for the derivation graph strategies;
 // rst: the basic API and an embedded language which is built on the basic API.
@@ -64,12 +66,15 @@
 // rst:
 // rst:		:returns: the result of the corresponding :func:`DGStrat.makeFilter`.
 // rst:
+// rst:		The predicate ``p`` can also be a :class:`GraphPredicate`, which is evaluated without calling Python code.
+// rst:
 // rst:
 // rst: .. data:: leftPredicate
 // rst:           rightPredicate
 // rst:
 // rst:		Objects of unspecified type which can be used as ``obj[pred](strat)``.
 // rst:		This will call respectively :func:`DGStrat.makeLeftPredicate` or :func:`DGStrat.makeRightPredicate`.
+// rst:		The predicate can also be a :class:`DGDerivationPredicate`, which is evaluated without calling Python code.
 // rst:
 // rst: .. data:: repeat
 // rst:
@@ -95,6 +100,19 @@ void Strategy_doExport() {
 	std::shared_ptr<Strategy> (*makeAdd_dynamic)(bool,
 	                                             const std::shared_ptr<mod::Function<std::vector<std::shared_ptr<graph::Graph>>()>>,
 	                                             IsomorphismPolicy) = &Strategy::makeAdd;
+	std::shared_ptr<Strategy> (*makeFilter_func)(bool,
+	                                             std::shared_ptr<mod::Function<bool(std::shared_ptr<graph::Graph>,
+	                                                                                const Strategy::GraphState &,
+	                                                                                bool)>>) = &Strategy::makeFilter;
+	std::shared_ptr<Strategy> (*makeFilter_native)(bool, const graph::Predicate &) = &Strategy::makeFilter;
+	std::shared_ptr<Strategy> (*makeLeftPredicate_func)(std::shared_ptr<mod::Function<bool(const Derivation &)>>,
+	                                                    std::shared_ptr<Strategy>) = &Strategy::makeLeftPredicate;
+	std::shared_ptr<Strategy> (*makeLeftPredicate_native)(const DerivationPredicate &,
+	                                                      std::shared_ptr<Strategy>) = &Strategy::makeLeftPredicate;
+	std::shared_ptr<Strategy> (*makeRightPredicate_func)(std::shared_ptr<mod::Function<bool(const Derivation &)>>,
+	                                                     std::shared_ptr<Strategy>) = &Strategy::makeRightPredicate;
+	std::shared_ptr<Strategy> (*makeRightPredicate_native)(const DerivationPredicate &,
+	                                                       std::shared_ptr<Strategy>) = &Strategy::makeRightPredicate;
 	// rst: .. class:: DGStrat
 	// rst: 
 	auto pyStrat = py::class_<Strategy, std::shared_ptr<Strategy>, boost::noncopyable>("DGStrat", py::no_init)
@@ -142,10 +160,13 @@ void Strategy_doExport() {
 					// rst:			:param p: the filtering predicate being called for each graph in either the subset or the universe.
 					// rst:				The predicate is called with the graph and the graph state as arguments, and a bool stating whether or not
 					// rst:				the call is the first in the filtering process.
-					// rst:			:type p: Callable[[Graph, DGStrat.GraphState, bool], bool]
+					// rst:				Instead of a function, a natively evaluated :class:`GraphPredicate` may be given,
+					// rst:				in which case only the graph is given to the predicate.
+					// rst:			:type p: Callable[[Graph, DGStrat.GraphState, bool], bool] or GraphPredicate
 					// rst:			:returns: a :ref:`strat-filterUniverse` strategy if ``onlyUniverse`` is ``True``, otherwise a :ref:`strat-filterSubset` strategy.
 					// rst:			:rtype: DGStrat
-			.def("makeFilter", &Strategy::makeFilter).staticmethod("makeFilter")
+			.def("makeFilter", makeFilter_func)
+			.def("makeFilter", makeFilter_native).staticmethod("makeFilter")
 					// rst:		.. staticmethod:: makeExecute(func)
 					// rst:
 					// rst:			:param func: A function being executed when the strategy is evaluated.
@@ -164,21 +185,27 @@ void Strategy_doExport() {
 					// rst:
 					// rst:			:param p: the predicate to be called on each candidate derivation.
 					// rst:				Even though the predicate is called with a :class:`Derivation` object, only the left side and the rule of the object is valid.
-					// rst:			:type p: Callable[[Derivation], bool]
+					// rst:				Instead of a function, a natively evaluated :class:`DGDerivationPredicate` may be given.
+					// rst:			:type p: Callable[[Derivation], bool] or DGDerivationPredicate
 					// rst:			:param DGStrat strat: the sub-strategy to be evaluated under the constraints of the left predicate.
 					// rst:			:returns: a :ref:`strat-leftPredicate` strategy.
 					// rst:			:rtype: DGStrat
 					// rst:			:raises: :class:`LogicError` if ``strat`` is ``None``.
-			.def("makeLeftPredicate", &Strategy::makeLeftPredicate).staticmethod("makeLeftPredicate")
+					// rst:			:raises: :class:`LogicError` if ``p`` is a :class:`DGDerivationPredicate` using the right side,
+					// rst:				see :meth:`DGDerivationPredicate.usesRight`.
+			.def("makeLeftPredicate", makeLeftPredicate_func)
+			.def("makeLeftPredicate", makeLeftPredicate_native).staticmethod("makeLeftPredicate")
 					// rst:		.. staticmethod:: makeRightPredicate(p, strat)
 					// rst:
 					// rst:			:param p: the predicate to be called on each candidate derivation.
-					// rst:			:type p: Callable[[Derivation], bool]
+					// rst:				Instead of a function, a natively evaluated :class:`DGDerivationPredicate` may be given.
+					// rst:			:type p: Callable[[Derivation], bool] or DGDerivationPredicate
 					// rst:			:param DGStrat strat: the sub-strategy to be evaluated under the constraints of the right predicate.
 					// rst:			:returns: a :ref:`strat-rightPredicate` strategy.
 					// rst:			:rtype: DGStrat
 					// rst:			:raises: :class:`LogicError` if ``strat`` is ``None``.
-			.def("makeRightPredicate", &Strategy::makeRightPredicate).staticmethod("makeRightPredicate")
+			.def("makeRightPredicate", makeRightPredicate_func)
+			.def("makeRightPredicate", makeRightPredicate_native).staticmethod("makeRightPredicate")
 					// rst:		.. staticmethod:: makeRevive(strat)
 					// rst:
 					// rst:			:param DGStrat strat: the strategy to encapsulate.
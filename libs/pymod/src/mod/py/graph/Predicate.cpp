@@ -0,0 +1,164 @@
+#include <mod/py/Common.hpp>
+
+#include <mod/Error.hpp>
+#include <mod/graph/Graph.hpp>
+#include <mod/graph/Predicate.hpp>
+
+// rst: Graph quantities and predicates are natively evaluated functions of graphs,
+// rst: which can be given to strategies instead of Python functions,
+// rst: e.g., ``filterUniverse(GraphQuantity.vertexLabelCount("C") <= 6)``.
+// rst: When a strategy uses them, no Python code is executed for each graph or derivation.
+// rst:
+// rst: Note that the Python operators ``and``, ``or``, and ``not``, and chained comparisons such as ``0 <= q <= 6``,
+// rst: can not be overloaded. Use instead ``&``, ``|``, and ``~`` to combine predicates.
+// rst: Converting a predicate to a :class:`bool` raises a :class:`LogicError` in order to catch such mistakes.
+// rst:
+
+namespace mod::graph::Py {
+namespace {
+
+Predicate and_(const Predicate &a, const Predicate &b) {
+	return a && b;
+}
+
+Predicate or_(const Predicate &a, const Predicate &b) {
+	return a || b;
+}
+
+Predicate not_(const Predicate &a) {
+	return !a;
+}
+
+template<typename T>
+bool noBool(const T &) {
+	throw LogicError("Can not convert a graph quantity or predicate to bool. "
+	                 "Use '&', '|', and '~' instead of 'and', 'or', and 'not', and do not use chained comparisons.");
+}
+
+} // namespace
+
+void Predicate_doExport() {
+	// rst: .. class:: GraphQuantity
+	// rst:
+	// rst:		A numeric property of graphs.
+	// rst:		Quantities can be combined with ``+``, ``-``, and ``*``,
+	// rst:		and compared with ``<``, ``<=``, ``>``, ``>=``, ``==``, and ``!=`` to form a :class:`GraphPredicate`.
+	// rst:		Wherever a quantity is expected a number can be given as well.
+	// rst:
+	py::class_<Quantity>("GraphQuantity", py::no_init)
+			// rst:		.. method:: __init__(value)
+			// rst:
+			// rst:			Construct a quantity which is ``value`` for every graph.
+			// rst:
+			// rst:			:param float value: the constant value.
+			.def(py::init<double>())
+			// rst:		.. method:: __call__(g)
+			// rst:
+			// rst:			:param Graph g: the graph to evaluate the quantity for.
+			// rst:			:returns: the value of the quantity for ``g``.
+			// rst:			:rtype: float
+			.def("__call__", &Quantity::operator())
+			.def("__bool__", &noBool<Quantity>)
+			.def(str(py::self))
+			.def(py::self + py::self)
+			.def(py::self + double())
+			.def(double() + py::self)
+			.def(py::self - py::self)
+			.def(py::self - double())
+			.def(double() - py::self)
+			.def(py::self * py::self)
+			.def(py::self * double())
+			.def(double() * py::self)
+			.def(py::self < py::self)
+			.def(py::self < double())
+			.def(py::self <= py::self)
+			.def(py::self <= double())
+			.def(py::self > py::self)
+			.def(py::self > double())
+			.def(py::self >= py::self)
+			.def(py::self >= double())
+			.def(py::self == py::self)
+			.def(py::self == double())
+			.def(py::self != py::self)
+			.def(py::self != double())
+					// rst:		.. staticmethod:: numVertices()
+					// rst:		                  numEdges()
+					// rst:
+					// rst:			:returns: the quantity :attr:`Graph.numVertices` or :attr:`Graph.numEdges`.
+					// rst:			:rtype: GraphQuantity
+			.def("numVertices", &Quantity::numVertices).staticmethod("numVertices")
+			.def("numEdges", &Quantity::numEdges).staticmethod("numEdges")
+					// rst:		.. staticmethod:: vertexLabelCount(label)
+					// rst:		                  edgeLabelCount(label)
+					// rst:
+					// rst:			:param str label: the label to count.
+					// rst:			:returns: the quantity :meth:`Graph.vLabelCount` or :meth:`Graph.eLabelCount` for the given label.
+					// rst:			:rtype: GraphQuantity
+			.def("vertexLabelCount", &Quantity::vertexLabelCount).staticmethod("vertexLabelCount")
+			.def("edgeLabelCount", &Quantity::edgeLabelCount).staticmethod("edgeLabelCount")
+					// rst:		.. staticmethod:: exactMass()
+					// rst:
+					// rst:			:returns: the quantity :attr:`Graph.exactMass`.
+					// rst:				Evaluating it on a graph which is not a molecule raises a :class:`LogicError`.
+					// rst:			:rtype: GraphQuantity
+			.def("exactMass", &Quantity::exactMass).staticmethod("exactMass")
+					// rst:		.. staticmethod:: charge()
+					// rst:
+					// rst:			:returns: the quantity being the sum of the charges of all vertices.
+					// rst:			:rtype: GraphQuantity
+			.def("charge", &Quantity::charge).staticmethod("charge")
+					// rst:		.. staticmethod:: numRings()
+					// rst:
+					// rst:			:returns: the quantity being the cyclomatic number of the graph,
+					// rst:				i.e., the number of edges minus the number of vertices plus one.
+					// rst:			:rtype: GraphQuantity
+			.def("numRings", &Quantity::numRings).staticmethod("numRings");
+	py::implicitly_convertible<double, Quantity>();
+
+	// rst: .. class:: GraphPredicate
+	// rst:
+	// rst:		A predicate on graphs, which can be combined with ``&``, ``|``, and ``~``.
+	// rst:		The binary operators short-circuit when the predicate is evaluated.
+	// rst:
+	py::class_<Predicate>("GraphPredicate", py::no_init)
+			// rst:		.. method:: __call__(g)
+			// rst:
+			// rst:			:param Graph g: the graph to evaluate the predicate for.
+			// rst:			:returns: whether ``g`` satisfies the predicate.
+			// rst:			:rtype: bool
+			.def("__call__", &Predicate::operator())
+			.def("__bool__", &noBool<Predicate>)
+			.def(str(py::self))
+			.def("__and__", &and_)
+			.def("__or__", &or_)
+			.def("__invert__", &not_)
+					// rst:		.. staticmethod:: constant(value)
+					// rst:
+					// rst:			:param bool value: the constant value.
+					// rst:			:returns: a predicate which is ``value`` for every graph.
+					// rst:			:rtype: GraphPredicate
+			.def("constant", &Predicate::constant).staticmethod("constant")
+					// rst:		.. staticmethod:: isMolecule()
+					// rst:
+					// rst:			:returns: the predicate :attr:`Graph.isMolecule`.
+					// rst:			:rtype: GraphPredicate
+			.def("isMolecule", &Predicate::isMolecule).staticmethod("isMolecule")
+					// rst:		.. staticmethod:: isomorphicTo(g, labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism))
+					// rst:
+					// rst:			:param Graph g: the graph to compare with.
+					// rst:			:param LabelSettings labelSettings: the settings to use for the isomorphism check.
+					// rst:			:returns: a predicate which is true for graphs isomorphic to ``g``.
+					// rst:			:rtype: GraphPredicate
+					// rst:			:raises: :class:`LogicError` if ``g`` is ``None``.
+			.def("isomorphicTo", &Predicate::isomorphicTo).staticmethod("isomorphicTo")
+					// rst:		.. staticmethod:: hasSubgraph(pattern, labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism))
+					// rst:
+					// rst:			:param Graph pattern: the graph to search for.
+					// rst:			:param LabelSettings labelSettings: the settings to use for the monomorphism check.
+					// rst:			:returns: a predicate which is true for graphs that ``pattern`` has a monomorphism into.
+					// rst:			:rtype: GraphPredicate
+					// rst:			:raises: :class:`LogicError` if ``pattern`` is ``None``.
+			.def("hasSubgraph", &Predicate::hasSubgraph).staticmethod("hasSubgraph");
+}
+
+} // namespace mod::graph::Py
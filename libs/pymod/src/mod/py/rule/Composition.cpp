@@ -51,7 +51,10 @@ std::vector<std::shared_ptr<Rule>> getProducts(std::shared_ptr<Composer> rc) {
 }
 
 std::vector<std::shared_ptr<Rule>> eval(std::shared_ptr<Composer> rc, const RCExp::Expression &e, int verbosity) {
-	auto result = rc->eval(e, verbosity);
+	auto result = [&] {
+		mod::Py::AllowThreads allow;
+		return rc->eval(e, verbosity);
+	}();
 	return std::vector<std::shared_ptr<Rule>>(begin(result), end(result));
 }
 
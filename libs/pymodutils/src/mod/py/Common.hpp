@@ -8,6 +8,7 @@
 
 #undef BOOST_BIND_GLOBAL_PLACEHOLDERS
 
+#include <memory>
 #include <optional>
 
 namespace py = boost::python;
@@ -16,6 +17,46 @@ namespace mod::Py {
 struct AttributeIsNotReadable {
 };
 
+// RAII guard for releasing the GIL while running library code that does not use Python objects,
+// so other Python threads can run meanwhile.
+// Callbacks into Python must acquire the GIL again with AcquireGIL, as the Function wrappers do.
+struct AllowThreads {
+	AllowThreads() : state(PyEval_SaveThread()) {}
+	AllowThreads(const AllowThreads &) = delete;
+	AllowThreads &operator=(const AllowThreads &) = delete;
+	~AllowThreads() {
+		PyEval_RestoreThread(state);
+	}
+private:
+	PyThreadState *state;
+};
+
+// RAII guard for holding the GIL, from any thread, and also when the calling thread already holds it.
+struct AcquireGIL {
+	AcquireGIL() : state(PyGILState_Ensure()) {}
+	AcquireGIL(const AcquireGIL &) = delete;
+	AcquireGIL &operator=(const AcquireGIL &) = delete;
+	~AcquireGIL() {
+		PyGILState_Release(state);
+	}
+private:
+	PyGILState_STATE state;
+};
+
+// A pointer converted from Python keeps the Python object alive,
+// and Boost.Python releases that reference without acquiring the GIL.
+// Returns a pointer to the same object which releases the reference with the GIL held,
+// so the last copy may be destroyed while the GIL is released.
+template<typename T>
+std::shared_ptr<T> holdWithGIL(std::shared_ptr<T> p) {
+	if(!p) return p;
+	T *ptr = p.get();
+	return std::shared_ptr<T>(ptr, [p = std::move(p)](T *) mutable {
+		AcquireGIL gil;
+		p.reset();
+	});
+}
+
 inline void noGet(AttributeIsNotReadable) {}
 
 // From https://wiki.python.org/moin/boost.python/HowTo#Dynamic_template_to-python_converters
@@ -10,6 +10,8 @@
 #include <mod/py/Common.hpp>
 
 #include <iostream>
+#include <memory>
+#include <vector>
 
 namespace mod::Py {
 namespace py = boost::python;
@@ -36,6 +38,25 @@ struct Returner {
 	}
 };
 
+// returned pointers may outlive the call, see holdWithGIL
+template<typename T>
+struct Returner<std::shared_ptr<T>> {
+	static std::shared_ptr<T> doReturn(decltype(std::declval<py::override>()()) r) {
+		std::shared_ptr<T> p = r;
+		return holdWithGIL(std::move(p));
+	}
+};
+
+template<typename T>
+struct Returner<std::vector<std::shared_ptr<T>>> {
+	static std::vector<std::shared_ptr<T>> doReturn(decltype(std::declval<py::override>()()) r) {
+		std::vector<std::shared_ptr<T>> ps = r;
+		for(auto &p : ps)
+			p = holdWithGIL(std::move(p));
+		return ps;
+	}
+};
+
 template<>
 struct Returner<void> {
 	static void doReturn(decltype(std::declval<py::override>()())) {}
@@ -45,11 +66,14 @@ template<typename F>
 struct FunctionWrapper {
 };
 
+// The library may call the functions while the GIL is released, and from other threads,
+// so each call into Python acquires the GIL.
 template<typename R, typename ...Args>
 struct FunctionWrapper<R(Args...)> : mod::Function<R(Args...)>, py::wrapper<FunctionWrapper<R(Args...)> > {
 	std::shared_ptr<mod::Function<R(Args...)> > clone() const {
+		AcquireGIL gil;
 		if(py::override f = this->get_override("clone")) {
-			return f();
+			return Returner<std::shared_ptr<mod::Function<R(Args...)> > >::doReturn(f());
 		} else {
 			print(std::cerr << "ERROR: override of 'clone' not found in Function\n");
 			std::cerr << std::endl;
@@ -58,6 +82,7 @@ struct FunctionWrapper<R(Args...)> : mod::Function<R(Args...)>, py::wrapper<Func
 	}
 
 	void print(std::ostream &s) const {
+		AcquireGIL gil;
 		if(py::override f = this->get_override("__str__")) {
 			std::string str = f();
 			s << str;
@@ -68,6 +93,7 @@ struct FunctionWrapper<R(Args...)> : mod::Function<R(Args...)>, py::wrapper<Func
 	}
 
 	R operator()(Args ...args) const {
+		AcquireGIL gil;
 		if(py::override f = this->get_override("__call__")) {
 			return Returner<R>::doReturn(f(ArgWrap<Args>::wrap(args)...));
 		} else {
@@ -76,6 +102,10 @@ struct FunctionWrapper<R(Args...)> : mod::Function<R(Args...)>, py::wrapper<Func
 			std::exit(1);
 		}
 	}
+
+	bool isNative() const {
+		return false;
+	}
 };
 
 // It is used in the __init__ file so just make it an identity function.
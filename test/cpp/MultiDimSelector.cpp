@@ -0,0 +1,111 @@
+#include <mod/lib/Algorithm/MultiDimSelector.hpp>
+
+#undef NDEBUG
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+using namespace mod;
+
+// morphisms[pattern][host] is the list of morphisms for that pair,
+// and requested[pattern][host] counts how many times the selector asked for it.
+struct Provider {
+	std::vector<std::vector<std::vector<int>>> &morphisms;
+	std::vector<std::vector<int>> &requested;
+public:
+	std::vector<int> operator()(std::size_t pattern, std::size_t host) const {
+		++requested[pattern][host];
+		return morphisms[pattern][host];
+	}
+};
+
+template<bool AllowPartial>
+auto makeSelector(std::vector<std::vector<std::vector<int>>> &morphisms,
+                  std::vector<std::vector<int>> &requested) {
+	requested.assign(morphisms.size(), std::vector<int>(morphisms.front().size(), 0));
+	return lib::makeMultiDimSelector<AllowPartial>(morphisms.size(), morphisms.front().size(),
+	                                               Provider{morphisms, requested});
+}
+
+int countRequested(const std::vector<std::vector<int>> &requested) {
+	int res = 0;
+	for(const auto &row : requested)
+		for(const int r : row) {
+			assert(r <= 1);
+			res += r;
+		}
+	return res;
+}
+
+void testFull() {
+	std::vector<std::vector<std::vector<int>>> morphisms{
+			{{1, 2}, {},  {3}},
+			{{},     {4}, {5, 6}}
+	};
+	std::vector<std::vector<int>> requested;
+	const auto selector = makeSelector<false>(morphisms, requested);
+	assert(countRequested(requested) == 0);
+	int numSelections = 0;
+	for(const auto &positions : selector) {
+		assert(positions.size() == 2);
+		++numSelections;
+	}
+	assert(numSelections == 3 * 3);
+	// every cell is requested exactly once
+	assert(countRequested(requested) == 6);
+}
+
+void testStopEarly() {
+	std::vector<std::vector<std::vector<int>>> morphisms{
+			{{1}, {2}, {3}},
+			{{4}, {5}, {6}}
+	};
+	std::vector<std::vector<int>> requested;
+	const auto selector = makeSelector<false>(morphisms, requested);
+	const auto iter = selector.begin();
+	assert(iter != selector.end());
+	assert((*iter)[0].host == 0);
+	assert((*iter)[1].host == 0);
+	// only the first host of each pattern is needed for the first selection
+	assert(countRequested(requested) == 2);
+	assert(requested[0][0] == 1);
+	assert(requested[1][0] == 1);
+}
+
+void testEmptyRow() {
+	std::vector<std::vector<std::vector<int>>> morphisms{
+			{{1}, {2}},
+			{{},  {}},
+			{{3}, {4}}
+	};
+	std::vector<std::vector<int>> requested;
+	const auto selector = makeSelector<false>(morphisms, requested);
+	assert(selector.begin() == selector.end());
+	// the iteration stops at the empty row, so the last pattern is never looked at
+	assert(requested[2][0] == 0);
+	assert(requested[2][1] == 0);
+}
+
+void testEmptyRowPartial() {
+	std::vector<std::vector<std::vector<int>>> morphisms{
+			{{1}, {2}},
+			{{},  {}}
+	};
+	std::vector<std::vector<int>> requested;
+	const auto selector = makeSelector<true>(morphisms, requested);
+	int numMatched = 0;
+	for(const auto &positions : selector) {
+		assert(positions[1].disabled);
+		if(positions[0].host != 2) ++numMatched;
+	}
+	assert(numMatched == 2);
+	assert(countRequested(requested) == 4);
+}
+
+int main() {
+	testFull();
+	testStopEarly();
+	testEmptyRow();
+	testEmptyRowPartial();
+}
@@ -0,0 +1,77 @@
+include("xx0_helpers.py")
+disableBuildHook()
+
+g = smiles("O")
+r = ruleGMLString("""rule [
+	left [ node [ id 0 label "O" ] ]
+	right [ node [ id 0 label "S" ] ]
+]""")
+
+# DG.dumpBinary
+
+fail(lambda: DG().dumpBinary(), "Can not dump DG before it is locked.")
+
+dg = DG()
+dg.build()
+
+f = dg.dumpBinary()
+assert f.startswith("out/")
+assert f.endswith("_DG.dgb")
+
+f = dg.dumpBinary("out/myFilename.dgb")
+assert f == "out/myFilename.dgb"
+fail(lambda: dg.dumpBinary("/dev/null/DG.dgb"),
+	"Can not open file '/dev/null/DG.dgb'.")
+
+
+# DG.load and DGBuilder.load
+
+dg = DG()
+with dg.build() as b:
+	b.execute(addSubset(g) >> r)
+f = dg.dumpBinary()
+
+dg2 = DG.load([], [], CWDPath(f))
+_compareDGs(dg, dg2, compareData=False)
+for v, v2 in zip(dg.vertices, dg2.vertices):
+	assert v.graph.name == v2.graph.name
+	assert v.graph.isomorphism(v2.graph)
+e2 = next(iter(dg2.edges))
+assert len(e2.rules) == 1
+assert next(iter(e2.rules)).isomorphism(r)
+
+dg3 = DG.load(dg.graphDatabase, inputRules, CWDPath(f))
+_compareDGs(dg, dg3)
+
+dg4 = DG(graphDatabase=dg.graphDatabase)
+dg4.build().load(inputRules, CWDPath(f))
+_compareDGs(dg, dg4)
+
+dg5 = DG(labelSettings=LabelSettings(LabelType.Term, LabelRelation.Specialisation))
+fail(lambda: dg5.build().load([], CWDPath(f)),
+	"DG load error: Mismatch of label settings. This DG has {} but the dump to be loaded has {}.".format(dg5.labelSettings, dg.labelSettings), err=InputError)
+
+with open("out/notADump.dgb", "wb") as fBad:
+	fBad.write(b"MODDGBIN")
+fail(lambda: DG.load([], [], CWDPath("out/notADump.dgb")),
+	"DG load error: File 'out/notADump.dgb' is not a binary DG dump.", err=InputError)
+
+
+# DG.convertDump
+
+fJson = dg.dump()
+DG.convertDump(CWDPath(fJson), "out/converted.dgb")
+dg6 = DG.load(dg.graphDatabase, inputRules, CWDPath("out/converted.dgb"))
+_compareDGs(dg, dg6)
+
+DG.convertDump(CWDPath(f), "out/converted.dg")
+dg7 = DG.load(dg.graphDatabase, inputRules, CWDPath("out/converted.dg"))
+_compareDGs(dg, dg7)
+
+# round trip
+DG.convertDump(CWDPath("out/converted.dg"), "out/converted2.dgb")
+dg8 = DG.load(dg.graphDatabase, inputRules, CWDPath("out/converted2.dgb"))
+_compareDGs(dg, dg8)
+
+fail(lambda: DG.convertDump('doesNotExist.dg', "out/converted.dgb"),
+	"Could not open file", err=InputError, isSubstring=True)
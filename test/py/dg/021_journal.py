@@ -0,0 +1,45 @@
+include("xx0_helpers.py")
+disableBuildHook()
+
+g = smiles("O")
+r = ruleGMLString("""rule [
+	left [ node [ id 0 label "O" ] ]
+	right [ node [ id 0 label "S" ] ]
+]""")
+rRev = ruleGMLString("""rule [
+	left [ node [ id 0 label "S" ] ]
+	right [ node [ id 0 label "O" ] ]
+]""")
+
+fail(lambda: DG().build().startJournal("/dev/null/DG.dgj"),
+	"Can not open file '/dev/null/DG.dgj'.")
+
+# journal from the start
+dg = DG()
+with dg.build() as b:
+	b.startJournal("out/journal1.dgj")
+	b.execute(addSubset(g) >> repeat(inputRules))
+dg2 = DG.load(dg.graphDatabase, inputRules, CWDPath("out/journal1.dgj"))
+_compareDGs(dg, dg2)
+
+# journal started after vertices and edges have been added
+dg = DG()
+with dg.build() as b:
+	res = b.execute(addSubset(g) >> r)
+	b.startJournal("out/journal2.dgj")
+	b.execute(addSubset(res.subset) >> rRev)
+dg2 = DG.load(dg.graphDatabase, inputRules, CWDPath("out/journal2.dgj"))
+_compareDGs(dg, dg2)
+
+dg3 = DG(graphDatabase=dg.graphDatabase)
+dg3.build().load(inputRules, CWDPath("out/journal2.dgj"))
+_compareDGs(dg, dg3)
+
+# a truncated journal, e.g., from a killed process
+with open("out/journal2.dgj", "rb") as f:
+	data = f.read()
+with open("out/journal3.dgj", "wb") as f:
+	f.write(data[:-3])
+dg4 = DG.load(dg.graphDatabase, inputRules, CWDPath("out/journal3.dgj"))
+assert dg4.numVertices == dg.numVertices
+assert dg4.numEdges == dg.numEdges - 1
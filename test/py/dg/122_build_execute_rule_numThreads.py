@@ -0,0 +1,37 @@
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+
+def build(numThreads, strat=repeat[3](inputRules)):
+	config.common.numThreads = numThreads
+	dg = DG(graphDatabase=inputGraphs)
+	with dg.build() as b:
+		b.execute(addSubset(formaldehyde, glycolaldehyde) >> strat)
+	config.common.numThreads = 1
+	return dg
+
+# product names are 'p_{dgId,productNum}', so skip the DG id
+def productName(g):
+	return g.name.split(",", 1)[-1]
+
+# the DG, including the product names, must not depend on the number of threads
+dgSerial = build(1)
+for numThreads in [2, 4, 0]:
+	dg = build(numThreads)
+	_compareDGs(dgSerial, dg, compareData=False)
+	for v, v2 in zip(dgSerial.vertices, dg.vertices):
+		assert productName(v.graph) == productName(v2.graph), (v.graph.name, v2.graph.name)
+		assert v.graph.isomorphism(v2.graph) == 1
+	for e, e2 in zip(dgSerial.edges, dg.edges):
+		assert set(e.rules) == set(e2.rules)
+
+# the graph ids must not depend on the number of threads either,
+# also when a left predicate rejects derivations after their products have been made
+def productIds(dg):
+	ids = [v.graph.id for v in dg.vertices if v.graph not in inputGraphs]
+	return [i - min(ids) for i in ids]
+strat = leftPredicate[DGDerivationPredicate.allLeft(GraphQuantity.vertexLabelCount("C") <= 2)](repeat[3](inputRules))
+dgSerial = build(1, strat)
+for numThreads in [2, 4, 0]:
+	dg = build(numThreads, strat)
+	_compareDGs(dgSerial, dg, compareData=False)
+	assert productIds(dgSerial) == productIds(dg), (productIds(dgSerial), productIds(dg))
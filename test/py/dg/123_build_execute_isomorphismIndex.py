@@ -0,0 +1,24 @@
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+
+def build(alg):
+	config.graph.isomorphismAlg = alg
+	config.graph.numIsomorphismIndexHits = 0
+	config.graph.numIsomorphismIndexCollisions = 0
+	dg = DG(graphDatabase=inputGraphs)
+	with dg.build() as b:
+		b.execute(addSubset(formaldehyde, glycolaldehyde) >> repeat[3](inputRules))
+	config.graph.isomorphismAlg = Config.IsomorphismAlg.VF2
+	hits = config.graph.numIsomorphismIndexHits
+	collisions = config.graph.numIsomorphismIndexCollisions
+	print(alg, "hits:", hits, "collisions:", collisions)
+	# all products are found again at least once
+	assert hits > 0
+	return dg
+
+# the invariant used for indexing the graph database depends on the algorithm,
+# but the resulting DG must not
+dgVF2 = build(Config.IsomorphismAlg.VF2)
+for alg in [Config.IsomorphismAlg.Canon, Config.IsomorphismAlg.SmilesCanonVF2]:
+	dg = build(alg)
+	_compareDGs(dgVF2, dg, compareData=False)
@@ -0,0 +1,31 @@
+include("../formoseCommon/grammar.py")
+
+# some graphs to apply rules to
+dgInput = DG(graphDatabase=inputGraphs)
+dgInput.build().execute(addSubset(formaldehyde, glycolaldehyde) >> repeat[2](inputRules))
+graphs = list(dgInput.graphDatabase)
+
+def build(numThreads, onlyProper):
+	config.common.numThreads = numThreads
+	dg = DG(graphDatabase=graphs)
+	with dg.build() as b:
+		for r in inputRules:
+			if onlyProper:
+				for i in range(len(graphs)):
+					b.apply(graphs[i:i + 1], r)
+					b.apply(graphs[i:i + 2], r)
+			else:
+				b.apply(graphs, r, onlyProper=False)
+	config.common.numThreads = 1
+	return dg
+
+# the products and their names must not depend on the number of threads
+for onlyProper in [True, False]:
+	dgSerial = build(1, onlyProper)
+	for numThreads in [2, 4]:
+		dg = build(numThreads, onlyProper)
+		assert dgSerial.numVertices == dg.numVertices
+		assert dgSerial.numEdges == dg.numEdges
+		for v, v2 in zip(dgSerial.vertices, dg.vertices):
+			assert v.graph.name.split(",", 1)[-1] == v2.graph.name.split(",", 1)[-1], (v.graph.name, v2.graph.name)
+			assert v.graph.isomorphism(v2.graph) == 1
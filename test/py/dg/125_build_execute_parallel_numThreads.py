@@ -0,0 +1,36 @@
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+
+def build(numThreads, strat):
+	config.common.numThreads = numThreads
+	dg = DG(graphDatabase=inputGraphs)
+	with dg.build() as b:
+		res = b.execute(addSubset(formaldehyde, glycolaldehyde) >> strat)
+	config.common.numThreads = 1
+	return dg, res
+
+# product names are 'p_{dgId,productNum}', so skip the DG id
+def productName(g):
+	return g.name.split(",", 1)[-1]
+
+# the same rule twice makes the substrategies find the same products and derivations
+strats = [
+	repeat[3](inputRules),
+	repeat[2](inputRules + inputRules),
+	repeat[2]([inputRules[0], inputRules]),
+	# native predicates are checked in the concurrent substrategies, Python predicates make it serial
+	leftPredicate[DGDerivationPredicate.anyLeft(GraphQuantity.vertexLabelCount("C") >= 2)](
+		repeat[2](inputRules + inputRules)),
+	rightPredicate[DGDerivationPredicate.allRight(GraphQuantity.vertexLabelCount("C") <= 4)](
+		repeat[2](inputRules + inputRules)),
+	rightPredicate[lambda d: all(g.vLabelCount("C") <= 4 for g in d.right)](repeat[2](inputRules + inputRules)),
+]
+for strat in strats:
+	dgSerial, resSerial = build(1, strat)
+	for numThreads in [2, 4]:
+		dg, res = build(numThreads, strat)
+		_compareDGs(dgSerial, dg, compareData=False)
+		for v, v2 in zip(dgSerial.vertices, dg.vertices):
+			assert productName(v.graph) == productName(v2.graph), (v.graph.name, v2.graph.name)
+		assert [productName(g) for g in resSerial.subset] == [productName(g) for g in res.subset]
+		assert [productName(g) for g in resSerial.universe] == [productName(g) for g in res.universe]
@@ -0,0 +1,32 @@
+include("../formoseCommon/grammar.py")
+
+def build(numThreads):
+	config.common.numThreads = numThreads
+	dg = DG(graphDatabase=inputGraphs)
+	with dg.build() as b:
+		strat = addSubset(formaldehyde, glycolaldehyde) >> repeat[2](inputRules)
+		b.execute(strat)
+		numVertices, numEdges = dg.numVertices, dg.numEdges
+		hits = config.dg.numBindCacheHits
+		# the second execution tries the same pairs of rules and graphs again
+		b.execute(strat)
+		assert config.dg.numBindCacheHits > hits
+		assert dg.numVertices == numVertices
+		assert dg.numEdges == numEdges
+	config.common.numThreads = 1
+	return dg
+
+# skipping the known-empty bindings must not change the result
+dgSerial = build(1)
+dg = build(2)
+assert dgSerial.numVertices == dg.numVertices
+assert dgSerial.numEdges == dg.numEdges
+for v, v2 in zip(dgSerial.vertices, dg.vertices):
+	assert v.graph.isomorphism(v2.graph) == 1
+
+# each graph is looked up once per rule application, also when it is bound again in the later rounds
+dg = DG(graphDatabase=inputGraphs)
+lookups = config.dg.numBindCacheHits + config.dg.numBindCacheMisses
+with dg.build() as b:
+	b.execute(addUniverse(formaldehyde) >> addSubset(glycolaldehyde) >> aldolAdd_F)
+assert config.dg.numBindCacheHits + config.dg.numBindCacheMisses - lookups == 2
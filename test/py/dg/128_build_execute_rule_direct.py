@@ -0,0 +1,62 @@
+include("../formoseCommon/grammar.py")
+
+def build(direct, strat, graphs):
+	config.dg.useDirectRuleApplication = direct
+	dg = DG(graphDatabase=graphs)
+	with dg.build() as b:
+		b.execute(strat)
+	config.dg.useDirectRuleApplication = False
+	return dg
+
+def predicateInput(direct, strat, graphs):
+	seen = set()
+	def pred(d):
+		seen.add((tuple(sorted(g.id for g in d.left)), tuple(sorted(g.id for g in d.right))))
+		return True
+	build(direct, rightPredicate[pred](strat), graphs)
+	return seen
+
+# The DG must be isomorphic to the one from composition, i.e., have the same derivations,
+# but they may be found in another order, so the vertices and edges may get other ids.
+def check(strat, graphs):
+	dgComp = build(False, strat, graphs)
+	# use the graphs of the first DG, so the same derivations have the same graph objects
+	graphs = [v.graph for v in dgComp.vertices]
+	dg = build(True, strat, graphs)
+	assert dg.numVertices == dgComp.numVertices, (dg.numVertices, dgComp.numVertices)
+	assert dg.numEdges == dgComp.numEdges, (dg.numEdges, dgComp.numEdges)
+	for e in dgComp.edges:
+		eDirect = dg.findEdge([v.graph for v in e.sources], [v.graph for v in e.targets])
+		assert eDirect, e
+		assert [r.name for r in eDirect.rules] == [r.name for r in e.rules]
+	# the predicates are given the same derivations, though maybe not the same number of times
+	assert predicateInput(False, strat, graphs) == predicateInput(True, strat, graphs)
+
+check(addSubset(formaldehyde, glycolaldehyde) >> repeat[3](inputRules), inputGraphs)
+
+# deletion of a vertex, where the dangling condition must hold
+deleteO = ruleGMLString("""rule [
+	ruleID "delete O"
+	left [
+		node [ id 0 label "O" ]
+		edge [ source 0 target 1 label "-" ]
+	]
+	context [
+		node [ id 1 label "C" ]
+	]
+]""")
+# creation of an edge between two components, which must not be parallel to an existing edge
+joinC = ruleGMLString("""rule [
+	ruleID "join C"
+	context [
+		node [ id 0 label "C" ]
+		node [ id 1 label "C" ]
+	]
+	right [
+		edge [ source 0 target 1 label "-" ]
+	]
+]""")
+graphs = [smiles("CC[O]", name="ethoxyl"), smiles("COC", name="dimethyl ether"), smiles("CC", name="ethane")]
+check(addSubset(graphs) >> deleteO, graphs)
+check(addSubset(graphs) >> joinC, graphs)
+check(addSubset(graphs[2]) >> addUniverse(graphs) >> joinC, graphs)
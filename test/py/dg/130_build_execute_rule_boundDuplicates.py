@@ -0,0 +1,23 @@
+include("1xx_execute_helpers.py")
+
+# Binding the same graphs to the two symmetric components of the rule in either order
+# gives isomorphic bound rules, which must be detected as duplicates.
+r = ruleGMLString("""rule [
+	ruleID "Join"
+	left [ node [ id 0 label "A" ] node [ id 1 label "A" ] ]
+	context [ ]
+	right [
+		node [ id 0 label "A" ] node [ id 1 label "A" ]
+		edge [ source 0 target 1 label "-" ]
+	]
+]""")
+a = graphDFS("[A]", "a")
+aq = graphDFS("[A][Q]", "aq")
+for ls in [lsString, lsTerm]:
+	dg, b, res = exeStrat(addSubset(a, aq) >> r, ls=ls)
+	# {a, a}, {a, aq}, and {aq, aq}, each only once
+	assert dg.numEdges == 3, (ls, dg.numEdges)
+	sources = sorted(sorted(v.graph.name for v in e.sources) for e in dg.edges)
+	assert sources == [["a", "a"], ["a", "aq"], ["aq", "aq"]], sources
+	for e in dg.edges:
+		assert e.numTargets == 1
@@ -0,0 +1,55 @@
+import threading
+
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+
+# the GIL is released during execution, so several DGs can be built from concurrent Python threads,
+# sharing the input graphs and rules, and the Python functions acquire the GIL again when called
+calls = [0]
+def small(d):
+	calls[0] += 1
+	return all(g.numVertices <= 16 for g in d.right)
+strat = addSubset(formaldehyde, glycolaldehyde) >> rightPredicate[small](repeat[3](inputRules))
+
+def build(numThreads):
+	config.common.numThreads = numThreads
+	dg = DG(graphDatabase=inputGraphs)
+	with dg.build() as b:
+		b.execute(strat)
+	config.common.numThreads = 1
+	return dg
+
+dgSerial = build(1)
+assert calls[0] > 0
+for numThreads in [1, 2]:
+	config.common.numThreads = numThreads
+	dgs = [None] * 4
+	errors = []
+	def run(i):
+		try:
+			dg = DG(graphDatabase=inputGraphs)
+			with dg.build() as b:
+				b.execute(strat)
+			dgs[i] = dg
+		except BaseException as e:
+			errors.append(e)
+	threads = [threading.Thread(target=run, args=(i,)) for i in range(len(dgs))]
+	for t in threads:
+		t.start()
+	for t in threads:
+		t.join()
+	config.common.numThreads = 1
+	assert not errors, errors
+	for dg in dgs:
+		_compareDGs(dgSerial, dg, compareData=False)
+
+# exceptions from Python functions still propagate
+class MyError(Exception):
+	pass
+def raiser(g, gs, first):
+	raise MyError()
+try:
+	exeStrat(addSubset(formaldehyde) >> filterUniverse(raiser))
+	assert False
+except MyError:
+	pass
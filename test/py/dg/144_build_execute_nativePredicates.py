@@ -0,0 +1,53 @@
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+
+Q = GraphQuantity
+P = GraphPredicate
+D = DGDerivationPredicate
+
+# native predicates must give the same derivation graphs as the equivalent Python functions
+def check(stratNative, stratPython):
+	def build(strat):
+		dg = DG(graphDatabase=inputGraphs)
+		with dg.build() as b:
+			b.execute(strat)
+		return dg
+	dgNative = build(addSubset(formaldehyde, glycolaldehyde) >> stratNative)
+	dgPython = build(addSubset(formaldehyde, glycolaldehyde) >> stratPython)
+	_compareDGs(dgNative, dgPython, compareData=False)
+	return dgNative
+
+numC = Q.vertexLabelCount("C")
+dg = check(
+	repeat[3](inputRules) >> filterUniverse(numC <= 4),
+	repeat[3](inputRules) >> filterUniverse(lambda g, gs, first: g.vLabelCount("C") <= 4))
+assert all(v.graph.vLabelCount("C") <= 4 for v in dg.vertices)
+check(
+	rightPredicate[D.allRight(numC <= 4)](repeat[3](inputRules)),
+	rightPredicate[lambda d: all(g.vLabelCount("C") <= 4 for g in d.right)](repeat[3](inputRules)))
+check(
+	leftPredicate[D.anyLeft(numC >= 2) & ~D.allLeft(Q.numRings() > 0)](repeat[3](inputRules)),
+	leftPredicate[lambda d: any(g.vLabelCount("C") >= 2 for g in d.left)
+		and not all(g.numEdges - g.numVertices + 1 > 0 for g in d.left)](repeat[3](inputRules)))
+carbonyl = smiles("C=O")
+check(
+	repeat[2](inputRules) >> filterSubset(P.hasSubgraph(carbonyl)),
+	repeat[2](inputRules) >> filterSubset(lambda g, gs, first: carbonyl.monomorphism(g) > 0))
+
+# the derivation predicates can also be evaluated directly
+d = Derivation()
+d.left = [formaldehyde, glycolaldehyde]
+assert D.anyLeft(numC == 2)(d)
+assert not D.allLeft(numC == 2)(d)
+assert D.allRight(numC == 2)(d)
+assert not D.anyRight(numC == 2)(d)
+assert (D.constant(True) | D.constant(False))(d)
+assert not (D.constant(True) & D.constant(False))(d)
+assert str(D.allLeft(numC <= 4)) == "allLeft(vertexLabelCount('C') <= 4)"
+
+# the right side is empty in left predicates, so predicates using it are rejected there
+assert not (D.anyLeft(numC == 2) & D.constant(True)).usesRight()
+assert (D.anyLeft(numC == 2) | ~D.allRight(numC == 2)).usesRight()
+msg = "The left predicate uses the right side of the derivation, which is empty in left predicates."
+fail(lambda: leftPredicate[D.allRight(numC <= 4)](inputRules), msg)
+fail(lambda: leftPredicate[D.anyLeft(numC >= 2) & D.anyRight(numC <= 4)](inputRules), msg)
@@ -0,0 +1,22 @@
+# enough distinct labels to fill several chunks of the label store
+n = 1000
+labels = ["label{}".format(i) for i in range(n)]
+
+def makeGraph():
+	return graphGMLString("graph [ {} {} ]".format(
+		" ".join('node [ id {} label "{}" ]'.format(i, l) for i, l in enumerate(labels)),
+		" ".join('edge [ source {} target {} label "{}" ]'.format(i, i + 1, labels[-i - 1]) for i in range(n - 1))
+	), add=False)
+
+a = makeGraph()
+b = makeGraph()
+for v in a.vertices:
+	assert v.stringLabel == labels[v.id]
+for e in a.edges:
+	assert e.stringLabel == labels[-min(e.source.id, e.target.id) - 1]
+assert a.isomorphism(b) == 1
+
+labels[0] = "label1"
+c = makeGraph()
+assert a.isomorphism(c) == 0
+assert c.monomorphism(a) == 0
@@ -0,0 +1,48 @@
+lsIso = LabelSettings(LabelType.Term, LabelRelation.Isomorphism)
+
+graphs = [Graph.fromDFS(s) for s in [
+	"[f(a)]-[g(b, c)]", "[g(b, c)]-[f(a)]", "[f(b)]-[g(b, c)]", "[f(a)]-[g(c, b)]",
+	"[f(a)]1-[g(b, c)]-[h]-1", "[f(a)]1-[h]-[g(b, c)]-1", "[f(a)]-[g(b, c)]-[h]",
+	# with variables, which must fall back to VF2
+	"[f(_X)]-[g(b, c)]", "[f(_Y)]-[g(b, c)]", "[f(_X)]-[g(_X, c)]", "[f(_X)]-[g(_Y, c)]",
+	# and with edges which are not bonds
+	"[f(a)]{e(a)}[g(b, c)]", "[g(b, c)]{e(a)}[f(a)]",
+]]
+# the same term written differently must have the same canonical form
+graphs.append(graphGMLString("""graph [
+	node [ id 0 label "f( a )" ]
+	node [ id 1 label "g(b,c)" ]
+	edge [ source 0 target 1 label "-" ]
+]"""))
+
+def isoAll(alg):
+	config.graph.isomorphismAlg = alg
+	res = [[a.isomorphism(b, labelSettings=lsIso) for b in graphs] for a in graphs]
+	config.graph.isomorphismAlg = Config.IsomorphismAlg.VF2
+	return res
+
+resVF2 = isoAll(Config.IsomorphismAlg.VF2)
+for alg in [Config.IsomorphismAlg.Canon, Config.IsomorphismAlg.SmilesCanonVF2]:
+	assert isoAll(alg) == resVF2, alg
+assert resVF2[0][-1] == 1
+
+# the automorphism group of ground graphs
+sym = Graph.fromDFS("[f(a)]-[g]-[f(a)]")
+assert any(p[v] != v for p in sym.aut(lsIso).gens for v in sym.vertices)
+asym = Graph.fromDFS("[f(a)]-[g]-[f(b)]")
+assert all(p[v] == v for p in asym.aut(lsIso).gens for v in asym.vertices)
+
+# and deduplication in a DG
+numClasses = len({min(j for j in range(len(graphs)) if resVF2[i][j]) for i in range(len(graphs))})
+src = Graph.fromDFS("[s]")
+for alg in [Config.IsomorphismAlg.VF2, Config.IsomorphismAlg.Canon, Config.IsomorphismAlg.SmilesCanonVF2]:
+	config.graph.isomorphismAlg = alg
+	dg = DG(labelSettings=lsIso)
+	with dg.build() as b:
+		for g in graphs:
+			d = Derivations()
+			d.left = [src]
+			d.right = [g]
+			b.addDerivation(d, IsomorphismPolicy.Check)
+	assert dg.numVertices == 1 + numClasses, (alg, dg.numVertices, numClasses)
+config.graph.isomorphismAlg = Config.IsomorphismAlg.VF2
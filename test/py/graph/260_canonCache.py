@@ -0,0 +1,57 @@
+import os
+
+inputSmiles = ["OCC=O", "c1ccccc1", "CC(C)(C)O", "O=C=O", "C(=CC(=O)O)C(=O)O"]
+
+def load():
+	res = []
+	for s in inputSmiles:
+		a = smiles(s, add=False)
+		res.append((a.smiles, [str(p) for p in a.aut().gens]))
+	return res
+
+expected = load()
+
+os.makedirs("out", exist_ok=True)
+cacheFile = "out/canonCache.bin"
+if os.path.exists(cacheFile):
+	os.remove(cacheFile)
+
+# cold, populates the cache
+config.canon.cacheFile = cacheFile
+assert load() == expected
+assert os.path.getsize(cacheFile) > 0
+
+# switch to another file and back, so the first one is read again from disk
+config.canon.cacheFile = "out/canonCache2.bin"
+smiles("C", add=False).smiles
+size = os.path.getsize(cacheFile)
+config.canon.cacheFile = cacheFile
+assert load() == expected
+# all entries, including the SMILES strings, were found, so nothing new is written
+config.canon.cacheFile = "out/canonCache2.bin"
+smiles("C", add=False).smiles
+assert os.path.getsize(cacheFile) == size
+config.canon.cacheFile = ""
+
+# entries written after the file was opened are read back from the file
+alkanes = ["C" * i for i in range(10, 40)]
+def loadAlkanes():
+	res = []
+	for s in alkanes:
+		a = smiles(s, add=False)
+		res.append((a.smiles, [str(p) for p in a.aut().gens]))
+	return res
+expectedAlkanes = loadAlkanes()
+os.remove(cacheFile)
+config.canon.cacheFile = cacheFile
+assert loadAlkanes() == expectedAlkanes
+assert loadAlkanes() == expectedAlkanes
+config.canon.cacheFile = ""
+
+# a file of a different format must be rejected
+with open("out/notACache.bin", "w") as f:
+	f.write("not a cache")
+config.canon.cacheFile = "out/notACache.bin"
+fail(lambda: smiles("CCO", add=False).smiles, "is not a canonical form cache file", err=InputError,
+	isSubstring=True)
+config.canon.cacheFile = ""
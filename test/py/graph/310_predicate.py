@@ -0,0 +1,54 @@
+include("../xxx_helpers.py")
+
+Q = GraphQuantity
+P = GraphPredicate
+
+glucose = smiles("OCC(O)C(O)C(O)C(O)C=O", "glucose")
+ring = smiles("C1CC2CCC1C2", "norbornane")
+ammonium = smiles("[NH4+]", "ammonium")
+abstract = graphDFS("[Q]-[R]")
+
+assert Q.numVertices()(glucose) == glucose.numVertices
+assert Q.numEdges()(glucose) == glucose.numEdges
+assert Q.vertexLabelCount("C")(glucose) == 6
+assert Q.edgeLabelCount("=")(glucose) == 1
+assert Q.exactMass()(glucose) == glucose.exactMass
+fail(lambda: Q.exactMass()(abstract), "Can not get exact mass of a non-molecule.")
+assert Q.charge()(ammonium) == 1
+assert Q.charge()(glucose) == 0
+assert Q.numRings()(glucose) == 0
+assert Q.numRings()(ring) == 2
+
+# arithmetic and comparisons, also with plain numbers
+numC = Q.vertexLabelCount("C")
+assert (numC + 1)(glucose) == 7
+assert (1 - numC)(glucose) == -5
+assert (2 * numC - Q.vertexLabelCount("O"))(glucose) == 6
+assert (numC <= 6)(glucose)
+assert not (numC < 6)(glucose)
+assert (6 >= numC)(glucose)
+assert (numC == 6)(glucose)
+assert not (numC != 6)(glucose)
+assert (numC > Q.vertexLabelCount("O"))(glucose)
+assert str(numC <= 6) == "vertexLabelCount('C') <= 6"
+
+# logical combinations
+small = numC <= 3
+assert (~small)(glucose)
+assert not (small & P.isMolecule())(glucose)
+assert (small | P.isMolecule())(glucose)
+assert not P.isMolecule()(abstract)
+assert P.constant(True)(abstract)
+assert not P.constant(False)(abstract)
+# short-circuiting means the exact mass is never computed
+assert not (P.isMolecule() & (Q.exactMass() > 0))(abstract)
+fail(lambda: bool(small), "do not use chained comparisons.")
+fail(lambda: 0 <= numC <= 6, "do not use chained comparisons.")
+
+# patterns
+assert P.isomorphicTo(smiles("O=CC(O)C(O)C(O)C(O)CO"))(glucose)
+assert not P.isomorphicTo(ring)(glucose)
+assert P.hasSubgraph(smiles("C=O"))(glucose)
+assert not P.hasSubgraph(smiles("C=O"))(ring)
+fail(lambda: P.isomorphicTo(None), "The graph is a null pointer.")
+fail(lambda: P.hasSubgraph(None), "The pattern is a null pointer.")
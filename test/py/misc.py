@@ -2,6 +2,7 @@ include("xxx_helpers.py")
 
 print("magicLibraryValue:", magicLibraryValue())
 print("version:", version())
+print("isDebugBuild:", isDebugBuild())
 rngReseed(42)
 print("rngUniformReal:", rngUniformReal())
 
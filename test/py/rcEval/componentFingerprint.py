@@ -0,0 +1,27 @@
+post.disableInvokeMake()
+
+r1 = ruleGMLString("""rule [
+	left [ node [ id 0 label "X" ] ]
+	right [ node [ id 0 label "A" ] ]
+]""")
+r2 = ruleGMLString("""rule [
+	left [ node [ id 0 label "A" ] node [ id 1 label "B" ] node [ id 2 label "C" ] edge [ source 1 target 2 label "-" ] ]
+	right [ node [ id 0 label "Y" ] node [ id 1 label "B" ] node [ id 2 label "C" ] edge [ source 1 target 2 label "=" ] ]
+]""")
+exp = rcExp([r1 *rcSuper* r2, r2 *rcSub* r1])
+
+# B-C can not be matched to A or X by the size, and Y not to X by the labels
+config.rc.numComponentPairsSkipped = 0
+rc = rcEvaluator([r1, r2])
+res = rc.eval(exp)
+print("skipped:", config.rc.numComponentPairsSkipped)
+assert config.rc.numComponentPairsSkipped > 0
+skipped = config.rc.numComponentPairsSkipped
+
+# with term labels only the size is compared, but the results must be the same
+config.rc.numComponentPairsSkipped = 0
+rcTerm = rcEvaluator([r1, r2], LabelSettings(LabelType.Term, LabelRelation.Isomorphism))
+resTerm = rcTerm.eval(exp)
+print("skipped (term):", config.rc.numComponentPairsSkipped)
+assert 0 < config.rc.numComponentPairsSkipped < skipped
+assert len(res) == len(resTerm)
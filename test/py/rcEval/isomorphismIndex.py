@@ -0,0 +1,18 @@
+include("../formoseCommon/grammar_H.py")
+
+post.disableInvokeMake()
+
+rc = rcEvaluator(inputRules)
+exp = ketoEnol_F *rcSuper* aldolAdd_F
+res = rc.eval(exp)
+numDatabase = len(rc.ruleDatabase)
+numProducts = len(rc.products)
+
+# evaluating again must find every result in the database
+config.rc.numIsomorphismIndexHits = 0
+res2 = rc.eval(exp)
+print("hits:", config.rc.numIsomorphismIndexHits, "collisions:", config.rc.numIsomorphismIndexCollisions)
+assert config.rc.numIsomorphismIndexHits == len(res2)
+assert len(rc.ruleDatabase) == numDatabase
+assert len(rc.products) == numProducts
+assert set(res) == set(res2)
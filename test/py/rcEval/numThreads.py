@@ -0,0 +1,48 @@
+include("../formoseCommon/grammar_H.py")
+
+post.disableInvokeMake()
+
+exps = [
+	ketoEnol_F *rcSuper* aldolAdd_F,
+	ketoEnol_F *rcCommon* ketoEnol_B,
+	ketoEnol_F *rcCommon(includeEmpty=True)* ketoEnol_B,
+	ketoEnol_F *rcParallel* aldolAdd_F,
+	rcExp([ketoEnol_F, ketoEnol_B]) *rcSub* rcExp([aldolAdd_F, aldolAdd_B]),
+]
+
+def evaluate(numThreads):
+	config.common.numThreads = numThreads
+	rc = rcEvaluator(inputRules)
+	res = [rc.eval(e) for e in exps]
+	config.common.numThreads = 1
+	return rc, res
+
+# the results must come in the same order as with a single thread,
+# though the rule names may differ
+rcSerial, resSerial = evaluate(1)
+for numThreads in [2, 4, 0]:
+	rc, res = evaluate(numThreads)
+	assert len(rc.ruleDatabase) == len(rcSerial.ruleDatabase)
+	assert len(rc.products) == len(rcSerial.products)
+	for rs, rp in zip(resSerial, res):
+		assert len(rs) == len(rp)
+		for a, b in zip(rs, rp):
+			assert a.isomorphism(b) == 1
+
+# the GIL is released during evaluation, so evaluators in concurrent Python threads can share the input rules
+import threading
+results = [None] * 4
+def run(i):
+	rc = rcEvaluator(inputRules)
+	results[i] = [rc.eval(e) for e in exps]
+threads = [threading.Thread(target=run, args=(i,)) for i in range(len(results))]
+for t in threads:
+	t.start()
+for t in threads:
+	t.join()
+for res in results:
+	assert res is not None
+	for rs, rp in zip(resSerial, res):
+		assert len(rs) == len(rp)
+		for a, b in zip(rs, rp):
+			assert a.isomorphism(b) == 1
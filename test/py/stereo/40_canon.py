@@ -0,0 +1,54 @@
+include("common.py")
+
+graphs = [smiles(s) for s in [
+	"O[C@](N)(P)S", "O[C@@](N)(P)S", "[C@](O)(N)(P)S", "N[C@@](O)(P)S",
+	"C[C@H](O)C(=O)O", "C[C@@H](O)C(=O)O", "OC(=O)[C@@H](C)O", "CC(O)C(=O)O",
+	# meso-tartaric acid, twice, and the chiral form
+	"O[C@H]([C@@H](O)C(=O)O)C(=O)O", "O[C@@H]([C@H](O)C(=O)O)C(=O)O", "O[C@H]([C@H](O)C(=O)O)C(=O)O",
+]]
+
+def isoAll(alg):
+	config.graph.isomorphismAlg = alg
+	res = [[a.isomorphism(b, labelSettings=isoLabelSettings) for b in graphs] for a in graphs]
+	config.graph.isomorphismAlg = Config.IsomorphismAlg.VF2
+	return res
+
+# canonicalisation with stereo must agree with VF2
+resVF2 = isoAll(Config.IsomorphismAlg.VF2)
+for alg in [Config.IsomorphismAlg.Canon, Config.IsomorphismAlg.SmilesCanonVF2]:
+	assert isoAll(alg) == resVF2, alg
+
+# the stereo automorphisms of meso-tartaric acid are trivial, but not those of the chiral form
+meso, chiral = graphs[8], graphs[10]
+assert meso.isomorphism(meso, maxNumMatches=100, labelSettings=isoLabelSettings) == 1
+assert chiral.isomorphism(chiral, maxNumMatches=100, labelSettings=isoLabelSettings) == 2
+assert all(p[v] == v for p in meso.aut(isoLabelSettings).gens for v in meso.vertices)
+assert any(p[v] != v for p in chiral.aut(isoLabelSettings).gens for v in chiral.vertices)
+assert any(p[v] != v for p in meso.aut().gens for v in meso.vertices)
+
+# the E and Z isomers of 1,2-dichloroethene differ only in the fixed trigonal planar embeddings,
+# and VF2 does not support those, so only canonicalisation is used
+def dichloroethene(c0, c1):
+	return gGML("""
+		node [ id 0 label "C" stereo "%s!" ] node [ id 1 label "C" stereo "%s!" ]
+		node [ id 2 label "Cl" ] node [ id 3 label "H" ] node [ id 4 label "Cl" ] node [ id 5 label "H" ]
+		edge [ source 0 target 1 label "=" ] edge [ source 0 target 2 label "-" ] edge [ source 0 target 3 label "-" ]
+		edge [ source 1 target 4 label "-" ] edge [ source 1 target 5 label "-" ]
+	""" % (c0, c1))
+e = dichloroethene("[1, 2, 3]", "[0, 4, 5]")
+z = dichloroethene("[1, 2, 3]", "[0, 5, 4]")
+eRotated = dichloroethene("[2, 3, 1]", "[0, 4, 5]")
+# the E isomer with the vertex ids permuted
+eRelabelled = gGML("""
+	node [ id 0 label "Cl" ] node [ id 1 label "Cl" ] node [ id 2 label "C" stereo "[5, 1, 3]!" ]
+	node [ id 3 label "H" ] node [ id 4 label "H" ] node [ id 5 label "C" stereo "[2, 0, 4]!" ]
+	edge [ source 5 target 2 label "=" ] edge [ source 5 target 0 label "-" ] edge [ source 5 target 4 label "-" ]
+	edge [ source 2 target 1 label "-" ] edge [ source 2 target 3 label "-" ]
+""")
+config.graph.isomorphismAlg = Config.IsomorphismAlg.Canon
+assert e.isomorphism(z, labelSettings=isoLabelSettings) == 0
+assert z.isomorphism(eRelabelled, labelSettings=isoLabelSettings) == 0
+assert e.isomorphism(eRotated, labelSettings=isoLabelSettings) == 1
+assert e.isomorphism(eRelabelled, labelSettings=isoLabelSettings) == 1
+assert eRelabelled.isomorphism(e, labelSettings=isoLabelSettings) == 1
+config.graph.isomorphismAlg = Config.IsomorphismAlg.VF2
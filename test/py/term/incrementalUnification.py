@@ -0,0 +1,51 @@
+# the morphism counts must not depend on whether terms are unified during the search or afterwards
+patterns = [
+	graphDFS("[f(_X)]-[f(_X)]"),
+	graphDFS("[f(_X)]-[g(_Y)]"),
+	graphDFS("[f(_X, _Y)][a]"),
+	graphDFS("[_X]-[_X]-[_Y]"),
+]
+hosts = [
+	graphDFS("[f(a)]-[f(a)]-[g(b)]"),
+	graphDFS("[f(a)]-[f(b)]-[g(_Z)]"),
+	graphDFS("[f(_A, _A)][a][_B]"),
+	graphDFS("[f(a)]-[_C]-[f(_C)]"),
+]
+
+def counts():
+	res = []
+	for lr in LabelRelation.values.values():
+		ls = LabelSettings(LabelType.Term, lr)
+		for p in patterns:
+			for h in hosts:
+				res.append(p.monomorphism(h, maxNumMatches=1000, labelSettings=ls))
+				res.append(p.isomorphism(h, maxNumMatches=1000, labelSettings=ls))
+	return res
+
+r = ruleGMLString("""rule [
+	left [ edge [ source 0 target 1 label "-" ] ]
+	context [
+		node [ id 0 label "f(_X)" ]
+		node [ id 1 label "f(_X)" ]
+	]
+	right [ edge [ source 0 target 1 label "=" ] ]
+]""")
+a = graphDFS("[f(a)]-[f(a)]-[f(b)]-[g(a)]-[f(a)]")
+
+def dgCounts():
+	dg = DG(labelSettings=LabelSettings(LabelType.Term, LabelRelation.Unification))
+	dg.build().execute(addSubset(a) >> repeat(r))
+	return dg.numVertices, dg.numEdges
+
+assert config.common.incrementalTermUnification
+inc = counts()
+incDG = dgCounts()
+config.common.incrementalTermUnification = False
+post = counts()
+postDG = dgCounts()
+config.common.incrementalTermUnification = True
+print(inc)
+print(post)
+assert inc == post
+print(incDG, postDG)
+assert incDG == postDG